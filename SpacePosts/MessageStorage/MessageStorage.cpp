@@ -9,13 +9,15 @@
 // acknowledged.
 //
 // ======================================================================
+#include <algorithm>
+#include <cstring>
 #include <string>
 #include <vector>
-#include <functional>
 
 #include <Os/File.hpp>
 #include <Os/Directory.hpp>
 #include <Os/FileSystem.hpp>
+#include <Utils/Hash/Hash.hpp>
 
 #include <SpacePosts/MessageStorage/MessageStorage.hpp>
 #include "SpacePosts/MessageTypes/FppConstantsAc.hpp"
@@ -25,6 +27,19 @@
 
 namespace SpacePosts
 {
+	namespace
+	{
+		// CRC-32 of a serialized message as stored in its SpacePostMetadata
+		U32 computeChecksum(const U8 *const data, const U32 length)
+		{
+			Utils::Hash hash{};
+			hash.update(data, static_cast<NATIVE_INT_TYPE>(length));
+			U32 checksum{0};
+			hash.final(checksum);
+			return checksum;
+		}
+	}
+
 	// ----------------------------------------------------------------------
 	// Construction, initialization, and destruction
 	// ----------------------------------------------------------------------
@@ -34,8 +49,31 @@ namespace SpacePosts
 			const char *const compName)
 		: MessageStorageComponentBase(compName),
 		  nextIndexCounter(0),
-		  lastSuccessfullyStoredIndices()
+		  lastSuccessfullyStoredIndices(),
+		  loadedMessages(),
+		  loadedMetadata()
+	{
+		// Keep the storage directory in a fixed buffer so that formatting file paths needs no string operations
+		this->storageDirectoryLength = MESSAGESTORAGE_MSGFILE_DIRECTORY.length();
+		FW_ASSERT(this->storageDirectoryLength <= MESSAGESTORAGE_MSGFILE_DIRECTORY_MAXLENGTH,
+				  this->storageDirectoryLength);
+		(void)std::memcpy(this->storageDirectory, MESSAGESTORAGE_MSGFILE_DIRECTORY.c_str(),
+						  this->storageDirectoryLength);
+		this->storageDirectory[this->storageDirectoryLength] = '\0';
+	}
+
+	void MessageStorage ::
+		configure(
+			const char *const directory,
+			const U32 maxStoredMessages)
 	{
+		this->storageDirectoryLength = static_cast<U32>(std::strlen(directory));
+		FW_ASSERT(this->storageDirectoryLength <= MESSAGESTORAGE_MSGFILE_DIRECTORY_MAXLENGTH,
+				  this->storageDirectoryLength);
+		(void)std::memcpy(this->storageDirectory, directory, this->storageDirectoryLength);
+		this->storageDirectory[this->storageDirectoryLength] = '\0';
+
+		this->maxStoredMessages = maxStoredMessages;
 	}
 
 	void MessageStorage ::
@@ -64,7 +102,10 @@ namespace SpacePosts
 
 		this->tlmWrite_STORE_COUNT(++this->numStoreAttempts);
 
-		const bool success = this->storeMessage(index, data);
+		// Written synchronously
+		Os::File file{};
+		const bool success = this->createMessageFile(index, data, file, true);
+		this->completeStore(index, success);
 
 		const SpacePosts::MessageStorageStatus status = success
 															? SpacePosts::MessageStorageStatus::OK
@@ -72,13 +113,58 @@ namespace SpacePosts
 		return status;
 	}
 
+	U8 MessageStorage ::
+		storeMessages_handler(
+			const NATIVE_INT_TYPE portNum,
+			const SpacePosts::SpacePost_Batch &data,
+			SpacePosts::MessageStorageStatus_Batch &statuses)
+	{
+		const U8 num_messages = (data.getnumValidMessages() < SpacePost_Batch_Size) ? data.getnumValidMessages()
+																				   : SpacePost_Batch_Size;
+		const SpacePosts::SpacePost_Array &messages = data.getmessages();
+
+		// The files stay open until they have been flushed below
+		Os::File files[SpacePost_Batch_Size];
+		U32 indices[SpacePost_Batch_Size];
+		bool written[SpacePost_Batch_Size];
+		for (U8 i = 0; i < num_messages; ++i)
+		{
+			indices[i] = this->nextIndex();
+			this->tlmWrite_STORE_COUNT(++this->numStoreAttempts);
+
+			// Written asynchronously. Made durable all at once below
+			written[i] = this->createMessageFile(indices[i], messages[i], files[i], false);
+		}
+
+		// Only files which reached the storage medium are reported as stored
+		U8 num_messages_stored{0};
+		for (U8 i = 0; i < SpacePost_Batch_Size; ++i)
+		{
+			if (i >= num_messages)
+			{
+				statuses[i] = SpacePosts::MessageStorageStatus::ERROR;
+				continue;
+			}
+
+			const bool success = written[i] && this->syncMessageFile(indices[i], files[i]);
+			this->completeStore(indices[i], success);
+			statuses[i] = success ? SpacePosts::MessageStorageStatus::OK : SpacePosts::MessageStorageStatus::ERROR;
+			if (success)
+			{
+				++num_messages_stored;
+			}
+		}
+		return num_messages_stored;
+	}
+
 	SpacePosts::SpacePostValid MessageStorage ::
 		loadMessageFromIndex_handler(
 			const NATIVE_INT_TYPE portNum,
 			const U32 index,
 			SpacePosts::SpacePost &data)
 	{
-		const bool success = this->loadMessage(index, data);
+		SpacePostMetadata metadata{}; // Not reported through this port
+		const bool success = this->loadMessage(index, data, metadata);
 		this->tlmWrite_LOAD_COUNT(++this->numLoadAttempts);
 		const SpacePosts::SpacePostValid status = static_cast<SpacePosts::SpacePostValid::t>(success);
 		return status;
@@ -87,34 +173,42 @@ namespace SpacePosts
 	U8 MessageStorage ::
 		loadMessageLastN_handler(const NATIVE_INT_TYPE portNum, const U8 num_messages, SpacePosts::SpacePost_Batch &lastMessages)
 	{
-		U8 num_messages_to_load{num_messages};
-		if (SpacePost_Batch_Size < num_messages_to_load)
-		{
-			num_messages_to_load = SpacePost_Batch_Size;
-		}
+		// Not reported through this port
+		U32 newest_index{0};
+		U32 oldest_index{0};
+		return this->loadLastMessages(num_messages, false, 0, false, 0, lastMessages, newest_index, oldest_index);
+	}
 
-		SpacePosts::SpacePost_Array messages_batch{}; // New array to write info to
+	U8 MessageStorage ::
+		loadMessageRange_handler(const NATIVE_INT_TYPE portNum, const U8 num_messages, const U32 after_index,
+								 const bool include_all, const U32 before_index, const bool from_newest,
+								 SpacePosts::SpacePost_Batch &lastMessages, U32 &newest_index, U32 &oldest_index)
+	{
+		return this->loadLastMessages(num_messages, !include_all, after_index, !from_newest, before_index,
+									  lastMessages, newest_index, oldest_index);
+	}
 
-		// Get iterator of lastSuccessfullyStoredIndices pointing from the back to the first index to load
-		auto iterator = this->lastSuccessfullyStoredIndices.crbegin();
-		int num_messages_loaded{0};
-		while (num_messages_loaded < num_messages_to_load && iterator != this->lastSuccessfullyStoredIndices.crend())
+	U8 MessageStorage ::
+		loadMessageRangeWithMetadata_handler(const NATIVE_INT_TYPE portNum, const U8 num_messages,
+											 const U32 after_index, const bool include_all, const U32 before_index,
+											 const bool from_newest, SpacePosts::SpacePost_Batch &lastMessages,
+											 SpacePosts::SpacePostMetadata_Array &metadata, U32 &newest_index,
+											 U32 &oldest_index)
+	{
+		const U8 num_loaded = this->loadLastMessages(num_messages, !include_all, after_index, !from_newest,
+													 before_index, lastMessages, newest_index, oldest_index);
+		// Clear the entries beyond the loaded messages, as loadLastMessages clears the unused entries of lastMessages
+		for (U8 i = 0; i < SpacePost_Batch_Size; ++i)
 		{
-			const U32 index_to_load = *iterator;
-			SpacePosts::SpacePost &message_to_load_into = messages_batch[num_messages_loaded];
-			const bool success = this->loadMessage(index_to_load, message_to_load_into);
-			this->tlmWrite_LOAD_COUNT(++this->numLoadAttempts);
-
-			if (success)
-			{
-				++num_messages_loaded;
-			}
-			++iterator;
+			metadata[i] = (i < num_loaded) ? this->loadedMetadata[i] : SpacePosts::SpacePostMetadata{};
 		}
+		return num_loaded;
+	}
 
-		lastMessages.setmessages(messages_batch); // Write dirty copy back
-		lastMessages.setnumValidMessages(num_messages_loaded);
-		return num_messages_loaded;
+	U32 MessageStorage ::
+		getStoreGeneration_handler(const NATIVE_INT_TYPE portNum)
+	{
+		return this->storeGeneration;
 	}
 
 	// ----------------------------------------------------------------------
@@ -122,233 +216,359 @@ namespace SpacePosts
 	// ----------------------------------------------------------------------
 
 	bool MessageStorage ::
-		storeMessage(const U32 index, const Fw::Serializable &data)
+		createMessageFile(const U32 index, const Fw::Serializable &data, Os::File &file, const bool syncWrite)
 	{
-		StackBuffer stackBuff{};
-		Os::File::Status file_op_status;
+		FilePathBuffer file_path{};
+		this->indexToAbsoluteFilePath(index, file_path);
 
-		const std::string file_name_absolute = this->indexToAbsoluteFilePath(index);
-
-		this->createStorageDirectoryIfNotExists();
-
-		try // Intentionally large try block to handle abort due to all kinds of MessageWriteError exceptions equally
+		/*
+		 *	Check whether file exists: file is not automatically created when opening for read
+		 */
 		{
-			/*
-			 *	Open file
-			 */
-			// Check whether file exists: file is not automatically created when opening for read
 			Os::File testExistsFile{};
-			file_op_status = testExistsFile.open(file_name_absolute.c_str(), Os::File::OPEN_READ);
+			const Os::File::Status file_op_status = testExistsFile.open(file_path.path, Os::File::OPEN_READ);
 			if (file_op_status != Os::File::DOESNT_EXIST)
 			{
 				this->log_WARNING_HI_MESSAGE_STORE_FAILED(index, MessageWriteError::FILE_EXISTS, file_op_status);
-
-				throw MessageWriteError(MessageWriteError::FILE_EXISTS);
-			}
-
-			// File is automatically created when opening for write
-			Os::File file{};
-			file_op_status = file.open(file_name_absolute.c_str(), Os::File::OPEN_SYNC_WRITE);
-			if (file_op_status != Os::File::OP_OK)
-			{
-				this->log_WARNING_HI_MESSAGE_STORE_FAILED(index, MessageWriteError::OPEN, file_op_status);
-				throw MessageWriteError(MessageWriteError::OPEN);
+				return false;
 			}
+		}
 
+		/*
+		 *	Write file. Each stage reports its own MESSAGE_STORE_FAILED event if it fails
+		 */
+		if (!this->writeMessageFile(index, file_path.path, data, file, syncWrite))
+		{
 			/*
-			 * Write delimiter
+			 * Clean Up upon fail
 			 */
-			U8 delimiter = MESSAGESTORAGE_MSGFILE_DELIMITER;
-			NATIVE_INT_TYPE write_size = sizeof(delimiter);
-			this->writeRawBufferToFile(&delimiter, file, write_size, index,
-									   MessageWriteError::DELIMITER_WRITE,
-									   MessageWriteError::DELIMITER_SIZE);
+			// Delete file since it was (possibly) created but storing failed
+			file.close();
+			this->removeFailedMessageFile(index, file_path.path);
+			return false;
+		}
 
-			/*
-			 *	Write message size = length of message type
-			 */
-			// Serialize message 1st time just to get its size
-			stackBuff.safeSerialize(data);
-			const U32 message_size = stackBuff.getBuffLength();
+		return true;
+	}
 
-			stackBuff.safeSerialize(message_size);
-			write_size = sizeof(message_size);
-			this->writeSerializeBufferToFile(stackBuff, file, write_size, index,
-											 MessageWriteError::MESSAGE_SIZE_WRITE,
-											 MessageWriteError::MESSAGE_SIZE_SIZE);
+	void MessageStorage ::
+		completeStore(const U32 index, const bool success)
+	{
+		if (success)
+		{
+			this->addIndexToLastSuccessfullyStoredIndices(index);
+		}
 
-			/*
-			 *	Write message
-			 */
-			// Serialize message 2nd time to write it to file
-			stackBuff.safeSerialize(data);
-			write_size = message_size;
-			this->writeSerializeBufferToFile(stackBuff, file, write_size, index,
-											 MessageWriteError::MESSAGE_CONTENT_WRITE,
-											 MessageWriteError::MESSAGE_CONTENT_SIZE);
+		// A failed store consumes its index as well
+		this->removeExpiredMessages(index);
 
-			/*
-			 *	Done
-			 */
-			this->addIndexToLastSuccessfullyStoredIndices(index);
+		// Either way, the last stored messages may have changed
+		++this->storeGeneration;
+
+		if (success)
+		{
 			this->log_ACTIVITY_LO_MESSAGE_STORE_COMPLETE(index);
+		}
+	}
+
+	bool MessageStorage ::
+		syncMessageFile(const U32 index, Os::File &file)
+	{
+		// Os::File::flush() is an fsync() of this file only. Other files and file systems are not affected
+		const Os::File::Status sync_status = file.flush();
+		file.close();
+		if (sync_status == Os::File::OP_OK)
+		{
 			return true;
-			// file and stackBuffer are closed / deallocated automatically by their destructors
 		}
-		catch (const MessageWriteError &e) // This can only be triggered by the explicity throw statements above
+
+		this->log_WARNING_HI_MESSAGE_STORE_FAILED(index, MessageWriteError::SYNC, sync_status);
+
+		// The message may or may not have reached the storage medium. Do not leave a message reported as failed
+		FilePathBuffer file_path{};
+		this->indexToAbsoluteFilePath(index, file_path);
+		this->removeFailedMessageFile(index, file_path.path);
+		return false;
+	}
+
+	void MessageStorage ::
+		removeFailedMessageFile(const U32 index, const char *const file_path)
+	{
+		Os::FileSystem::Status delete_status = Os::FileSystem::removeFile(file_path);
+		if (delete_status != Os::FileSystem::OP_OK)
 		{
-			/*
-			 * Clean Up upon fail
-			 */
-			// Delete file if file was created but storing failed
-			if (e != MessageWriteError::FILE_EXISTS)
-			{
-				Os::FileSystem::Status delete_status = Os::FileSystem::removeFile(file_name_absolute.c_str());
-				if (delete_status != Os::FileSystem::OP_OK)
-				{
-					this->log_WARNING_HI_MESSAGE_STORE_FAILED(index, MessageWriteError::CLEANUP_DELETE, delete_status);
-				};
-			}
+			this->log_WARNING_HI_MESSAGE_STORE_FAILED(index, MessageWriteError::CLEANUP_DELETE, delete_status);
+		};
+	}
 
+	bool MessageStorage ::
+		writeMessageFile(const U32 index, const char *const file_path, const Fw::Serializable &data, Os::File &file,
+						 const bool syncWrite)
+	{
+		StackBuffer stackBuff{};
+
+		/*
+		 *	Open file
+		 */
+		// File is automatically created when opening for write
+		const Os::File::Mode open_mode = syncWrite ? Os::File::OPEN_SYNC_WRITE : Os::File::OPEN_WRITE;
+		Os::File::Status file_op_status = file.open(file_path, open_mode);
+
+		// The storage directory is only re-validated after an I/O error instead of before every store.
+		// If it had disappeared (e.g., removed by an operator) and could be re-created, retry once.
+		if (file_op_status != Os::File::OP_OK && this->createStorageDirectoryIfNotExists())
+		{
+			file_op_status = file.open(file_path, open_mode);
+		}
+
+		if (file_op_status != Os::File::OP_OK)
+		{
+			this->log_WARNING_HI_MESSAGE_STORE_FAILED(index, MessageWriteError::OPEN, file_op_status);
+			return false;
+		}
+
+		/*
+		 * Write delimiter
+		 */
+		U8 delimiter = MESSAGESTORAGE_MSGFILE_DELIMITER;
+		NATIVE_INT_TYPE write_size = sizeof(delimiter);
+		if (!this->writeRawBufferToFile(&delimiter, file, write_size, index,
+										MessageWriteError::DELIMITER_WRITE,
+										MessageWriteError::DELIMITER_SIZE))
+		{
 			return false;
 		}
+
+		/*
+		 *	Write message size = length of message type
+		 */
+		// Serialize message 1st time just to get its size and checksum
+		stackBuff.safeSerialize(data);
+		const U32 message_size = stackBuff.getBuffLength();
+		const U32 checksum = computeChecksum(stackBuff.getBuffAddr(), message_size);
+
+		stackBuff.safeSerialize(message_size);
+		write_size = sizeof(message_size);
+		if (!this->writeSerializeBufferToFile(stackBuff, file, write_size, index,
+											  MessageWriteError::MESSAGE_SIZE_WRITE,
+											  MessageWriteError::MESSAGE_SIZE_SIZE))
+		{
+			return false;
+		}
+
+		/*
+		 *	Write metadata. Assigned once here so that nobody needs to look it up after loading
+		 */
+		const Fw::Time store_time = this->getTime();
+		const SpacePostMetadata metadata{index, store_time.getSeconds(), store_time.getUSeconds(), checksum};
+		stackBuff.safeSerialize(metadata);
+		write_size = SpacePostMetadata::SERIALIZED_SIZE;
+		if (!this->writeSerializeBufferToFile(stackBuff, file, write_size, index,
+											  MessageWriteError::METADATA_WRITE,
+											  MessageWriteError::METADATA_SIZE))
+		{
+			return false;
+		}
+
+		/*
+		 *	Write message
+		 */
+		// Serialize message 2nd time to write it to file
+		stackBuff.safeSerialize(data);
+		write_size = message_size;
+		return this->writeSerializeBufferToFile(stackBuff, file, write_size, index,
+												MessageWriteError::MESSAGE_CONTENT_WRITE,
+												MessageWriteError::MESSAGE_CONTENT_SIZE);
+		// file is left open to the caller. stackBuffer is deallocated automatically by its destructor
 	}
 
-	bool MessageStorage::loadMessage(const U32 index, Fw::Serializable &data)
+	bool MessageStorage::loadMessage(const U32 index, Fw::Serializable &data, SpacePostMetadata &metadata)
 	{
 		StackBuffer stackBuff{};
 		Os::File::Status file_op_status;
 		NATIVE_INT_TYPE read_size;
 
-		const std::string file_name_absolute = this->indexToAbsoluteFilePath(index);
+		FilePathBuffer file_path{};
+		this->indexToAbsoluteFilePath(index, file_path);
 
-		try // Same method as for storeMessage(): Throw + catch MessageReadError if an operation fails
+		// Every failing stage triggers its MESSAGE_LOAD_FAILED event and returns false right away.
+		// No exceptions are used so that loading a corrupted file is as cheap as loading a valid one.
+
+		/*
+		 *	Open file
+		 */
+		Os::File file{};
+		file_op_status = file.open(file_path.path, Os::File::OPEN_READ);
+		if (file_op_status != Os::File::OP_OK)
 		{
-			/*
-			 *	Open file
-			 */
-			Os::File file{};
-			file_op_status = file.open(file_name_absolute.c_str(), Os::File::OPEN_READ);
-			if (file_op_status != Os::File::OP_OK)
-			{
-				this->log_WARNING_LO_MESSAGE_LOAD_FAILED(index, MessageReadError::OPEN, file_op_status);
-				throw MessageReadError(MessageReadError::OPEN);
-			}
+			this->log_WARNING_LO_MESSAGE_LOAD_FAILED(index, MessageReadError::OPEN, file_op_status);
+			return false;
+		}
 
-			/*
-			 *	Read delimiter + check whether it is the expected MESSAGESTORAGE_MSGFILE_DELIMITER
-			 */
-			U8 delimiter;
-			this->readRawBufferFromFile(&delimiter, file, sizeof(delimiter), index,
-										MessageReadError::DELIMITER_READ,
-										MessageReadError::DELIMITER_SIZE);
+		/*
+		 *	Read delimiter + check whether it is the expected MESSAGESTORAGE_MSGFILE_DELIMITER
+		 */
+		U8 delimiter;
+		if (!this->readRawBufferFromFile(&delimiter, file, sizeof(delimiter), index,
+										 MessageReadError::DELIMITER_READ,
+										 MessageReadError::DELIMITER_SIZE))
+		{
+			return false;
+		}
 
-			if (delimiter != MESSAGESTORAGE_MSGFILE_DELIMITER)
-			{
-				this->log_WARNING_LO_MESSAGE_LOAD_FAILED(index, MessageReadError::DELIMITER_CONTENT, delimiter);
-				throw MessageReadError(MessageReadError::DELIMITER_CONTENT);
-			}
+		const bool has_metadata = (delimiter == MESSAGESTORAGE_MSGFILE_DELIMITER);
+		if (!has_metadata && delimiter != MESSAGESTORAGE_MSGFILE_DELIMITER_NO_METADATA)
+		{
+			this->log_WARNING_LO_MESSAGE_LOAD_FAILED(index, MessageReadError::DELIMITER_CONTENT, delimiter);
+			return false;
+		}
 
-			/*
-			 *	Read message size
-			 */
-			U32 message_size{0};
-			read_size = sizeof(message_size);
-			this->readRawBufferFromFile(stackBuff.getBuffAddr(), file, read_size, index,
-										MessageReadError::MESSAGE_SIZE_READ,
-										MessageReadError::MESSAGE_SIZE_SIZE);
+		/*
+		 *	Read message size
+		 */
+		U32 message_size{0};
+		read_size = sizeof(message_size);
+		if (!this->readRawBufferFromFile(stackBuff.getBuffAddr(), file, read_size, index,
+										 MessageReadError::MESSAGE_SIZE_READ,
+										 MessageReadError::MESSAGE_SIZE_SIZE))
+		{
+			return false;
+		}
 
-			const std::function<void()> set_length_failure_callback_size = [&]()
+		const bool size_deserialized = stackBuff.safeDeserialize(
+			message_size, read_size,
+			[&]()
 			{
 				this->log_WARNING_LO_MESSAGE_LOAD_FAILED(index, MessageReadError::MESSAGE_SIZE_DESER_SET_LENGTH,
 														 message_size);
-				throw MessageReadError(MessageReadError::MESSAGE_SIZE_DESER_SET_LENGTH);
-			};
-			const std::function<void(const NATIVE_UINT_TYPE)> deserialize_status_failure_callback_size = [&](const NATIVE_UINT_TYPE error_code)
+			},
+			[&](const NATIVE_UINT_TYPE error_code)
 			{
 				this->log_WARNING_LO_MESSAGE_LOAD_FAILED(index, MessageReadError::MESSAGE_SIZE_DESER_EXCECUTE,
 														 error_code);
-				throw MessageReadError(MessageReadError::MESSAGE_SIZE_DESER_EXCECUTE);
-			};
-			const std::function<void(const NATIVE_UINT_TYPE)> deserialize_length_failure_callback_size = [&](const NATIVE_UINT_TYPE error_code)
+			},
+			[&](const NATIVE_UINT_TYPE error_code)
 			{
-				this->log_WARNING_LO_MESSAGE_LOAD_FAILED(index, MessageReadError::MESSAGE_CONTENT_DESER_READ_LENGTH,
+				this->log_WARNING_LO_MESSAGE_LOAD_FAILED(index, MessageReadError::MESSAGE_SIZE_DESER_READ_LENGTH,
 														 error_code);
-				throw MessageReadError(MessageReadError::MESSAGE_CONTENT_DESER_READ_LENGTH);
-			};
-			stackBuff.safeDeserialize(message_size, read_size, set_length_failure_callback_size,
-									  deserialize_status_failure_callback_size,
-									  deserialize_length_failure_callback_size);
-
-			// Check whether message will fit into stackBuff
-			if (message_size > stackBuff.getBuffCapacity())
+			});
+		if (!size_deserialized)
+		{
+			return false;
+		}
+
+		// Check whether message will fit into stackBuff
+		if (message_size > stackBuff.getBuffCapacity())
+		{
+			this->log_WARNING_LO_MESSAGE_LOAD_FAILED(index, MessageReadError::MESSAGE_SIZE_EXCEEDS_BUFFER,
+													 message_size);
+			return false;
+		}
+
+		// Check whether message size is 0. Could not procede if it is, because we would try to read 0 bytes
+		// for the message content's serialization
+		if (message_size == 0)
+		{
+			this->log_WARNING_LO_MESSAGE_LOAD_FAILED(index, MessageReadError::MESSAGE_SIZE_ZERO, 0);
+			return false;
+		}
+
+		/*
+		 *	Read metadata
+		 */
+		if (has_metadata)
+		{
+			read_size = SpacePostMetadata::SERIALIZED_SIZE;
+			if (!this->readRawBufferFromFile(stackBuff.getBuffAddr(), file, read_size, index,
+											 MessageReadError::METADATA_READ,
+											 MessageReadError::METADATA_SIZE))
 			{
-				this->log_WARNING_LO_MESSAGE_LOAD_FAILED(index, MessageReadError::MESSAGE_SIZE_EXCEEDS_BUFFER,
-														 message_size);
-				throw MessageReadError(MessageReadError::MESSAGE_SIZE_EXCEEDS_BUFFER);
+				return false;
 			}
 
-			// Check whether message size is 0. Could not procede if it is, because we would try to read 0 bytes
-			// for the message content's serialization
-			if (message_size == 0)
+			const bool metadata_deserialized = stackBuff.safeDeserialize(
+				metadata, read_size,
+				[&]()
+				{
+					this->log_WARNING_LO_MESSAGE_LOAD_FAILED(index, MessageReadError::METADATA_DESER_SET_LENGTH,
+															 read_size);
+				},
+				[&](const NATIVE_UINT_TYPE error_code)
+				{
+					this->log_WARNING_LO_MESSAGE_LOAD_FAILED(index, MessageReadError::METADATA_DESER_EXCECUTE,
+															 error_code);
+				},
+				[&](const NATIVE_UINT_TYPE error_code)
+				{
+					this->log_WARNING_LO_MESSAGE_LOAD_FAILED(index, MessageReadError::METADATA_DESER_READ_LENGTH,
+															 error_code);
+				});
+			if (!metadata_deserialized)
 			{
-				this->log_WARNING_LO_MESSAGE_LOAD_FAILED(index, MessageReadError::MESSAGE_SIZE_ZERO, 0);
-				throw MessageReadError(MessageReadError::MESSAGE_SIZE_ZERO);
+				return false;
 			}
+		}
 
-			/*
-			 *	Read message
-			 */
-			read_size = message_size;
-			this->readRawBufferFromFile(stackBuff.getBuffAddr(), file, read_size, index,
-										MessageReadError::MESSAGE_CONTENT_READ,
-										MessageReadError::MESSAGE_CONTENT_SIZE);
+		/*
+		 *	Read message
+		 */
+		read_size = message_size;
+		if (!this->readRawBufferFromFile(stackBuff.getBuffAddr(), file, read_size, index,
+										 MessageReadError::MESSAGE_CONTENT_READ,
+										 MessageReadError::MESSAGE_CONTENT_SIZE))
+		{
+			return false;
+		}
 
-			const std::function<void()> set_length_failure_callback_content = [&]()
+		// Detects corruption of the file which still leaves a well-formed message, e.g., a flipped bit in the text
+		const U32 checksum = computeChecksum(stackBuff.getBuffAddr(), message_size);
+		if (!has_metadata)
+		{
+			metadata.set(index, 0, 0, checksum);
+		}
+		else if (checksum != metadata.getchecksum())
+		{
+			this->log_WARNING_LO_MESSAGE_LOAD_FAILED(index, MessageReadError::CHECKSUM, checksum);
+			return false;
+		}
+
+		const bool content_deserialized = stackBuff.safeDeserialize(
+			data, read_size,
+			[&]()
 			{
 				this->log_WARNING_LO_MESSAGE_LOAD_FAILED(index, MessageReadError::MESSAGE_CONTENT_DESER_SET_LENGTH,
 														 read_size);
-				throw MessageReadError(MessageReadError::MESSAGE_CONTENT_DESER_SET_LENGTH);
-			};
-			const std::function<void(const NATIVE_UINT_TYPE)> deserialize_status_failure_callback_content = [&](const NATIVE_UINT_TYPE error_code)
+			},
+			[&](const NATIVE_UINT_TYPE error_code)
 			{
 				this->log_WARNING_LO_MESSAGE_LOAD_FAILED(index, MessageReadError::MESSAGE_CONTENT_DESER_EXCECUTE,
 														 error_code);
-				throw MessageReadError(MessageReadError::MESSAGE_CONTENT_DESER_EXCECUTE);
-			};
-			const std::function<void(const NATIVE_UINT_TYPE)> deserialize_length_failure_callback_content = [&](const NATIVE_UINT_TYPE error_code)
+			},
+			[&](const NATIVE_UINT_TYPE error_code)
 			{
 				this->log_WARNING_LO_MESSAGE_LOAD_FAILED(index, MessageReadError::MESSAGE_CONTENT_DESER_READ_LENGTH,
 														 error_code);
-				throw MessageReadError(MessageReadError::MESSAGE_CONTENT_DESER_READ_LENGTH);
-			};
-			stackBuff.safeDeserialize(data, read_size, set_length_failure_callback_content,
-									  deserialize_status_failure_callback_content,
-									  deserialize_length_failure_callback_content);
-
-			/*
-			 *	Done
-			 */
+			});
+		if (!content_deserialized)
+		{
+			return false;
+		}
 
-			// Check whether file has been read to the end by trying to read one more byte and expecting it to read none
-			read_size = 1;
-			const Os::File::Status file_status = file.read(stackBuff.getBuffAddr(), read_size, true);
-			if (file_status != Os::File::OP_OK || read_size != 0)
-			{
-				this->log_WARNING_LO_MESSAGE_LOAD_FAILED(index, MessageReadError::FILE_END, file_status);
-				throw MessageReadError(MessageReadError::FILE_END);
-			}
+		/*
+		 *	Done
+		 */
 
-			this->log_ACTIVITY_LO_MESSAGE_LOAD_COMPLETE(index);
-			return true;
-		}
-		catch (const MessageReadError &e)
+		// Check whether file has been read to the end by trying to read one more byte and expecting it to read none
+		read_size = 1;
+		const Os::File::Status file_status = file.read(stackBuff.getBuffAddr(), read_size, true);
+		if (file_status != Os::File::OP_OK || read_size != 0)
 		{
-			// Put common handling of file open errors here if needed
-			// Try-catch is kept, even though it is empty for now, for consistency with storeMessage()
-
+			this->log_WARNING_LO_MESSAGE_LOAD_FAILED(index, MessageReadError::FILE_END, file_status);
 			return false;
 		}
+
+		this->log_ACTIVITY_LO_MESSAGE_LOAD_COMPLETE(index);
+		return true;
 	}
 
 	bool MessageStorage::restoreIndexFromHighestStoredIndexFoundInDirectory()
@@ -358,7 +578,7 @@ namespace SpacePosts
 		Os::Directory storage_dir;
 		Os::Directory::Status dir_status;
 
-		dir_status = storage_dir.open(MESSAGESTORAGE_MSGFILE_DIRECTORY.c_str());
+		dir_status = storage_dir.open(this->storageDirectory);
 		if (dir_status != Os::Directory::OP_OK)
 		{
 			this->log_WARNING_HI_INDEX_RESTORE_FAILED(IndexRestoreError::STORAGE_DIR_OPEN, dir_status);
@@ -417,6 +637,29 @@ namespace SpacePosts
 
 		// Restore lastSuccessfullyStoredIndices from the parsed indices
 		std::sort(existing_file_indices.begin(), existing_file_indices.end());
+		const std::size_t num_files_found = existing_file_indices.size();
+
+		// Delete the files which fell out of the retention, e.g., because maxStoredMessages has been lowered
+		bool retry_index_found{false};
+		U32 first_retry_index{0};
+		if (this->maxStoredMessages > 0 && !existing_file_indices.empty() &&
+			existing_file_indices.back() >= this->maxStoredMessages)
+		{
+			const U32 oldest_kept_index = existing_file_indices.back() - this->maxStoredMessages + 1;
+			const auto first_kept = std::lower_bound(existing_file_indices.begin(), existing_file_indices.end(),
+													 oldest_kept_index);
+			for (auto expired = existing_file_indices.begin(); expired != first_kept; ++expired)
+			{
+				if (!this->removeMessageFile(*expired) && !retry_index_found)
+				{
+					// Retried upon the next store
+					first_retry_index = *expired;
+					retry_index_found = true;
+				}
+			}
+			existing_file_indices.erase(existing_file_indices.begin(), first_kept);
+		}
+
 		this->lastSuccessfullyStoredIndices.clear();
 		const std::size_t restored_history_size = std::min(
 			static_cast<size_t>(MESSAGESTORAGE_STORED_INDEX_HISTORY_SIZE), existing_file_indices.size());
@@ -435,7 +678,18 @@ namespace SpacePosts
 		else
 		{
 			this->nextIndexCounter = existing_file_indices.back() + 1;
-			this->log_ACTIVITY_LO_INDEX_RESTORE_COMPLETE(existing_file_indices.size(), this->nextIndexCounter - 1);
+			this->log_ACTIVITY_LO_INDEX_RESTORE_COMPLETE(num_files_found, this->nextIndexCounter - 1);
+		}
+
+		// No index below the oldest remaining file has a file anymore, except for the ones which failed to delete
+		if (retry_index_found)
+		{
+			this->oldestRetainedIndex = first_retry_index;
+		}
+		else
+		{
+			this->oldestRetainedIndex = existing_file_indices.empty() ? this->nextIndexCounter
+																	  : existing_file_indices.front();
 		}
 
 		this->tlmWrite_NEXT_STORAGE_INDEX(this->nextIndexCounter);
@@ -468,25 +722,153 @@ namespace SpacePosts
 		this->lastSuccessfullyStoredIndices.push_back(index);
 	}
 
-	std::string MessageStorage::indexToAbsoluteFilePath(const U32 index)
+	void MessageStorage::removeExpiredMessages(const U32 newest_index)
+	{
+		if (this->maxStoredMessages == 0 || newest_index < this->maxStoredMessages)
+		{
+			return;
+		}
+
+		const U32 expired_index = newest_index - this->maxStoredMessages;
+
+		// Usually only expired_index itself. More after a failed deletion or after indices have been skipped
+		U32 first_failed_index{expired_index + 1};
+		for (U32 index = this->oldestRetainedIndex; index <= expired_index; ++index)
+		{
+			if (!this->removeMessageFile(index) && first_failed_index > expired_index)
+			{
+				first_failed_index = index;
+			}
+		}
+		if (this->oldestRetainedIndex <= expired_index)
+		{
+			this->oldestRetainedIndex = first_failed_index;
+		}
+
+		// Indices are remembered in ascending order, so the expired ones are at the front
+		while (!this->lastSuccessfullyStoredIndices.empty() &&
+			   this->lastSuccessfullyStoredIndices.front() <= expired_index)
+		{
+			this->lastSuccessfullyStoredIndices.pop_front();
+		}
+	}
+
+	bool MessageStorage::removeMessageFile(const U32 index)
 	{
-		return MESSAGESTORAGE_MSGFILE_DIRECTORY +
-			   std::to_string(index) +
-			   MESSAGESTORAGE_MSGFILE_FILE_EXTENSION;
+		FilePathBuffer file_path{};
+		this->indexToAbsoluteFilePath(index, file_path);
+
+		// Os::FileSystem reports a file which does not exist as INVALID_PATH
+		const Os::FileSystem::Status delete_status = Os::FileSystem::removeFile(file_path.path);
+		if (delete_status != Os::FileSystem::OP_OK && delete_status != Os::FileSystem::INVALID_PATH)
+		{
+			this->log_WARNING_HI_MESSAGE_STORE_FAILED(index, MessageWriteError::RETENTION_DELETE, delete_status);
+			return false;
+		}
+		return true;
 	}
 
-	void MessageStorage::writeSerializeBufferToFile(Fw::SerializeBufferBase &serializeBuffer, Os::File &file,
+	U8 MessageStorage::loadLastMessages(const U8 num_messages, const bool only_newer, const U32 after_index,
+										const bool only_older, const U32 before_index,
+										SpacePosts::SpacePost_Batch &lastMessages, U32 &newest_index,
+										U32 &oldest_index)
+	{
+		U8 num_messages_to_load{num_messages};
+		if (SpacePost_Batch_Size < num_messages_to_load)
+		{
+			num_messages_to_load = SpacePost_Batch_Size;
+		}
+
+		// Packs only the loaded message contents. The caller's batch is written once at the end
+		this->loadedMessages.clear();
+		CompactBatchAppender appender{this->loadedMessages};
+
+		// Get iterator of lastSuccessfullyStoredIndices pointing from the back to the first index to load
+		auto iterator = this->lastSuccessfullyStoredIndices.crbegin();
+		int num_messages_loaded{0};
+		while (num_messages_loaded < num_messages_to_load && iterator != this->lastSuccessfullyStoredIndices.crend())
+		{
+			const U32 index_to_load = *iterator;
+			if (only_newer && index_to_load <= after_index)
+			{
+				// Indices are stored in ascending order. All remaining ones are old as well
+				break;
+			}
+			if (only_older && index_to_load >= before_index)
+			{
+				// Belongs to a previous page
+				++iterator;
+				continue;
+			}
+
+			const bool success = this->loadMessage(index_to_load, appender,
+												   this->loadedMetadata[num_messages_loaded]);
+			this->tlmWrite_LOAD_COUNT(++this->numLoadAttempts);
+
+			if (success)
+			{
+				if (num_messages_loaded == 0)
+				{
+					newest_index = index_to_load;
+				}
+				oldest_index = index_to_load;
+				++num_messages_loaded;
+			}
+			else
+			{
+				// A later stage may have failed after the message content had already been appended
+				this->loadedMessages.truncate(static_cast<U8>(num_messages_loaded));
+			}
+			++iterator;
+		}
+
+		this->loadedMessages.toBatch(lastMessages);
+		return num_messages_loaded;
+	}
+
+	void MessageStorage::indexToAbsoluteFilePath(const U32 index, FilePathBuffer &filePath) const
+	{
+		// <directory><index><extension>, e.g., "/home/spaceposts/42.spaceposts"
+		char *cursor = filePath.path;
+		(void)std::memcpy(cursor, this->storageDirectory, this->storageDirectoryLength);
+		cursor += this->storageDirectoryLength;
+
+		// Write decimal digits of the index back to front into a scratch buffer. A U32 has at most 10 digits
+		char digits[10];
+		U32 num_digits{0};
+		U32 remaining_index{index};
+		do
+		{
+			digits[num_digits++] = static_cast<char>('0' + (remaining_index % 10));
+			remaining_index /= 10;
+		} while (remaining_index != 0);
+
+		while (num_digits > 0)
+		{
+			*cursor++ = digits[--num_digits];
+		}
+
+		const U32 extension_length = MESSAGESTORAGE_MSGFILE_FILE_EXTENSION.length();
+		(void)std::memcpy(cursor, MESSAGESTORAGE_MSGFILE_FILE_EXTENSION.c_str(), extension_length);
+		cursor += extension_length;
+		*cursor = '\0';
+
+		FW_ASSERT(cursor - filePath.path <= MESSAGESTORAGE_MSGFILE_PATH_MAXLENGTH,
+				  static_cast<NATIVE_INT_TYPE>(cursor - filePath.path));
+	}
+
+	bool MessageStorage::writeSerializeBufferToFile(Fw::SerializeBufferBase &serializeBuffer, Os::File &file,
 													const NATIVE_INT_TYPE expected_write_size, const U32 &index,
 													const MessageWriteError write_error_stage,
 													const MessageWriteError size_error_stage)
 	{
 		NATIVE_INT_TYPE actual_write_size = serializeBuffer.getBuffLength();
 		FW_ASSERT(actual_write_size == expected_write_size, actual_write_size);
-		this->writeRawBufferToFile(serializeBuffer.getBuffAddr(), file, actual_write_size,
-								   index, write_error_stage, size_error_stage);
+		return this->writeRawBufferToFile(serializeBuffer.getBuffAddr(), file, actual_write_size,
+										  index, write_error_stage, size_error_stage);
 	}
 
-	void MessageStorage::writeRawBufferToFile(const void *const buffer_address, Os::File &file,
+	bool MessageStorage::writeRawBufferToFile(const void *const buffer_address, Os::File &file,
 											  const NATIVE_INT_TYPE expected_write_size, const U32 &index,
 											  const MessageWriteError write_error_stage,
 											  const MessageWriteError size_error_stage)
@@ -496,18 +878,20 @@ namespace SpacePosts
 		if (file_op_status != Os::File::OP_OK)
 		{
 			this->log_WARNING_HI_MESSAGE_STORE_FAILED(index, write_error_stage, file_op_status);
-			throw write_error_stage;
+			return false;
 		}
 
 		// file.write() overwrites write_size with the number of bytes actually written
 		if (write_size != expected_write_size)
 		{
 			this->log_WARNING_HI_MESSAGE_STORE_FAILED(index, size_error_stage, write_size);
-			throw size_error_stage;
+			return false;
 		}
+
+		return true;
 	}
 
-	void MessageStorage::readRawBufferFromFile(void *const buffer_address, Os::File &file,
+	bool MessageStorage::readRawBufferFromFile(void *const buffer_address, Os::File &file,
 											   const NATIVE_INT_TYPE expected_read_size, const U32 &index,
 											   const MessageReadError read_error_stage,
 											   const MessageReadError size_error_stage)
@@ -517,27 +901,30 @@ namespace SpacePosts
 		if (file_op_status != Os::File::OP_OK)
 		{
 			this->log_WARNING_LO_MESSAGE_LOAD_FAILED(index, read_error_stage, file_op_status);
-			throw read_error_stage;
+			return false;
 		}
 
 		// file.read() overwrites read_size with the number of bytes actually read
 		if (read_size != expected_read_size)
 		{
 			this->log_WARNING_LO_MESSAGE_LOAD_FAILED(index, size_error_stage, read_size);
-			throw size_error_stage;
+			return false;
 		}
+
+		return true;
 	}
 
-	void MessageStorage::createStorageDirectoryIfNotExists()
+	bool MessageStorage::createStorageDirectoryIfNotExists()
 	{
-		Os::FileSystem::Status dir_create_status = Os::FileSystem::createDirectory(
-			MESSAGESTORAGE_MSGFILE_DIRECTORY.c_str());
-		if (dir_create_status != Os::FileSystem::ALREADY_EXISTS)
+		Os::FileSystem::Status dir_create_status = Os::FileSystem::createDirectory(this->storageDirectory);
+		if (dir_create_status == Os::FileSystem::ALREADY_EXISTS)
 		{
-			const bool creation_successful{dir_create_status == Os::FileSystem::OP_OK};
-			this->log_WARNING_LO_STORAGE_DIRECTORY_WARNING(MESSAGESTORAGE_MSGFILE_DIRECTORY.c_str(),
-														   creation_successful);
+			return false;
 		}
+
+		const bool creation_successful{dir_create_status == Os::FileSystem::OP_OK};
+		this->log_WARNING_LO_STORAGE_DIRECTORY_WARNING(this->storageDirectory, creation_successful);
+		return creation_successful;
 	}
 
 } // end namespace SpacePosts
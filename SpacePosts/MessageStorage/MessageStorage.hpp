@@ -15,11 +15,12 @@
 
 #include <mutex>
 #include <deque>
-#include <functional>
 
 #include <Os/File.hpp>
 
 #include "SpacePosts/MessageStorage/MessageStorageComponentAc.hpp"
+#include "SpacePosts/MessageTypes/CompactSpacePostBatch.hpp"
+#include <config/MessageStorageCfg.hpp>
 
 namespace SpacePosts
 {
@@ -86,23 +87,28 @@ namespace SpacePosts
       //! Sets the given read_size, and resets the buffer before
       //! deserializing.
       //!
-      //! Calls the provided lambdas if an error occurs during deserialization.
+      //! Calls the provided callback for the failing step if an error occurs during deserialization and returns
+      //! false. Returns true iff the deserialization was successful.
+      //!
+      //! The callbacks are template parameters so that they are resolved at compile time. Lambdas passed here are
+      //! inlined and do not need any type erasure (e.g., no std::function).
       //!
       //! The template parameter T must be a type for which an overloading of
       //! Fw::SerializeBufferBase.deserialize(T &val) exists
-      template <typename T>
-      void safeDeserialize(
-          T &deserialization_target,                                                      /*< The variable into which to deserialize the buffer */
-          const NATIVE_UINT_TYPE read_size,                                               /*< The number of bytes that are valid in this buffer and
-                                                                                              can be deserialized */
-          const std::function<void()> trigger_set_length_failure,                         /*< The function to call if setting the buffer length fails.
-                                                                                      Used only in this error case. */
-          std::function<void(const NATIVE_UINT_TYPE)> trigger_deserialize_status_failure, /*!< The function to call if the deserialization of the
-                                                              buffer into the provided variable fails.
-                                                              Used only in this error case. */
-          std::function<void(const NATIVE_UINT_TYPE)> trigger_deserialize_length_failure  /*!< The function to call if the deserialization of the
-                                                     buffer into the provided variable fails.
-                                                     Used only in this error case. */
+      template <typename T, typename SetLengthFailure, typename DeserializeStatusFailure,
+                typename DeserializeLengthFailure>
+      bool safeDeserialize(
+          T &deserialization_target,                                     /*< The variable into which to deserialize the buffer */
+          const NATIVE_UINT_TYPE read_size,                              /*< The number of bytes that are valid in this buffer and
+                                                                             can be deserialized */
+          const SetLengthFailure &trigger_set_length_failure,            /*< Callable void() to call if setting the buffer length
+                                                                             fails. Used only in this error case. */
+          const DeserializeStatusFailure &trigger_deserialize_status_failure, /*!< Callable void(const NATIVE_UINT_TYPE) to call if
+                                                                             the deserialization of the buffer into the provided
+                                                                             variable fails. Used only in this error case. */
+          const DeserializeLengthFailure &trigger_deserialize_length_failure  /*!< Callable void(const NATIVE_UINT_TYPE) to call if
+                                                                             the deserialization did not use all bytes of the
+                                                                             buffer. Used only in this error case. */
       )
       {
         Fw::SerializeStatus deserialize_status = this->setBuffLen(read_size);
@@ -110,6 +116,7 @@ namespace SpacePosts
         if (deserialize_status != Fw::FW_SERIALIZE_OK)
         {
           trigger_set_length_failure();
+          return false;
         }
 
         this->resetDeser();
@@ -118,6 +125,7 @@ namespace SpacePosts
         if (deserialize_status != Fw::FW_SERIALIZE_OK)
         {
           trigger_deserialize_status_failure(deserialize_status);
+          return false;
         }
 
         // Check whether deserialized type used all of the available data in this buffer.
@@ -128,12 +136,48 @@ namespace SpacePosts
         if (this->getBuffLeft() != 0)
         {
           trigger_deserialize_length_failure(this->getBuffLeft());
+          return false;
         }
+
+        return true;
       }
 
     private:
       U8 m_buff[CAPACITY];
     };
+
+    // Buffer on stack for the absolute path of a SpacePost file.
+    // This avoids concatenating std::strings on the heap for every store and load
+    struct FilePathBuffer
+    {
+      char path[MESSAGESTORAGE_MSGFILE_PATH_MAXLENGTH + 1]; // +1 for the null terminator
+    };
+
+    // Serializable which appends the SpacePost deserialized into it to a CompactSpacePostBatch.
+    // Loading a message file into it copies the message content straight into the batch's arena instead of
+    // into a SpacePost of a SpacePost_Array first
+    class CompactBatchAppender : public Fw::Serializable
+    {
+    public:
+      explicit CompactBatchAppender(CompactSpacePostBatch &batch) : m_batch(batch)
+      {
+      }
+
+      Fw::SerializeStatus serialize(Fw::SerializeBufferBase &buffer) const
+      {
+        // Only used for loading
+        FW_ASSERT(0);
+        return Fw::FW_SERIALIZE_FORMAT_ERROR;
+      }
+
+      Fw::SerializeStatus deserialize(Fw::SerializeBufferBase &buffer)
+      {
+        return this->m_batch.appendSerialized(buffer);
+      }
+
+    private:
+      CompactSpacePostBatch &m_batch;
+    };
   }
 
   class MessageStorage : public MessageStorageComponentBase
@@ -154,9 +198,30 @@ namespace SpacePosts
     // The number of attempts made to store a message using this component
     U32 numStoreAttempts = 0;
 
+    // Changes with every completed attempt to store a message. Returned by the getStoreGeneration port.
+    U32 storeGeneration = 0;
+
+    // Absolute path of the storage directory (incl. trailing slash) and its length.
+    //
+    // Copied in front of the file name when formatting a file path. Kept as a member so that no string needs
+    // to be measured or allocated when formatting a path.
+    char storageDirectory[MESSAGESTORAGE_MSGFILE_DIRECTORY_MAXLENGTH + 1];
+    U32 storageDirectoryLength = 0;
+
     // The number of attempts made to load a message using this component
     U32 numLoadAttempts = 0;
 
+    // The number of most recent indices whose message files are kept. Older ones are deleted when storing.
+    //
+    // 0 keeps all message files. Set by configure().
+    U32 maxStoredMessages = 0;
+
+    // The lowest index which may still have a message file that falls out of the retention.
+    //
+    // Every index below it has been deleted. Only advanced past an index once its file is deleted, so that a
+    // failed deletion is retried upon the next store. Restored upon initialization.
+    U32 oldestRetainedIndex = 0;
+
     //! An indexing data structure to keep track of for which indices a message is successfully stored in the storage
     //! directory.
     //!
@@ -164,28 +229,88 @@ namespace SpacePosts
     //! I.e., lastSuccessfullyStoredIndices.size() in [0, N].
     std::deque<U32> lastSuccessfullyStoredIndices;
 
+    //! The SpacePosts loaded by loadLastMessages() before they are handed to the caller's SpacePost_Batch.
+    //!
+    //! A member instead of a local variable to keep the batch off the stack of the calling thread. Safe to share
+    //! because all input ports are guarded.
+    CompactSpacePostBatch loadedMessages;
+
+    //! The metadata of the SpacePosts loaded by loadLastMessages(), in the order of loadedMessages.
+    //!
+    //! Only handed to the caller by the loadMessageRangeWithMetadata port.
+    SpacePostMetadata_Array loadedMetadata;
+
     // ----------------------------------------------------------------------
     // Private member functions
     // ----------------------------------------------------------------------
 
-    //! Stores a message at the the provided index.
+    //! Creates the message file for the provided index and writes the message to it.
     //!
     //! If a file already exists at the provided index, storing the message will fail.
     //!
-    //! Returns true if the message was successfully stored, false otherwise.
+    //! Returns true if the message file was successfully written, false otherwise. The file is left open in the
+    //! given Os::File in the former case. Storing is only finished by completeStore().
     //!
     //! If the message was not successfully stored, an event of type
-    //! MessageStorage_MessageWriteError is triggered.
+    //! MessageStorage_MessageWriteError is triggered and the possibly created file is deleted.
+    //!
+    //! Without syncWrite, the message is only durable after syncMessageFile().
+    bool createMessageFile(
+        const U32 index,              /*!< The index at which to store the message */
+        const Fw::Serializable &data, /*!< The content of the message to be stored */
+        Os::File &file,               /*!< The file to open for the message. Left open if successful */
+        const bool syncWrite          /*!< Whether to write the file synchronously */
+    );
+
+    //! Finishes storing at the given index: remembers the index if storing was successful and deletes the message
+    //! files which fell out of the retention either way.
+    void completeStore(
+        const U32 index,   /*!< The index at which storing was attempted */
+        const bool success /*!< Whether the message was successfully stored */
+    );
+
+    //! Flushes the message file written without syncWrite to the storage medium and closes it.
     //!
-    bool storeMessage(
-        const U32 index,             /*!< The index at which to store the message */
-        const Fw::Serializable &data /*!< The content of the message to be stored */
+    //! Uses Os::File::flush(), i.e., an fsync() of the file only. Returns true iff flushing was successful.
+    //! Otherwise, a MESSAGE_STORE_FAILED event with stage SYNC is triggered and the file is deleted because it is
+    //! unknown whether the message is durable.
+    bool syncMessageFile(
+        const U32 index, /*!< The index of the message file */
+        Os::File &file   /*!< The open message file */
+    );
+
+    //! Deletes the message file of a store which failed. Failing to do so triggers a MESSAGE_STORE_FAILED event
+    //! with stage CLEANUP_DELETE.
+    void removeFailedMessageFile(
+        const U32 index,            /*!< The index of the message file */
+        const char *const file_path /*!< The absolute path of the message file */
+    );
+
+    //! Opens the file for the given index and writes the message to it in the SpacePost file format.
+    //!
+    //! Returns true if the complete message file was successfully written, false otherwise.
+    //!
+    //! If writing failed, an event of type MessageStorage_MessageWriteError is triggered for the failing stage.
+    //! The file may have been created and be partially written in this case. Cleaning it up is left to the caller.
+    //!
+    //! If the file cannot be created, the storage directory is re-validated. If it had disappeared and could be
+    //! re-created, opening the file is retried once.
+    bool writeMessageFile(
+        const U32 index,              /*!< The index at which to store the message */
+        const char *const file_path,  /*!< The absolute path of the file for the given index */
+        const Fw::Serializable &data, /*!< The content of the message to be stored */
+        Os::File &file,               /*!< The file to open and write. Left open to the caller */
+        const bool syncWrite          /*!< Whether to open the file with OPEN_SYNC_WRITE instead of OPEN_WRITE */
     );
 
     //! Loads a message with the provided index if it exists in the storage directory.
     //!
     //! If no file exists at the provided index, loading the message will fail.
     //!
+    //! The checksum of the message content is verified against the one stored in the file's metadata. For a file
+    //! stored without metadata, the metadata is derived instead: the given index, the checksum of the message
+    //! content, and a store time of 0.
+    //!
     //! Returns true if the message was successfully loaded, false otherwise.
     //! In the latter case, the passed SpacePost object is not modified.
     //!
@@ -194,9 +319,11 @@ namespace SpacePosts
     //! have been modfiied and is not guaranteed to be in a valid state.
     bool loadMessage(
         const U32 index,       /*!< The index at which to load the message */
-        Fw::Serializable &data /*!< The SpacePost object which will be loaded from file. The variable behind the
+        Fw::Serializable &data, /*!< The SpacePost object which will be loaded from file. The variable behind the
                                     the given reference will be overwritten with the loaded SpacePost (if loading
                                     was successful) */
+        SpacePostMetadata &metadata /*!< Overwritten with the metadata of the loaded SpacePost. Only valid if
+                                         loading was successful */
     );
 
     //! Sets the next index to 1 + (the highest index found in the configured storage directory).
@@ -218,6 +345,23 @@ namespace SpacePosts
     //! Emits telemetry message with the next index.
     U32 nextIndex();
 
+    //! Deletes the message files which fall out of the last maxStoredMessages indices once storing at the given
+    //! index has been attempted, and forgets their indices.
+    //!
+    //! Must be called after every store attempt, successful or not, because a failed store consumes its index as
+    //! well. Deletes every index from oldestRetainedIndex up to newest_index - maxStoredMessages and advances
+    //! oldestRetainedIndex to the first index whose deletion failed, if any. Does nothing if maxStoredMessages is 0.
+    //!
+    //! A file which does not exist (e.g., because storing at its index failed) is not an error. If deleting fails
+    //! otherwise, a MESSAGE_STORE_FAILED event with stage RETENTION_DELETE is triggered.
+    void removeExpiredMessages(const U32 newest_index);
+
+    //! Deletes the message file at the given index without reporting a file which does not exist.
+    //!
+    //! Returns true iff the file is gone, i.e., it was deleted or did not exist. If deleting fails otherwise, a
+    //! MESSAGE_STORE_FAILED event with stage RETENTION_DELETE is triggered and false is returned.
+    bool removeMessageFile(const U32 index);
+
     //! Puts an index into the lastSuccessfullyStoredIndices data structure to remember that a message was successfully
     //! stored at this index.
     //!
@@ -225,8 +369,34 @@ namespace SpacePosts
     //! remove the oldest index if the data structure is full).
     void addIndexToLastSuccessfullyStoredIndices(const U32 index);
 
-    //! Gets the absolute file path for storing a message when wanting to store it at the given index.
-    std::string indexToAbsoluteFilePath(const U32 index);
+    //! Loads up to num_messages of the most recently stored messages into the given batch, newest first.
+    //!
+    //! Walks the lastSuccessfullyStoredIndices data structure from the newest index backwards and skips messages
+    //! which fail to load. Skips indices greater equals before_index if only_older is true. Stops at the first index
+    //! smaller equals after_index if only_newer is true.
+    //!
+    //! Returns the number of messages loaded. If at least one message was loaded, newest_index and oldest_index
+    //! are set to the indices of the first and last message in the batch.
+    //!
+    //! The metadata of the loaded messages is left in loadedMetadata, in the order of the batch.
+    U8 loadLastMessages(
+        const U8 num_messages,                     /*!< The maximum number of messages to load */
+        const bool only_newer,                     /*!< Whether to stop at after_index */
+        const U32 after_index,                     /*!< Only load messages stored at a higher index if only_newer */
+        const bool only_older,                     /*!< Whether to skip indices from before_index on */
+        const U32 before_index,                    /*!< Only load messages stored at a lower index if only_older */
+        SpacePosts::SpacePost_Batch &lastMessages, /*!< The batch to load the messages into */
+        U32 &newest_index,                         /*!< The index of the newest loaded message */
+        U32 &oldest_index                          /*!< The index of the oldest loaded message */
+    );
+
+    //! Formats the absolute file path of the message with the given index into the given stack buffer.
+    //!
+    //! Does not allocate any memory and does not access the file system.
+    void indexToAbsoluteFilePath(
+        const U32 index,            /*!< The index of the message */
+        FilePathBuffer &filePath    /*!< The buffer to write the null-terminated path to */
+    ) const;
 
     //! Writes the given buffer to the given file.
     //!
@@ -235,14 +405,11 @@ namespace SpacePosts
     //! To be used with caution! Only supposed to be called after checks for valid open file
     //! and valid buffer serialization have been performed.
     //!
-    //! Returns regularly iff the buffer was successfully written to the file.
-    //! Otherwise, throws a MessageWriteError as exception.
+    //! Returns true iff the buffer was successfully written to the file.
     //!
     //! If the buffer was not successfully written to the file, an event of type
-    //! MessageStorage_MessageWriteError is triggered.
-    //!
-    //! The expected_write_size is asserted to be equal to the length of the passed buffer
-    void writeRawBufferToFile(
+    //! MessageStorage_MessageWriteError is triggered and false is returned.
+    bool writeRawBufferToFile(
         const void *const buffer_address,          /*!< The buffer to be written to the file */
         Os::File &file,                            /*!< The file to which the buffer should be written */
         const NATIVE_INT_TYPE write_size,          /*!< The number of bytes to read from the buffer and write to the
@@ -263,11 +430,11 @@ namespace SpacePosts
     //!
     //! To be used with caution! Only supposed to be called after checks for valid open file.
     //!
-    //! Returns regularly iff the file was successfully read into the buffer.
-    //! Otherwise, throws a MessageReadError as exception.
+    //! Returns true iff the file was successfully read into the buffer.
     //!
-    //! The given read_size is asserted to be equal to the number of bytes in fact read from the file.
-    void readRawBufferFromFile(
+    //! If reading failed or fewer bytes than read_size were read, an event of type
+    //! MessageStorage_MessageReadError is triggered and false is returned.
+    bool readRawBufferFromFile(
         void *const buffer_address,              /*!< The buffer to which to write the read file content */
         Os::File &file,                          /*!< The file from which data should be read into the buffer */
         const NATIVE_INT_TYPE read_size,         /*!< The number of bytes to read from the file and write to the
@@ -286,7 +453,9 @@ namespace SpacePosts
     //! Just calls writeRawBufferToFile() with the correct parameters. I.e., the StackBuffer's address and size.
     //!
     //! The expected_write_size is asserted to be equal to the length of the passed buffer
-    void writeSerializeBufferToFile(
+    //!
+    //! Returns true iff the buffer was successfully written to the file.
+    bool writeSerializeBufferToFile(
         Fw::SerializeBufferBase &buffer,           /*!< The buffer to be written to the file */
         Os::File &file,                            /*!< The file to which the buffer should be written */
         const NATIVE_INT_TYPE expected_write_size, /*!< The expected size to be written to the file */
@@ -305,7 +474,12 @@ namespace SpacePosts
     //! Reports a case of a non-existing directory as a STORAGE_DIRECTORY_WARNING event.
     //!
     //! Possibly, creating the directory fails. This is also reported as a STORAGE_DIRECTORY_WARNING event.
-    void createStorageDirectoryIfNotExists();
+    //!
+    //! Called upon initialization and after an I/O error only. The steady-state store path does not re-check the
+    //! directory.
+    //!
+    //! Returns true iff the directory did not exist and was successfully created.
+    bool createStorageDirectoryIfNotExists();
 
   public:
     // ----------------------------------------------------------------------
@@ -318,6 +492,20 @@ namespace SpacePosts
         const char *const compName /*!< The component name*/
     );
 
+    //! Configure the storage directory and retention of the component
+    //!
+    //! Allows multiple instances of the component to store into separate directories, e.g., a quarantine store
+    //! for the SpacePosts rejected by the Moderator next to the storage of the accepted ones. Without a call, the
+    //! component uses MESSAGESTORAGE_MSGFILE_DIRECTORY and keeps all message files.
+    //!
+    //! Must be called before init() because init() restores the index from the storage directory.
+    void configure(
+        const char *const directory,    /*!< The absolute path of the storage directory. Should end with a slash.
+                                             At most MESSAGESTORAGE_MSGFILE_DIRECTORY_MAXLENGTH characters */
+        const U32 maxStoredMessages     /*!< The number of most recent indices whose message files are kept. Older
+                                             ones are deleted when storing and upon initialization. 0 keeps all */
+    );
+
     //! Initialize object MessageStorage
     //!
     void init(
@@ -371,6 +559,57 @@ namespace SpacePosts
         U8 num_messages,                   /*!< The number of messages to load */
         SpacePosts::SpacePost_Batch &lastMessages /*!< The content of the message */
         ) override;
+
+    //! Handler implementation for storeMessages
+    //!
+    //! Stores the valid messages of the given batch at the next available indices, in order. Each message is stored
+    //! as by storeMessage_handler, except that the files are not written synchronously. Instead, all of them are
+    //! kept open and flushed one after another by syncMessageFile() before returning. A message is only reported as
+    //! OK once its file has been flushed. Other files of the storage medium are not flushed.
+    U8 storeMessages_handler(
+        const NATIVE_INT_TYPE portNum,                      /*!< The port number*/
+        const SpacePosts::SpacePost_Batch &data,            /*!< The messages to store */
+        SpacePosts::MessageStorageStatus_Batch &statuses    /*!< The status of storing each message */
+        ) override;
+
+    //! Handler implementation for loadMessageRange
+    //!
+    //! Same as loadMessageLastN_handler but skips messages stored at an index smaller equals after_index unless
+    //! include_all is true, and messages stored at an index greater equals before_index unless from_newest is true.
+    U8 loadMessageRange_handler(
+        const NATIVE_INT_TYPE portNum,             /*!< The port number*/
+        U8 num_messages,                           /*!< The maximum number of messages to load */
+        U32 after_index,                           /*!< Only load messages stored at a higher index */
+        bool include_all,                          /*!< Ignore after_index */
+        U32 before_index,                          /*!< Only load messages stored at a lower index */
+        bool from_newest,                          /*!< Ignore before_index */
+        SpacePosts::SpacePost_Batch &lastMessages, /*!< The loaded messages */
+        U32 &newest_index,                         /*!< The index of the newest loaded message */
+        U32 &oldest_index                          /*!< The index of the oldest loaded message */
+        ) override;
+
+    //! Handler implementation for loadMessageRangeWithMetadata
+    //!
+    //! Same as loadMessageRange_handler but additionally returns the metadata of the loaded messages.
+    U8 loadMessageRangeWithMetadata_handler(
+        const NATIVE_INT_TYPE portNum,             /*!< The port number*/
+        U8 num_messages,                           /*!< The maximum number of messages to load */
+        U32 after_index,                           /*!< Only load messages stored at a higher index */
+        bool include_all,                          /*!< Ignore after_index */
+        U32 before_index,                          /*!< Only load messages stored at a lower index */
+        bool from_newest,                          /*!< Ignore before_index */
+        SpacePosts::SpacePost_Batch &lastMessages, /*!< The loaded messages */
+        SpacePosts::SpacePostMetadata_Array &metadata, /*!< The metadata of the loaded messages */
+        U32 &newest_index,                         /*!< The index of the newest loaded message */
+        U32 &oldest_index                          /*!< The index of the oldest loaded message */
+        ) override;
+
+    //! Handler implementation for getStoreGeneration
+    //!
+    //! Returns the store generation, which changes with every completed attempt to store a message.
+    U32 getStoreGeneration_handler(
+        const NATIVE_INT_TYPE portNum /*!< The port number*/
+        ) override;
   };
 
 } // end namespace SpacePosts
@@ -0,0 +1,165 @@
+// ======================================================================
+// \title  MessageStorage/test/perf/StorageBenchmark.cpp
+// \author Marius Baden
+// \brief  cpp file for MessageStorage benchmark harness
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#include <chrono>
+#include <cstdio>
+
+#include "STest/Pick/Pick.hpp"
+
+#include "StorageBenchmark.hpp"
+
+#define INSTANCE 0
+#define MAX_HISTORY_SIZE 10
+
+namespace SpacePosts
+{
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  StorageBenchmark ::
+      StorageBenchmark() :
+#if FW_OBJECT_NAMES == 1
+                           MessageStorageGTestBase("StorageBenchmark", MAX_HISTORY_SIZE),
+                           component("MessageStorage")
+#else
+                           MessageStorageGTestBase(MAX_HISTORY_SIZE),
+                           component()
+#endif
+  {
+    this->connectPorts();
+  }
+
+  StorageBenchmark ::
+      ~StorageBenchmark()
+  {
+  }
+
+  // ----------------------------------------------------------------------
+  // Benchmarks
+  // ----------------------------------------------------------------------
+
+  void StorageBenchmark::setUp(const StorageDirectorySetup &directorySetup)
+  {
+    directorySetup.realizeOnFileSystem();
+    this->init();
+    this->component.init(INSTANCE);
+  }
+
+  BenchmarkResult StorageBenchmark::benchmarkStore(const U32 iterations)
+  {
+    BenchmarkResult result{"store", iterations, 0, 0.0};
+
+    // Generate messages upfront so that only the port invocation is timed
+    std::vector<SpacePost> messages{};
+    for (U32 i = 0; i < iterations; i++)
+    {
+      const SpacePostFile file{false};
+      messages.emplace_back(file.getMessageText().c_str());
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    for (const SpacePost &message : messages)
+    {
+      const MessageStorageStatus status = this->invoke_to_storeMessage(0, message);
+      result.failures += (status != MessageStorageStatus::OK);
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    result.totalNs = std::chrono::duration<double, std::nano>(end - start).count();
+    return result;
+  }
+
+  BenchmarkResult StorageBenchmark::benchmarkLoadNominal(const U32 index, const U32 iterations)
+  {
+    BenchmarkResult result{"load nominal", iterations, 0, 0.0};
+    SpacePost loaded_message{};
+
+    const auto start = std::chrono::steady_clock::now();
+    for (U32 i = 0; i < iterations; i++)
+    {
+      const SpacePostValid status = this->invoke_to_loadMessageFromIndex(0, index, loaded_message);
+      result.failures += (status != SpacePostValid::VALID);
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    result.totalNs = std::chrono::duration<double, std::nano>(end - start).count();
+    return result;
+  }
+
+  BenchmarkResult StorageBenchmark::benchmarkLoadCorrupted(const std::string &name, const U32 index,
+                                                           const U32 iterations)
+  {
+    BenchmarkResult result{"load corrupted (" + name + ")", iterations, 0, 0.0};
+    SpacePost loaded_message{};
+
+    const auto start = std::chrono::steady_clock::now();
+    for (U32 i = 0; i < iterations; i++)
+    {
+      const SpacePostValid status = this->invoke_to_loadMessageFromIndex(0, index, loaded_message);
+      result.failures += (status != SpacePostValid::INVALID);
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    result.totalNs = std::chrono::duration<double, std::nano>(end - start).count();
+    return result;
+  }
+
+  BenchmarkResult StorageBenchmark::benchmarkLoadLastN(const U8 numMessages, const U32 iterations)
+  {
+    BenchmarkResult result{"load last " + std::to_string(numMessages), iterations, 0, 0.0};
+    SpacePost_Batch loaded_batch{};
+
+    const auto start = std::chrono::steady_clock::now();
+    for (U32 i = 0; i < iterations; i++)
+    {
+      const U8 num_loaded = this->invoke_to_loadMessageLastN(0, numMessages, loaded_batch);
+      result.failures += (num_loaded != numMessages);
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    result.totalNs = std::chrono::duration<double, std::nano>(end - start).count();
+    return result;
+  }
+
+  void StorageBenchmark::print(const BenchmarkResult &result)
+  {
+    std::printf("%-40s %8u iterations %12.1f ns/op %8u unexpected results\n",
+                result.name.c_str(), result.iterations, result.nsPerOperation(), result.failures);
+  }
+
+  // ----------------------------------------------------------------------
+  // F' Tester Implementations
+  // ----------------------------------------------------------------------
+
+  void StorageBenchmark ::
+      connectPorts()
+  {
+
+    // storeMessage
+    this->connect_to_storeMessage(
+        0,
+        this->component.get_storeMessage_InputPort(0));
+
+    // loadMessageFromIndex
+    this->connect_to_loadMessageFromIndex(
+        0,
+        this->component.get_loadMessageFromIndex_InputPort(0));
+
+    // loadMessageLastN
+    this->connect_to_loadMessageLastN(
+        0,
+        this->component.get_loadMessageLastN_InputPort(0));
+  }
+
+} // end namespace SpacePosts
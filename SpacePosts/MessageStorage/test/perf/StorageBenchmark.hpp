@@ -0,0 +1,104 @@
+// ======================================================================
+// \title  MessageStorage/test/perf/StorageBenchmark.hpp
+// \author Marius Baden
+// \brief  hpp file for MessageStorage benchmark harness
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#ifndef STORAGEBENCHMARK_HPP
+#define STORAGEBENCHMARK_HPP
+
+#include <string>
+
+#include "GTestBase.hpp"
+#include "SpacePosts/MessageStorage/MessageStorage.hpp"
+#include "../ut/model/StorageDirectorySetup.hpp"
+#include "../ut/model/SpacePostFile.hpp"
+
+namespace SpacePosts
+{
+  /**
+   * @brief Result of a single benchmark run
+   */
+  struct BenchmarkResult
+  {
+    std::string name;     //!< Name of the benchmarked operation
+    U32 iterations;       //!< Number of timed port invocations
+    U32 failures;         //!< Number of invocations which did not return the expected status
+    double totalNs;       //!< Total wall-clock time of all invocations in nanoseconds
+
+    //! Average time per port invocation in nanoseconds
+    double nsPerOperation() const { return iterations == 0 ? 0.0 : totalNs / iterations; }
+  };
+
+  /**
+   * @brief Harness that measures the wall-clock time of the MessageStorage component's ports.
+   *
+   * Only the component's input ports are connected. Event and telemetry ports are left unconnected on purpose:
+   * otherwise, the growing history of the test harness would be measured instead of the component.
+   *
+   * The storage directory is prepared with the model classes of the unit tests (see ../ut/model/).
+   */
+  class StorageBenchmark : public MessageStorageGTestBase
+  {
+  private:
+    /**
+     * The component under test.
+     */
+    MessageStorage component;
+
+  public:
+    StorageBenchmark();
+
+    ~StorageBenchmark();
+
+    /**
+     * @brief Realize the given storage directory setup on the file system and initialize the component on it.
+     */
+    void setUp(const StorageDirectorySetup &directorySetup);
+
+    /**
+     * @brief Stores the given number of messages with random text at the next free indices.
+     */
+    BenchmarkResult benchmarkStore(const U32 iterations);
+
+    /**
+     * @brief Repeatedly loads a valid message file from the given index.
+     *
+     * This is the nominal path of loadMessage().
+     */
+    BenchmarkResult benchmarkLoadNominal(const U32 index, const U32 iterations);
+
+    /**
+     * @brief Repeatedly loads an invalid message file from the given index.
+     *
+     * This is the corrupted-file path of loadMessage(). The given name identifies the kind of corruption in the
+     * printed result.
+     */
+    BenchmarkResult benchmarkLoadCorrupted(const std::string &name, const U32 index, const U32 iterations);
+
+    /**
+     * @brief Repeatedly loads the last N messages via the loadMessageLastN port.
+     */
+    BenchmarkResult benchmarkLoadLastN(const U8 numMessages, const U32 iterations);
+
+    /**
+     * @brief Prints a benchmark result as one line to stdout
+     */
+    static void print(const BenchmarkResult &result);
+
+  private:
+    /**
+     * @brief F' generated method for connecting the harness to the component's input ports.
+     */
+    void connectPorts();
+  };
+
+} // end namespace SpacePosts
+
+#endif
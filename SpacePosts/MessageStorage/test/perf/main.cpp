@@ -0,0 +1,138 @@
+#include <string>
+
+#include "gtest/gtest.h"
+#include "STest/Random/Random.hpp"
+
+#include "StorageBenchmark.hpp"
+#include "../ut/model/SpacePostFile.hpp"
+#include "../ut/model/StorageDirectorySetup.hpp"
+
+using namespace SpacePosts;
+
+// Number of timed port invocations per benchmark
+constexpr const U32 ITERATIONS = 10000;
+
+// Arbitrary index of the message file the load benchmarks read from
+constexpr const U32 BENCHMARK_INDEX = 42;
+
+constexpr const U32 MAX_MSGTEXT_LENGTH = SpacePosts::FppConstant_SpacePost_MaxTextLength::SpacePost_MaxTextLength;
+
+/*
+    Store path
+*/
+
+TEST(MessageStorageBenchmark, Store)
+{
+    StorageBenchmark benchmark{};
+    benchmark.setUp(StorageDirectorySetup{true});
+
+    const BenchmarkResult result = benchmark.benchmarkStore(ITERATIONS);
+    StorageBenchmark::print(result);
+    EXPECT_EQ(result.failures, 0U);
+}
+
+/*
+    Nominal load path: valid message file
+*/
+
+TEST(MessageStorageBenchmark, LoadNominalTypicalMessage)
+{
+    StorageDirectorySetup setup{true};
+    setup.addSpacePostFile(BENCHMARK_INDEX, SpacePostFile{40, true});
+
+    StorageBenchmark benchmark{};
+    benchmark.setUp(setup);
+
+    const BenchmarkResult result = benchmark.benchmarkLoadNominal(BENCHMARK_INDEX, ITERATIONS);
+    StorageBenchmark::print(result);
+    EXPECT_EQ(result.failures, 0U);
+}
+
+TEST(MessageStorageBenchmark, LoadNominalMaxMessage)
+{
+    StorageDirectorySetup setup{true};
+    setup.addSpacePostFile(BENCHMARK_INDEX, SpacePostFile{MAX_MSGTEXT_LENGTH, false});
+
+    StorageBenchmark benchmark{};
+    benchmark.setUp(setup);
+
+    const BenchmarkResult result = benchmark.benchmarkLoadNominal(BENCHMARK_INDEX, ITERATIONS);
+    StorageBenchmark::print(result);
+    EXPECT_EQ(result.failures, 0U);
+}
+
+TEST(MessageStorageBenchmark, LoadLastNFullBatch)
+{
+    const U32 batch_size = SpacePosts::FppConstant_SpacePost_Batch_Size::SpacePost_Batch_Size;
+    StorageDirectorySetup setup{batch_size, 0, []() -> U32 { return 1; }, {}};
+
+    StorageBenchmark benchmark{};
+    benchmark.setUp(setup);
+
+    const BenchmarkResult result = benchmark.benchmarkLoadLastN(batch_size, ITERATIONS / batch_size);
+    StorageBenchmark::print(result);
+    EXPECT_EQ(result.failures, 0U);
+}
+
+/*
+    Corrupted-file load path: Every invalid file aborts loading in a different stage
+
+    Uses the same arbitrary 'Hello World' file as UT-STO-040
+*/
+
+TEST(MessageStorageBenchmark, LoadCorruptedMissingFile)
+{
+    StorageBenchmark benchmark{};
+    benchmark.setUp(StorageDirectorySetup{true});
+
+    const BenchmarkResult result = benchmark.benchmarkLoadCorrupted("missing file", BENCHMARK_INDEX, ITERATIONS);
+    StorageBenchmark::print(result);
+    EXPECT_EQ(result.failures, 0U);
+}
+
+TEST(MessageStorageBenchmark, LoadCorruptedDelimiter)
+{
+    StorageDirectorySetup setup{true};
+    setup.addSpacePostFile(BENCHMARK_INDEX, SpacePostFile{0xD8, 13, 11, "Hello World"});
+
+    StorageBenchmark benchmark{};
+    benchmark.setUp(setup);
+
+    const BenchmarkResult result = benchmark.benchmarkLoadCorrupted("delimiter", BENCHMARK_INDEX, ITERATIONS);
+    StorageBenchmark::print(result);
+    EXPECT_EQ(result.failures, 0U);
+}
+
+TEST(MessageStorageBenchmark, LoadCorruptedSerializationLength)
+{
+    StorageDirectorySetup setup{true};
+    setup.addSpacePostFile(BENCHMARK_INDEX, SpacePostFile{0xD9, 13, 11 + 1, "Hello World"});
+
+    StorageBenchmark benchmark{};
+    benchmark.setUp(setup);
+
+    const BenchmarkResult result = benchmark.benchmarkLoadCorrupted("deserialization", BENCHMARK_INDEX, ITERATIONS);
+    StorageBenchmark::print(result);
+    EXPECT_EQ(result.failures, 0U);
+}
+
+TEST(MessageStorageBenchmark, LoadCorruptedFileEnd)
+{
+    StorageDirectorySetup setup{true};
+    setup.addSpacePostFile(BENCHMARK_INDEX, SpacePostFile{0xD9, 13 - 1, 11 - 1, "Hello World"});
+
+    StorageBenchmark benchmark{};
+    benchmark.setUp(setup);
+
+    const BenchmarkResult result = benchmark.benchmarkLoadCorrupted("file end", BENCHMARK_INDEX, ITERATIONS);
+    StorageBenchmark::print(result);
+    EXPECT_EQ(result.failures, 0U);
+}
+
+// Execute benchmarks
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    STest::Random::seed();
+    return RUN_ALL_TESTS();
+}
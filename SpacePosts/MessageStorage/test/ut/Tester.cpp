@@ -32,7 +32,8 @@
 #include "model/SpacePostFile.hpp"
 
 #define INSTANCE 0
-#define MAX_HISTORY_SIZE SpacePosts::FppConstant_SpacePost_Batch_Size::SpacePost_Batch_Size
+// Large enough for the events of loading every message in the component's index history (UT-STO-080)
+#define MAX_HISTORY_SIZE MESSAGESTORAGE_STORED_INDEX_HISTORY_SIZE
 #define QUEUE_DEPTH 10
 #define TEXT_MESSAGE_LOG_SIZE 10
 
@@ -156,6 +157,178 @@ namespace SpacePosts
     this->m_directory.expectAllSpacePostFilesAreOnDiskAndAreUnchanged();
   }
 
+  void Tester::testStoreMessagesBatch(const U8 numMessages, const bool occupyMiddleIndex)
+  {
+    this->realizeDirectorySetupAndInitializeComponents();
+    const U32 first_index = this->m_directory.getNextSpacePostIndex();
+
+    // Optionally place a file at the index the middle message of the batch will be stored at
+    const U32 occupied_position = numMessages / 2;
+    const bool occupy{occupyMiddleIndex && numMessages > 0};
+    if (occupy)
+    {
+      SpacePostFile existing_file{false}; // Generates random valid file
+      this->m_directory.addSpacePostFile(first_index + occupied_position, existing_file);
+      this->m_directory.realizeOnFileSystem();
+    }
+
+    SpacePost_Array messages{};
+    for (U32 i = 0; i < numMessages; ++i)
+    {
+      messages[i] = SpacePost{STest::Pick::stringNonNull(STest::Pick::lowerUpper(
+          1, FppConstant_SpacePost_MaxTextLength::SpacePost_MaxTextLength)).c_str()};
+    }
+    const SpacePost_Batch batch{numMessages, messages};
+
+    MessageStorageStatus_Batch statuses{};
+    const U32 generation_before = this->invoke_to_getStoreGeneration(0);
+    const U8 num_stored = this->invoke_to_storeMessages(0, batch, statuses);
+
+    // Every attempt to store a message changes the store generation, including the failed one
+    ASSERT_EQ(this->invoke_to_getStoreGeneration(0) - generation_before, static_cast<U32>(numMessages));
+
+    const U32 num_stored_expected = occupy ? numMessages - 1 : numMessages;
+    ASSERT_EQ(static_cast<U32>(num_stored), num_stored_expected)
+        << "Stored " << static_cast<U32>(num_stored) << " of " << static_cast<U32>(numMessages) << " messages";
+
+    // Every message is stored at its own consecutive index, in the order of the batch
+    for (U32 i = 0; i < SpacePost_Batch_Size; ++i)
+    {
+      const bool expect_ok{i < numMessages && !(occupy && i == occupied_position)};
+      ASSERT_EQ(statuses[i].e, expect_ok ? MessageStorageStatus::OK : MessageStorageStatus::ERROR)
+          << "Unexpected status for message " << i << " of the batch";
+      if (expect_ok)
+      {
+        SpacePostFile file{};
+        file.readFromStorageDirectory(first_index + i);
+        this->expectSpacePostFileCorrectForMessage(file, batch.getmessages()[i]);
+      }
+    }
+
+    // Check events
+    ASSERT_EVENTS_SIZE(numMessages);
+    ASSERT_EVENTS_MESSAGE_STORE_COMPLETE_SIZE(num_stored_expected);
+    if (occupy)
+    {
+      ASSERT_EVENTS_MESSAGE_STORE_FAILED_SIZE(1);
+      ASSERT_EVENTS_MESSAGE_STORE_FAILED(0, first_index + occupied_position, MessageWriteError::FILE_EXISTS,
+                                         Os::File::OP_OK);
+    }
+
+    // Check telemetry: one store attempt per message
+    ASSERT_TLM_STORE_COUNT_SIZE(numMessages);
+    ASSERT_TLM_NEXT_STORAGE_INDEX_SIZE(numMessages);
+    for (U32 i = 0; i < numMessages; ++i)
+    {
+      ASSERT_TLM_STORE_COUNT(i, i + 1);
+      ASSERT_TLM_NEXT_STORAGE_INDEX(i, first_index + i + 1);
+    }
+
+    // Check that other files were not changed
+    this->m_directory.expectAllSpacePostFilesAreOnDiskAndAreUnchanged();
+  }
+
+  void Tester::testStoreWithMaxStoredMessages(const U32 maxStoredMessages)
+  {
+    this->component.configure(MESSAGESTORAGE_MSGFILE_DIRECTORY.c_str(), maxStoredMessages);
+    this->realizeDirectorySetupAndInitializeComponents();
+    const U32 first_index = this->m_directory.getNextSpacePostIndex();
+
+    SpacePost_Array messages{};
+    for (U32 i = 0; i < SpacePost_Batch_Size; ++i)
+    {
+      messages[i] = SpacePost{STest::Pick::stringNonNull(STest::Pick::lowerUpper(
+          1, FppConstant_SpacePost_MaxTextLength::SpacePost_MaxTextLength)).c_str()};
+    }
+    const SpacePost_Batch batch{SpacePost_Batch_Size, messages};
+
+    MessageStorageStatus_Batch statuses{};
+    const U8 num_stored = this->invoke_to_storeMessages(0, batch, statuses);
+    ASSERT_EQ(static_cast<U32>(num_stored), static_cast<U32>(SpacePost_Batch_Size));
+
+    // Exactly the files of the last maxStoredMessages indices are left, among the pre-existing and the new ones
+    const U32 next_index = first_index + SpacePost_Batch_Size;
+    std::vector<U32> indices = this->m_directory.getExistingSpacePostIndices();
+    for (U32 i = 0; i < SpacePost_Batch_Size; ++i)
+    {
+      indices.push_back(first_index + i);
+    }
+    for (const U32 index : indices)
+    {
+      const bool expect_kept{next_index - index <= maxStoredMessages};
+      ASSERT_EQ(spacePostFileExists(index), expect_kept)
+          << "Unexpected state of the message file at index " << index << " with next index " << next_index;
+    }
+
+    // Deleting files is no error
+    ASSERT_EVENTS_MESSAGE_STORE_FAILED_SIZE(0);
+
+    // Deleted messages are forgotten, so loading the last messages does not try to load them
+    this->clearHistory();
+    SpacePost_Batch last_messages{};
+    const U8 num_loaded = this->invoke_to_loadMessageLastN(0, SpacePost_Batch_Size, last_messages);
+    const U32 num_loaded_expected = (maxStoredMessages < SpacePost_Batch_Size) ? maxStoredMessages
+                                                                              : SpacePost_Batch_Size;
+    ASSERT_EQ(static_cast<U32>(num_loaded), num_loaded_expected);
+    ASSERT_EVENTS_MESSAGE_LOAD_FAILED_SIZE(0);
+  }
+
+  void Tester::testStoreWithMaxStoredMessagesAndFailedStore(const U32 maxStoredMessages)
+  {
+    FW_ASSERT(maxStoredMessages < SpacePost_Batch_Size, maxStoredMessages);
+    this->component.configure(MESSAGESTORAGE_MSGFILE_DIRECTORY.c_str(), maxStoredMessages);
+    this->realizeDirectorySetupAndInitializeComponents();
+    const U32 first_index = this->m_directory.getNextSpacePostIndex();
+
+    // Storing the middle message of the batch fails: a file already exists at its index
+    const U32 occupied_index = first_index + SpacePost_Batch_Size / 2;
+    SpacePostFile existing_file{false}; // Generates random valid file
+    this->m_directory.addSpacePostFile(occupied_index, existing_file);
+    this->m_directory.realizeOnFileSystem();
+
+    SpacePost_Array messages{};
+    for (U32 i = 0; i < SpacePost_Batch_Size; ++i)
+    {
+      messages[i] = SpacePost{STest::Pick::stringNonNull(STest::Pick::lowerUpper(
+          1, FppConstant_SpacePost_MaxTextLength::SpacePost_MaxTextLength)).c_str()};
+    }
+    const SpacePost_Batch batch{SpacePost_Batch_Size, messages};
+
+    MessageStorageStatus_Batch statuses{};
+    const U8 num_stored = this->invoke_to_storeMessages(0, batch, statuses);
+    ASSERT_EQ(static_cast<U32>(num_stored), static_cast<U32>(SpacePost_Batch_Size) - 1);
+
+    // Exactly the files of the last maxStoredMessages indices are left, among the pre-existing and the new ones
+    const U32 next_index = first_index + SpacePost_Batch_Size;
+    std::vector<U32> indices = this->m_directory.getExistingSpacePostIndices();
+    for (U32 i = 0; i < SpacePost_Batch_Size; ++i)
+    {
+      indices.push_back(first_index + i);
+    }
+    U32 num_files_left{0};
+    for (const U32 index : indices)
+    {
+      const bool expect_kept{next_index - index <= maxStoredMessages};
+      ASSERT_EQ(spacePostFileExists(index), expect_kept)
+          << "Unexpected state of the message file at index " << index << " with next index " << next_index;
+      num_files_left += spacePostFileExists(index) ? 1 : 0;
+    }
+    ASSERT_LE(num_files_left, maxStoredMessages);
+
+    // Only the failed store is an error. Deleting files is not
+    ASSERT_EVENTS_MESSAGE_STORE_FAILED_SIZE(1);
+    ASSERT_EVENTS_MESSAGE_STORE_FAILED(0, occupied_index, MessageWriteError::FILE_EXISTS, Os::File::OP_OK);
+
+    // The message at the occupied index was never stored, so it is not loaded even if its file is still kept
+    this->clearHistory();
+    SpacePost_Batch last_messages{};
+    const U8 num_loaded = this->invoke_to_loadMessageLastN(0, SpacePost_Batch_Size, last_messages);
+    const U32 num_loaded_expected = (next_index - occupied_index <= maxStoredMessages) ? maxStoredMessages - 1
+                                                                                       : maxStoredMessages;
+    ASSERT_EQ(static_cast<U32>(num_loaded), num_loaded_expected);
+    ASSERT_EVENTS_MESSAGE_LOAD_FAILED_SIZE(0);
+  }
+
   void Tester::testLoadFromExistingIndex(const U32 index, const U32 num_messages_loaded)
   {
     this->realizeDirectorySetupAndInitializeComponents();
@@ -281,6 +454,132 @@ namespace SpacePosts
     }
   }
 
+  void Tester::testLoadMessagesNewerThanExistingInDirectory(const U8 numMessagesToLoad, const U32 numNewerMessages,
+                                                            const bool includeAll)
+  {
+    this->realizeDirectorySetupAndInitializeComponents();
+
+    // The component only remembers the last MESSAGESTORAGE_STORED_INDEX_HISTORY_SIZE stored indices
+    std::map<U32, SpacePostFile> files_in_history = this->m_directory.getSpacePostFilesInIndexHistory();
+
+    // Choose the index after which to load: the (numNewerMessages + 1)-th most recently stored message
+    U32 after_index{0};
+    const bool all_newer{includeAll || files_in_history.size() <= numNewerMessages};
+    if (!all_newer)
+    {
+      auto after_iter = files_in_history.crbegin();
+      std::advance(after_iter, numNewerMessages);
+      after_index = after_iter->first;
+    }
+
+    // Determine expected indices in the order in which they are expected to be loaded (newest first)
+    std::vector<U32> indices_expected{};
+    for (auto iter = files_in_history.crbegin(); iter != files_in_history.crend(); ++iter)
+    {
+      if (indices_expected.size() >= numMessagesToLoad || (!all_newer && iter->first <= after_index))
+      {
+        break;
+      }
+      indices_expected.push_back(iter->first);
+    }
+
+    // Load messages from directory
+    SpacePost_Batch loaded_messages{};
+    const U32 newest_index_before{0xFFFFFFFF};
+    U32 newest_index{newest_index_before};
+    U32 oldest_index{newest_index_before};
+    const U8 num_messages_loaded =
+        this->invoke_to_loadMessageRange(0, numMessagesToLoad, after_index, includeAll, 0, true, loaded_messages,
+                                         newest_index, oldest_index);
+
+    ASSERT_EQ(static_cast<U32>(num_messages_loaded), indices_expected.size())
+        << "Loaded " << static_cast<U32>(num_messages_loaded) << " messages newer than index " << after_index
+        << " instead of " << indices_expected.size() << std::endl
+        << "Mesages in directory: " << this->m_directory.getExistingSpacePostIndices().size() << std::endl;
+    ASSERT_EQ(loaded_messages.getnumValidMessages(), num_messages_loaded);
+
+    // Newest and oldest index are only reported if a message was loaded
+    if (indices_expected.empty())
+    {
+      ASSERT_EQ(newest_index, newest_index_before);
+      ASSERT_EQ(oldest_index, newest_index_before);
+    }
+    else
+    {
+      ASSERT_EQ(newest_index, indices_expected.front());
+      ASSERT_EQ(oldest_index, indices_expected.back());
+    }
+
+    // Check that component decided to load the messages from the correct indices
+    ASSERT_EVENTS_SIZE(indices_expected.size());
+    ASSERT_EVENTS_MESSAGE_LOAD_COMPLETE_SIZE(indices_expected.size());
+    for (U32 i = 0; i < indices_expected.size(); ++i)
+    {
+      ASSERT_EVENTS_MESSAGE_LOAD_COMPLETE(i, indices_expected[i]);
+    }
+
+    ASSERT_TLM_SIZE(indices_expected.size());
+    ASSERT_TLM_LOAD_COUNT_SIZE(indices_expected.size());
+  }
+
+  void Tester::testLoadMessagesRangePagedExistingInDirectory(const U8 pageSize)
+  {
+    this->realizeDirectorySetupAndInitializeComponents();
+
+    // The component only remembers the last MESSAGESTORAGE_STORED_INDEX_HISTORY_SIZE stored indices
+    std::map<U32, SpacePostFile> files_in_history = this->m_directory.getSpacePostFilesInIndexHistory();
+
+    // Indices in the order in which they are expected to be loaded across all pages (newest first)
+    std::vector<U32> indices_expected{};
+    for (auto iter = files_in_history.crbegin(); iter != files_in_history.crend(); ++iter)
+    {
+      indices_expected.push_back(iter->first);
+    }
+
+    // Page through the storage like a caller would: every page starts below the oldest index of the previous one
+    U32 num_messages_loaded_total{0};
+    bool from_newest{true};
+    U32 before_index{0};
+    for (U32 num_pages = 0; num_pages <= indices_expected.size(); ++num_pages)
+    {
+      SpacePost_Batch page{};
+      U32 newest_index{0};
+      U32 oldest_index{before_index};
+      const U8 num_messages_loaded =
+          this->invoke_to_loadMessageRange(0, pageSize, 0, true, before_index, from_newest, page, newest_index,
+                                           oldest_index);
+      ASSERT_LE(num_messages_loaded, pageSize);
+      ASSERT_EQ(page.getnumValidMessages(), num_messages_loaded);
+
+      if (num_messages_loaded == 0)
+      {
+        // Oldest index is only reported if a message was loaded
+        ASSERT_EQ(oldest_index, before_index);
+        break;
+      }
+
+      // Every page continues exactly where the previous one stopped
+      ASSERT_LE(num_messages_loaded_total + num_messages_loaded, indices_expected.size());
+      ASSERT_EQ(newest_index, indices_expected[num_messages_loaded_total]);
+      num_messages_loaded_total += num_messages_loaded;
+      ASSERT_EQ(oldest_index, indices_expected[num_messages_loaded_total - 1]);
+
+      from_newest = false;
+      before_index = oldest_index;
+    }
+
+    // All messages in the history are loaded exactly once across all pages
+    ASSERT_EQ(num_messages_loaded_total, indices_expected.size())
+        << "Loaded " << num_messages_loaded_total << " messages in pages of " << static_cast<U32>(pageSize)
+        << " instead of " << indices_expected.size() << std::endl;
+    ASSERT_EVENTS_SIZE(indices_expected.size());
+    ASSERT_EVENTS_MESSAGE_LOAD_COMPLETE_SIZE(indices_expected.size());
+    for (U32 i = 0; i < indices_expected.size(); ++i)
+    {
+      ASSERT_EVENTS_MESSAGE_LOAD_COMPLETE(i, indices_expected[i]);
+    }
+  }
+
   void Tester::testLoadLastNMessagesGivenSpacePostFiles(const U8 numMessagesToLoad,
                                                   const std::vector<SpacePostFile> lastSpacePostFilesInStorage,
                                                   const std::vector<SpacePostFile> spacePostFilesExpectedToLoad)
@@ -294,8 +593,13 @@ namespace SpacePosts
     this->m_directory.setLastSpacePostFile(lastSpacePostFilesInStorage);
     this->realizeDirectorySetupAndInitializeComponents();
 
-    // Load the messages
-    SpacePost_Batch loaded_batch{};
+    // Load the messages into a batch that still holds the SpacePosts of a previous load
+    SpacePost_Array stale_messages{};
+    for (U32 i = 0; i < SpacePost_Batch_Size; ++i)
+    {
+      stale_messages[i] = SpacePost{"stale message of a previous load"};
+    }
+    SpacePost_Batch loaded_batch{SpacePost_Batch_Size, stale_messages};
     U8 num_messages_loaded = this->invoke_to_loadMessageLastN(0, numMessagesToLoad, loaded_batch);
 
     // Check that the correct number of messages was loaded
@@ -312,6 +616,13 @@ namespace SpacePosts
       this->expectSpacePostFileCorrectForMessage(spacePostFilesExpectedToLoad[i], loaded_batch.getmessages()[i]);
     }
 
+    // Check that no stale or partially loaded message remains behind the loaded ones
+    for (U32 i = spacePostFilesExpectedToLoad.size(); i < SpacePost_Batch_Size; i++)
+    {
+      ASSERT_STREQ(loaded_batch.getmessages()[i].getmessage_content().toChar(), "")
+          << "Unused entry " << i << " of the returned batch is not empty";
+    }
+
     // Determine how many operations succeded and failed
     const U32 num_loads_success_expected = spacePostFilesExpectedToLoad.size();
     const U32 num_loads_failed_expected = lastSpacePostFilesInStorage.size() - spacePostFilesExpectedToLoad.size();
@@ -332,6 +643,82 @@ namespace SpacePosts
     }
   }
 
+  void Tester::testStoreMessageMetadata(const U32 storeTimeSeconds, const U32 storeTimeMicroseconds)
+  {
+    this->realizeDirectorySetupAndInitializeComponents();
+    const U32 expected_index = this->m_directory.getNextSpacePostIndex();
+    this->setTestTime(Fw::Time(TB_NONE, storeTimeSeconds, storeTimeMicroseconds));
+
+    const SpacePostFile test_file{false}; // Generates random valid file
+    const SpacePost message_to_store{test_file.getMessageText().c_str()};
+    const MessageStorageStatus status = this->invoke_to_storeMessage(0, message_to_store);
+    ASSERT_EQ(status.e, MessageStorageStatus::OK) << "Failed to store message: " << test_file.getMessageText();
+
+    // Check the metadata in the stored file. Its checksum is checked by expectIsValid()
+    SpacePostFile file{};
+    file.readFromStorageDirectory(expected_index);
+    this->expectSpacePostFileCorrectForMessage(file, message_to_store);
+    ASSERT_TRUE(file.hasStoreMetaData()) << "Stored file " << file << " holds no metadata";
+    EXPECT_EQ(file.getStorageIndexMetaData(), expected_index);
+    EXPECT_EQ(file.getStoreTimeSecondsMetaData(), storeTimeSeconds);
+    EXPECT_EQ(file.getStoreTimeMicrosecondsMetaData(), storeTimeMicroseconds);
+
+    // Check that loading returns the same metadata and clears the entries beyond it, whatever they held before
+    SpacePost_Batch loaded_batch{};
+    SpacePostMetadata_Array metadata{};
+    for (U8 i = 0; i < SpacePost_Batch_Size; ++i)
+    {
+      metadata[i] = SpacePostMetadata{1, 2, 3, 4};
+    }
+    U32 newest_index{0};
+    U32 oldest_index{0};
+    const U8 num_messages_loaded = this->invoke_to_loadMessageRangeWithMetadata(
+        0, 1, 0, true, 0, true, loaded_batch, metadata, newest_index, oldest_index);
+
+    ASSERT_EQ(static_cast<U32>(num_messages_loaded), 1U);
+    ASSERT_EQ(newest_index, expected_index);
+    this->expectSpacePostFileCorrectForMessage(file, loaded_batch.getmessages()[0]);
+    EXPECT_EQ(metadata[0].getstorageIndex(), expected_index);
+    EXPECT_EQ(metadata[0].getstoreTimeSeconds(), storeTimeSeconds);
+    EXPECT_EQ(metadata[0].getstoreTimeMicroseconds(), storeTimeMicroseconds);
+    EXPECT_EQ(metadata[0].getchecksum(), file.computeChecksum());
+    for (U8 i = 1; i < SpacePost_Batch_Size; ++i)
+    {
+      EXPECT_EQ(metadata[i].getstorageIndex(), 0U) << "Metadata not cleared at position " << static_cast<U32>(i);
+      EXPECT_EQ(metadata[i].getstoreTimeSeconds(), 0U);
+      EXPECT_EQ(metadata[i].getstoreTimeMicroseconds(), 0U);
+      EXPECT_EQ(metadata[i].getchecksum(), 0U);
+    }
+  }
+
+  void Tester::testLoadMetadataOfFilesWithoutMetadata()
+  {
+    this->realizeDirectorySetupAndInitializeComponents();
+    const std::map<U32, SpacePostFile> files_expected = this->m_directory.getLastNSpacePostFiles(SpacePost_Batch_Size);
+
+    SpacePost_Batch loaded_batch{};
+    SpacePostMetadata_Array metadata{};
+    U32 newest_index{0};
+    U32 oldest_index{0};
+    const U8 num_messages_loaded = this->invoke_to_loadMessageRangeWithMetadata(
+        0, SpacePost_Batch_Size, 0, true, 0, true, loaded_batch, metadata, newest_index, oldest_index);
+
+    ASSERT_EQ(static_cast<U32>(num_messages_loaded), files_expected.size());
+
+    // Newest first, i.e., in descending order of the indices
+    U32 position{0};
+    for (auto iterator = files_expected.crbegin(); iterator != files_expected.crend(); ++iterator, ++position)
+    {
+      const SpacePostFile &file = iterator->second;
+      ASSERT_FALSE(file.hasStoreMetaData()) << "Generated file " << file << " unexpectedly holds metadata";
+      this->expectSpacePostFileCorrectForMessage(file, loaded_batch.getmessages()[position]);
+      EXPECT_EQ(metadata[position].getstorageIndex(), iterator->first);
+      EXPECT_EQ(metadata[position].getstoreTimeSeconds(), 0U);
+      EXPECT_EQ(metadata[position].getstoreTimeMicroseconds(), 0U);
+      EXPECT_EQ(metadata[position].getchecksum(), file.computeChecksum());
+    }
+  }
+
   void Tester::testStoreFileCreateFails()
   {
     this->realizeDirectorySetupAndInitializeComponents();
@@ -403,10 +790,49 @@ namespace SpacePosts
     this->testComponentFunctional();
   }
 
+  void Tester::testStoreDirRemovedAfterInit()
+  {
+    this->realizeDirectorySetupAndInitializeComponents();
+    const U32 expected_index = this->m_directory.getNextSpacePostIndex();
+
+    // Remove the storage directory behind the component's back
+    const StorageDirectorySetup removed_directory{false};
+    removed_directory.realizeOnFileSystem();
+
+    // Try to store a message
+    const SpacePost message_to_store{"Test message"}; // Message text does not matter
+    MessageStorageStatus status = this->invoke_to_storeMessage(0, message_to_store);
+
+    ASSERT_EQ(status.e, MessageStorageStatus::OK)
+        << "Storing a message should have succeeded after the component re-created the storage directory";
+
+    // Check events: Directory was re-created, no store failure reported
+    ASSERT_EVENTS_SIZE(2);
+    ASSERT_EVENTS_STORAGE_DIRECTORY_WARNING_SIZE(1);
+    ASSERT_EVENTS_STORAGE_DIRECTORY_WARNING(0, MESSAGESTORAGE_MSGFILE_DIRECTORY.c_str(), true);
+    ASSERT_EVENTS_MESSAGE_STORE_COMPLETE_SIZE(1);
+    ASSERT_EVENTS_MESSAGE_STORE_COMPLETE(0, expected_index);
+
+    // Check stored file for correctness
+    SpacePostFile file{};
+    file.readFromStorageDirectory(expected_index);
+    this->expectSpacePostFileCorrectForMessage(file, message_to_store);
+
+    // Check that component is still functional
+    this->testComponentFunctional();
+  }
+
   // ----------------------------------------------------------------------
   // Helper methods
   // ----------------------------------------------------------------------
 
+  bool Tester::spacePostFileExists(const U32 index)
+  {
+    const std::ifstream file{MESSAGESTORAGE_MSGFILE_DIRECTORY + std::to_string(index) +
+                             MESSAGESTORAGE_MSGFILE_FILE_EXTENSION};
+    return file.good();
+  }
+
   void Tester::testComponentFunctional()
   {
     /* Test storing */
@@ -530,6 +956,11 @@ namespace SpacePosts
         0,
         this->component.get_storeMessage_InputPort(0));
 
+    // storeMessages
+    this->connect_to_storeMessages(
+        0,
+        this->component.get_storeMessages_InputPort(0));
+
     // loadMessageFromIndex
     this->connect_to_loadMessageFromIndex(
         0,
@@ -540,6 +971,21 @@ namespace SpacePosts
         0,
         this->component.get_loadMessageLastN_InputPort(0));
 
+    // loadMessageRange
+    this->connect_to_loadMessageRange(
+        0,
+        this->component.get_loadMessageRange_InputPort(0));
+
+    // loadMessageRangeWithMetadata
+    this->connect_to_loadMessageRangeWithMetadata(
+        0,
+        this->component.get_loadMessageRangeWithMetadata_InputPort(0));
+
+    // getStoreGeneration
+    this->connect_to_getStoreGeneration(
+        0,
+        this->component.get_getStoreGeneration_InputPort(0));
+
     // eventOut
     this->component.set_eventOut_OutputPort(
         0,
@@ -220,6 +220,102 @@ namespace SpacePosts
                                             const std::vector<SpacePostFile> lastSpacePostFilesInStorage,
                                             const std::vector<SpacePostFile> spacePostFilesExpectedToLoad);
 
+    /*
+        UT-STO-070
+        Test loading the last N messages which are newer than a given index
+    */
+
+    /**
+     * @brief Lets the component load the last N messages stored at an index higher than a given index and checks
+     *        whether the returned messages and the returned newest index are the expected ones.
+     *
+     * The given index is chosen relative to the messages in the storage directory: it is the index of the
+     * (numNewerMessages + 1)-th most recently stored message. If the directory holds fewer messages, all messages
+     * are expected to be newer.
+     *
+     * @param numMessagesToLoad The number of messages to tell the component to load at most
+     * @param numNewerMessages The number of most recently stored messages which are newer than the given index
+     * @param includeAll Whether to tell the component to ignore the given index
+     */
+    void testLoadMessagesNewerThanExistingInDirectory(const U8 numMessagesToLoad, const U32 numNewerMessages,
+                                                      const bool includeAll);
+
+    /**
+     * @brief UT-STO-080
+     *        Test whether paging through the stored messages with an upper index bound loads every message in the
+     *        component's index history exactly once, newest first.
+     *
+     * Every page is requested below the oldest index reported for the previous page until no message is loaded.
+     *
+     * @param pageSize The number of messages to tell the component to load at most per page
+     */
+    void testLoadMessagesRangePagedExistingInDirectory(const U8 pageSize);
+
+    /**
+     * @brief UT-STO-090
+     *        Lets the component store a batch of messages and checks whether every message was stored in a correctly
+     *        formatted message file at consecutive indices, in the order of the batch, with the correct status.
+     *        Also checks that every message of the batch changes the store generation.
+     *
+     * @param numMessages The number of valid messages in the batch
+     * @param occupyMiddleIndex Whether to place a file at the index of the middle message beforehand. Storing that
+     *                          message is then expected to fail without affecting the others.
+     */
+    void testStoreMessagesBatch(const U8 numMessages, const bool occupyMiddleIndex);
+
+    /**
+     * @brief UT-STO-100
+     *        Configures the component to keep a maximum number of stored messages, lets it store a full batch of
+     *        messages, and checks whether exactly the message files of the last maxStoredMessages indices are left.
+     *
+     * The files which already fell out of the retention upon initialization are expected to be deleted then, the
+     * others while the batch is stored. The deleted messages are expected not to be loaded anymore.
+     *
+     * @param maxStoredMessages The number of most recent indices whose message files the component keeps
+     */
+    void testStoreWithMaxStoredMessages(const U32 maxStoredMessages);
+
+    /**
+     * @brief UT-STO-100
+     *        Same as testStoreWithMaxStoredMessages() but storing the middle message of the batch fails because a
+     *        file already exists at its index.
+     *
+     * The failed store consumes its index as well. Thus, the file which falls out of the retention with it is
+     * expected to be deleted nevertheless, so that the number of message files never exceeds the maximum.
+     *
+     * @param maxStoredMessages The number of most recent indices whose message files the component keeps. Must be
+     *                          smaller than the batch size
+     */
+    void testStoreWithMaxStoredMessagesAndFailedStore(const U32 maxStoredMessages);
+
+    /*
+        UT-STO-140
+        Test the metadata the component assigns to stored messages and returns together with loaded ones
+    */
+
+    /**
+     * @brief UT-STO-140
+     *        Lets the component store a message at the given time and checks the metadata in the stored file and the
+     *        metadata returned by the loadMessageRangeWithMetadata port.
+     *
+     * The metadata is expected to hold the storage index, the given time, and the CRC-32 of the serialized message.
+     * The entries of the metadata array beyond the loaded message are expected to be cleared to zero.
+     *
+     * @param storeTimeSeconds The seconds of the time at which the message is stored
+     * @param storeTimeMicroseconds The microseconds of the time at which the message is stored
+     */
+    void testStoreMessageMetadata(const U32 storeTimeSeconds, const U32 storeTimeMicroseconds);
+
+    /**
+     * @brief UT-STO-140
+     *        Loads the last messages of the storage directory, which have been stored without metadata, through the
+     *        loadMessageRangeWithMetadata port and checks the metadata derived for them.
+     *
+     * The metadata is expected to hold the index of the file, the CRC-32 of the serialized message, and a store time
+     * of 0.
+     */
+    void testLoadMetadataOfFilesWithoutMetadata();
+
     /*
         U-STO-110
         Test fail but no crash if no new message file can be created when trying to store a message
@@ -244,6 +340,21 @@ namespace SpacePosts
      */
     void testStoreFileExists();
 
+    /*
+        U-STO-130
+        Test recovery if the storage directory is removed after initialization
+    */
+
+    /**
+     * @brief Removes the storage directory after the component has been initialized, lets the component store a
+     * message, and checks whether the component re-creates the directory and stores the message.
+     *
+     * The component only re-validates the storage directory after an I/O error. Thus, it is expected to report
+     * the missing directory via a STORAGE_DIRECTORY_WARNING event and then store the message at the next index
+     * without reporting a MESSAGE_STORE_FAILED event.
+     */
+    void testStoreDirRemovedAfterInit();
+
   private:
     // ----------------------------------------------------------------------
     // Helper Methods
@@ -258,6 +369,14 @@ namespace SpacePosts
      */
     void testComponentFunctional();
 
+    /**
+     * @brief Checks whether a message file exists in the storage directory at the given index
+     *
+     * @param index The index of the message file
+     * @return true iff the file exists
+     */
+    static bool spacePostFileExists(const U32 index);
+
     /**
      * @brief Assert that aSpacePostFile is exactly the file which the component is expected to write to the storage
      * when storing the given message.
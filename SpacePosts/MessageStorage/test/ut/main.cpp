@@ -117,6 +117,13 @@ TEST_P(StorageStateProviderCompact, TestLoadFromIndexNominalMaxMessageSize)
     tester.testLoadValidSpacePostFileFromIndex(42,SpacePostFile{MAX_MSGTEXT_LENGTH, false});
 }
 
+TEST_P(StorageStateProviderCompact, TestLoadFromIndexNominalWithStoreMetadata)
+{
+    SpacePostFile file{STest::Pick::lowerUpper(2, MAX_MSGTEXT_LENGTH - 1), false};
+    file.setStoreMetaData(7, 1700000000, 250000, file.computeChecksum());
+    tester.testLoadValidSpacePostFileFromIndex(7, file);
+}
+
 // --- Tests with invalid files ---
 //
 // They use a litte piece of white box knowledge to know the expected error code.
@@ -258,6 +265,16 @@ TEST_P(StorageStateProviderCompact, TestLoadFromIndexErrorInvalidMessageLengthAn
                                            0);
 }
 
+TEST_P(StorageStateProviderCompact, TestLoadFromIndexErrorChecksumMismatch)
+{
+    // A flipped bit anywhere in the message content is detected by the checksum
+    const U32 index = directorySetup.getRandomFreeIndex();
+    SpacePostFile file{0xD9, 13, 11, "Hello World"};
+    const U32 checksum = file.computeChecksum();
+    file.setStoreMetaData(index, 1700000000, 0, checksum ^ 0x1);
+    tester.testLoadInvalidSpacePostFileFromIndex(index, file, MessageReadError::CHECKSUM, static_cast<I32>(checksum));
+}
+
 /*
     UT-STO-050
     Test whether loading last N messages selects the most recently stored messages based on different numbers for N
@@ -398,6 +415,147 @@ TEST_P(StorageStateProviderCompact, TestLoadLastNLoadsCorrectMessageContentNomin
         std::vector<SpacePostFile>{B, E, G});
 }
 
+/*
+    UT-STO-070
+    Test whether loading messages newer than a given index only selects the most recently stored messages with a
+    higher index
+
+    The given index is varied relative to the indices existing in the directory. The directorySetups provide
+    different numbers of message files.
+*/
+
+TEST_P(StorageStateProviderCompact, TestLoadNewerThanNominalIncludeAll)
+{
+    tester.testLoadMessagesNewerThanExistingInDirectory(MAX_MSGBATCH_SIZE, 0, true);
+}
+
+TEST_P(StorageStateProviderCompact, TestLoadNewerThanNominalNewest)
+{
+    tester.testLoadMessagesNewerThanExistingInDirectory(MAX_MSGBATCH_SIZE, 0, false);
+}
+
+TEST_P(StorageStateProviderCompact, TestLoadNewerThanNominalSecondNewest)
+{
+    tester.testLoadMessagesNewerThanExistingInDirectory(MAX_MSGBATCH_SIZE, 1, false);
+}
+
+TEST_P(StorageStateProviderCompact, TestLoadNewerThanNominalHalf)
+{
+    tester.testLoadMessagesNewerThanExistingInDirectory(MAX_MSGBATCH_SIZE, MAX_MSGBATCH_SIZE / 2, false);
+}
+
+TEST_P(StorageStateProviderCompact, TestLoadNewerThanNominalHalfLimitedN)
+{
+    tester.testLoadMessagesNewerThanExistingInDirectory(MAX_MSGBATCH_SIZE / 4, MAX_MSGBATCH_SIZE / 2, false);
+}
+
+TEST_P(StorageStateProviderCompact, TestLoadNewerThanNominalOldest)
+{
+    tester.testLoadMessagesNewerThanExistingInDirectory(MAX_MSGBATCH_SIZE, MAX_MSGBATCH_SIZE - 1, false);
+}
+
+/*
+    UT-STO-080
+    Test whether paging through the stored messages with an upper index bound loads every message in the index
+    history exactly once
+
+    The page size is varied. The directorySetups provide different numbers of message files, including more than
+    fit into the index history.
+*/
+
+TEST_P(StorageStateProviderCompact, TestLoadRangePagedFullBatch)
+{
+    tester.testLoadMessagesRangePagedExistingInDirectory(MAX_MSGBATCH_SIZE);
+}
+
+TEST_P(StorageStateProviderCompact, TestLoadRangePagedSmallPages)
+{
+    tester.testLoadMessagesRangePagedExistingInDirectory(7);
+}
+
+TEST_P(StorageStateProviderCompact, TestLoadRangePagedSingleMessage)
+{
+    tester.testLoadMessagesRangePagedExistingInDirectory(1);
+}
+
+/*
+    UT-STO-090
+    Test storing a batch of messages based on the number of messages in the batch and on whether storing one of them
+    fails
+*/
+
+TEST_P(StorageStateProviderCompact, TestStoreBatchNominalEmpty)
+{
+    tester.testStoreMessagesBatch(0, false);
+}
+
+TEST_P(StorageStateProviderCompact, TestStoreBatchNominalSingle)
+{
+    tester.testStoreMessagesBatch(1, false);
+}
+
+TEST_P(StorageStateProviderCompact, TestStoreBatchNominalFull)
+{
+    tester.testStoreMessagesBatch(MAX_MSGBATCH_SIZE, false);
+}
+
+TEST_P(StorageStateProviderCompact, TestStoreBatchErrorFileExists)
+{
+    tester.testStoreMessagesBatch(MAX_MSGBATCH_SIZE, true);
+}
+
+/*
+    UT-STO-100
+    Test whether storing with a configured maximum number of stored messages deletes exactly the message files
+    which fall out of it
+*/
+
+TEST_P(StorageStateProviderCompact, TestStoreMaxStoredMessagesOne)
+{
+    tester.testStoreWithMaxStoredMessages(1);
+}
+
+TEST_P(StorageStateProviderCompact, TestStoreMaxStoredMessagesBatchSize)
+{
+    tester.testStoreWithMaxStoredMessages(MAX_MSGBATCH_SIZE);
+}
+
+TEST_P(StorageStateProviderCompact, TestStoreMaxStoredMessagesLarge)
+{
+    tester.testStoreWithMaxStoredMessages(2000);
+}
+
+TEST_P(StorageStateProviderCompact, TestStoreMaxStoredMessagesOneWithFailedStore)
+{
+    tester.testStoreWithMaxStoredMessagesAndFailedStore(1);
+}
+
+TEST_P(StorageStateProviderCompact, TestStoreMaxStoredMessagesWithFailedStoreInRetention)
+{
+    // The failed index is still within the last maxStoredMessages indices when the batch is done
+    tester.testStoreWithMaxStoredMessagesAndFailedStore(MAX_MSGBATCH_SIZE / 2 + 1);
+}
+
+/*
+    UT-STO-140
+    Test the metadata the component assigns to stored messages and returns together with loaded ones
+*/
+
+TEST_P(StorageStateProviderCompact, TestStoreMetadataNominal)
+{
+    tester.testStoreMessageMetadata(1700000000, 123456);
+}
+
+TEST_P(StorageStateProviderCompact, TestStoreMetadataZeroTime)
+{
+    tester.testStoreMessageMetadata(0, 0);
+}
+
+TEST_P(StorageStateProviderCompact, TestLoadMetadataOfFilesWithoutMetadata)
+{
+    tester.testLoadMetadataOfFilesWithoutMetadata();
+}
+
 /*
 
     ---- White-Box Tests ----
@@ -431,6 +589,18 @@ TEST_P(StorageStateProviderDetailed, TestStoreErrorFileExists)
     this->tester.testStoreFileExists();
 }
 
+/*
+    UT-STO-130
+    Test recovery if the storage directory is removed after initialization
+
+    The storage directory state is the only parameter: Same as for UT-STO-110.
+*/
+
+TEST_P(StorageStateProviderDetailed, TestStoreErrorDirRemovedAfterInit)
+{
+    this->tester.testStoreDirRemovedAfterInit();
+}
+
 /*
     Instantiate and Execute
 */
@@ -29,8 +29,8 @@ SpacePosts::SpacePostFile::SpacePostFile(const U32 textLength, const bool alphaN
     }
     FW_ASSERT(m_messageText.size() == textLength, m_messageText.size(), textLength);
 
-    // Set meta data
-    m_delimiterMetaData = MESSAGESTORAGE_MSGFILE_DELIMITER;
+    // Set meta data. Generated files are stored without store metadata, see setStoreMetaData()
+    m_delimiterMetaData = MESSAGESTORAGE_MSGFILE_DELIMITER_NO_METADATA;
     m_serializationLengthMetaData = m_messageText.size();
     m_messageLengthMetaData = m_serializationLengthMetaData + 2; // Fw::String.serialize() adds 2 bytes for its own size meta data
 }
@@ -44,16 +44,64 @@ SpacePosts::SpacePostFile::SpacePostFile(const U8 delimiterMetaData, const U32 m
 
 bool SpacePosts::SpacePostFile::operator==(constSpacePostFile &other) const
 {
+    const bool store_meta_data_equal = !this->hasStoreMetaData() ||
+                                       ((this->m_storageIndexMetaData == other.m_storageIndexMetaData) &&
+                                        (this->m_storeTimeSecondsMetaData == other.m_storeTimeSecondsMetaData) &&
+                                        (this->m_storeTimeMicrosecondsMetaData == other.m_storeTimeMicrosecondsMetaData) &&
+                                        (this->m_checksumMetaData == other.m_checksumMetaData));
     return (this->m_delimiterMetaData == other.m_delimiterMetaData) &&
            (this->m_messageLengthMetaData == other.m_messageLengthMetaData) &&
            (this->m_messageText == other.m_messageText) &&
-           (this->m_serializationLengthMetaData == other.m_serializationLengthMetaData);
+           (this->m_serializationLengthMetaData == other.m_serializationLengthMetaData) &&
+           store_meta_data_equal;
+}
+
+bool SpacePosts::SpacePostFile::hasStoreMetaData() const
+{
+    return m_delimiterMetaData == MESSAGESTORAGE_MSGFILE_DELIMITER;
+}
+
+void SpacePosts::SpacePostFile::setStoreMetaData(const U32 storageIndex, const U32 storeTimeSeconds,
+                                                 const U32 storeTimeMicroseconds, const U32 checksum)
+{
+    m_delimiterMetaData = MESSAGESTORAGE_MSGFILE_DELIMITER;
+    m_storageIndexMetaData = storageIndex;
+    m_storeTimeSecondsMetaData = storeTimeSeconds;
+    m_storeTimeMicrosecondsMetaData = storeTimeMicroseconds;
+    m_checksumMetaData = checksum;
+}
+
+U32 SpacePosts::SpacePostFile::computeChecksum() const
+{
+    // Encoded message text: Fw::String.serialize()'s size meta data followed by the text
+    std::string encoded{};
+    encoded += static_cast<char>(m_serializationLengthMetaData >> 8);
+    encoded += static_cast<char>(m_serializationLengthMetaData);
+    encoded += m_messageText;
+
+    // Bitwise CRC-32 (reflected polynomial 0xEDB88320)
+    U32 crc = 0xFFFFFFFF;
+    for (const char character : encoded)
+    {
+        crc ^= static_cast<U8>(character);
+        for (U32 bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+        }
+    }
+    return ~crc;
 }
 
 void SpacePosts::SpacePostFile::expectIsValid() const
 {
-    EXPECT_EQ(m_delimiterMetaData, MESSAGESTORAGE_MSGFILE_DELIMITER)
+    EXPECT_TRUE(m_delimiterMetaData == MESSAGESTORAGE_MSGFILE_DELIMITER ||
+                m_delimiterMetaData == MESSAGESTORAGE_MSGFILE_DELIMITER_NO_METADATA)
         << "SpacePostFile is invalid: Delimiter Meta Data is not correct";
+    if (this->hasStoreMetaData())
+    {
+        EXPECT_EQ(m_checksumMetaData, this->computeChecksum())
+            << "SpacePostFile is invalid: Checksum Meta Data is not correct";
+    }
     EXPECT_EQ(m_messageLengthMetaData, m_messageText.size() + 2)
         << "SpacePostFile is invalid: Message Length Meta Data is not correct";
     EXPECT_EQ(m_serializationLengthMetaData, m_messageText.size())
@@ -76,6 +124,19 @@ void SpacePosts::SpacePostFile::writeToStorageDirectory(const U32 index) const
     file.put(m_messageLengthMetaData >> 8);
     file.put(m_messageLengthMetaData);
 
+    // Write store metadata in the same order
+    if (this->hasStoreMetaData())
+    {
+        for (const U32 value : {m_storageIndexMetaData, m_storeTimeSecondsMetaData, m_storeTimeMicrosecondsMetaData,
+                                m_checksumMetaData})
+        {
+            file.put(value >> 24);
+            file.put(value >> 16);
+            file.put(value >> 8);
+            file.put(value);
+        }
+    }
+
     // Write Fw::String.serialize()'s size meta data in little-endian order
     file.put(m_serializationLengthMetaData >> 8);
     file.put(m_serializationLengthMetaData);
@@ -104,6 +165,20 @@ void SpacePosts::SpacePostFile::readFromStorageDirectory(const U32 index)
     this->m_messageLengthMetaData |= file.get() << 8;
     this->m_messageLengthMetaData |= file.get();
 
+    // Read store metadata in the same order
+    if (this->hasStoreMetaData())
+    {
+        for (U32 *const value : {&m_storageIndexMetaData, &m_storeTimeSecondsMetaData,
+                                 &m_storeTimeMicrosecondsMetaData, &m_checksumMetaData})
+        {
+            *value = 0;
+            *value |= file.get() << 24;
+            *value |= file.get() << 16;
+            *value |= file.get() << 8;
+            *value |= file.get();
+        }
+    }
+
     // Read Fw::String.serialize()'s size meta data in little-endian order
     // Fw::String.serialize() adds 2 bytes for its own size meta data
     this->m_serializationLengthMetaData = 0;
@@ -128,5 +203,12 @@ std::ostream &SpacePosts::operator<<(std::ostream &os, constSpacePostFile &space
               << std::dec << std::noshowbase  
               << spacePostFile.getMessageLengthMetaData() << ", " 
               << spacePostFile.getSerializationLengthMetaData() << ", " 
-              << "\"" << spacePostFile.getMessageText() << "\")";
+              << "\"" << spacePostFile.getMessageText() << "\""
+              << (spacePostFile.hasStoreMetaData()
+                      ? ", " + std::to_string(spacePostFile.getStorageIndexMetaData()) + ", " +
+                            std::to_string(spacePostFile.getStoreTimeSecondsMetaData()) + "." +
+                            std::to_string(spacePostFile.getStoreTimeMicrosecondsMetaData()) + ", " +
+                            std::to_string(spacePostFile.getChecksumMetaData())
+                      : std::string{})
+              << ")";
 }
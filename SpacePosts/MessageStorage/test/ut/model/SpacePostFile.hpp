@@ -15,9 +15,13 @@ namespace SpacePosts
      * Consists of a delimiter, the length of the message text, and the message text itself.
      *
      * ASpacePostFile is considered to be valid iff it adheres to the component's storage format:
-     * - The first byte is the delimiter byte (MESSAGESTORAGE_MSGFILE_DELIMITER)
+     * - The first byte is the delimiter byte (MESSAGESTORAGE_MSGFILE_DELIMITER, or
+     *   MESSAGESTORAGE_MSGFILE_DELIMITER_NO_METADATA for a file stored without metadata)
      * - The second to fifth byte are the length of the message text as a 32-bit unsigned integer in little-endian byte
      *   order
+     * - Only with MESSAGESTORAGE_MSGFILE_DELIMITER: the store metadata as four 32-bit unsigned integers in the same
+     *   byte order (storage index, store time seconds, store time microseconds, checksum). The checksum is the CRC-32
+     *   of the encoded message text
      * - The rest of the bytes are the message text encoded as specified by Fw::String.serialize()
      *
      * This class uses white-box knowledge of the MessageStorage component as the storage format of the
@@ -45,6 +49,14 @@ namespace SpacePosts
          */
         U16 m_serializationLengthMetaData;
 
+        /**
+         * The store metadata of the file. Only part of the file if the delimiter is MESSAGESTORAGE_MSGFILE_DELIMITER.
+         */
+        U32 m_storageIndexMetaData{0};
+        U32 m_storeTimeSecondsMetaData{0};
+        U32 m_storeTimeMicrosecondsMetaData{0};
+        U32 m_checksumMetaData{0};
+
     public:
         /**
          * @brief Default constructor for an uninitializedSpacePostFile.
@@ -135,6 +147,47 @@ namespace SpacePosts
          */
         U16 getSerializationLengthMetaData() const { return m_serializationLengthMetaData; }
 
+        /**
+         * @brief Whether this file holds store metadata, i.e., its delimiter is MESSAGESTORAGE_MSGFILE_DELIMITER
+         */
+        bool hasStoreMetaData() const;
+
+        /**
+         * @brief Get the storage index of the store metadata. Only meaningful if hasStoreMetaData()
+         */
+        U32 getStorageIndexMetaData() const { return m_storageIndexMetaData; }
+
+        /**
+         * @brief Get the seconds of the store time of the store metadata. Only meaningful if hasStoreMetaData()
+         */
+        U32 getStoreTimeSecondsMetaData() const { return m_storeTimeSecondsMetaData; }
+
+        /**
+         * @brief Get the microseconds of the store time of the store metadata. Only meaningful if hasStoreMetaData()
+         */
+        U32 getStoreTimeMicrosecondsMetaData() const { return m_storeTimeMicrosecondsMetaData; }
+
+        /**
+         * @brief Get the checksum of the store metadata. Only meaningful if hasStoreMetaData()
+         */
+        U32 getChecksumMetaData() const { return m_checksumMetaData; }
+
+        /**
+         * @brief Turns this file into one with store metadata by setting the delimiter to
+         * MESSAGESTORAGE_MSGFILE_DELIMITER and the store metadata to the given values.
+         *
+         * Use computeChecksum() for the checksum of a valid file.
+         */
+        void setStoreMetaData(const U32 storageIndex, const U32 storeTimeSeconds, const U32 storeTimeMicroseconds,
+                              const U32 checksum);
+
+        /**
+         * @brief Computes the CRC-32 of the encoded message text, i.e., the checksum a valid file holds.
+         *
+         * Independent of the component's implementation, so that it serves as an oracle for the stored checksums.
+         */
+        U32 computeChecksum() const;
+
         /**
          * @brief Asserts that thisSpacePostFile is valid.
          *
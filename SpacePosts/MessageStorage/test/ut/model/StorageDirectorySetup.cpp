@@ -40,15 +40,24 @@ namespace SpacePosts
     }
 
     std::map<U32,SpacePostFile> StorageDirectorySetup::getLastNSpacePostFiles(const U32 num_files_to_get) const
+    {
+        return this->getHighestIndexedSpacePostFiles(std::min(
+            num_files_to_get, static_cast<U32>(SpacePosts::FppConstant_SpacePost_Batch_Size::SpacePost_Batch_Size)));
+    }
+
+    std::map<U32,SpacePostFile> StorageDirectorySetup::getSpacePostFilesInIndexHistory() const
+    {
+        return this->getHighestIndexedSpacePostFiles(MESSAGESTORAGE_STORED_INDEX_HISTORY_SIZE);
+    }
+
+    std::map<U32,SpacePostFile> StorageDirectorySetup::getHighestIndexedSpacePostFiles(const U32 num_files_to_get) const
     {
         std::map<U32,SpacePostFile> last_n_files;
         std::vector<U32> existingIndices = this->getExistingSpacePostIndices();
         std::sort(existingIndices.begin(), existingIndices.end());
         std::reverse(existingIndices.begin(), existingIndices.end());
 
-        const U32 num_files = std::min(
-            std::min(num_files_to_get, static_cast<U32>(existingIndices.size())),
-            static_cast<U32>(SpacePosts::FppConstant_SpacePost_Batch_Size::SpacePost_Batch_Size));
+        const U32 num_files = std::min(num_files_to_get, static_cast<U32>(existingIndices.size()));
 
         for (size_t i = 0; i < num_files; i++)
         {
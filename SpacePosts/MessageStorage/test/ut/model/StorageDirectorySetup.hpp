@@ -80,6 +80,17 @@ namespace SpacePosts
          */
         std::map<U32,SpacePostFile> getLastNSpacePostFiles(const U32 numFilesToGet) const;
 
+        /**
+         * @brief Get theSpacePostFiles with the MESSAGESTORAGE_STORED_INDEX_HISTORY_SIZE highest indices which exist
+         * in the storage directory.
+         *
+         * This interface definition mimics the indices the MessageStorage component remembers upon initialization,
+         * i.e., the messages its `loadMessageRange` port can reach.
+         *
+         * @return std::vector<U32,SpacePostFile> theSpacePostFiles
+         */
+        std::map<U32,SpacePostFile> getSpacePostFilesInIndexHistory() const;
+
         /**
          * @brief Sets theSpacePostFiles with the highest indices in the storage directory to the givenSpacePostFiles.
          * 
@@ -135,6 +146,14 @@ namespace SpacePosts
          * @brief Deletes all files in the storage directory on disk (i.e., on the file system).
          */
         static void deleteAllFilesOnFileSystem();
+
+        /**
+         * @brief Get the numFilesToGetSpacePostFiles with the highest indices which exist in the storage directory.
+         *
+         * @param numFilesToGet the maximum number ofSpacePostFiles to get
+         * @return std::vector<U32,SpacePostFile> theSpacePostFiles
+         */
+        std::map<U32,SpacePostFile> getHighestIndexedSpacePostFiles(const U32 numFilesToGet) const;
     };
 }
 
@@ -0,0 +1,210 @@
+// ======================================================================
+// \title  CompactSpacePostBatch.cpp
+// \author Marius Baden
+// \brief  cpp file for a batch of SpacePosts whose texts are packed back to back
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#include <cstring>
+
+#include "CompactSpacePostBatch.hpp"
+#include "Fw/Types/Assert.hpp"
+
+namespace SpacePosts
+{
+    namespace
+    {
+        constexpr U32 BATCH_SIZE = FppConstant_SpacePost_Batch_Size::SpacePost_Batch_Size;
+        constexpr U32 MAX_TEXT_LENGTH = FppConstant_SpacePost_MaxTextLength::SpacePost_MaxTextLength;
+
+        // The first SpacePost starts behind the number of SpacePosts
+        constexpr U16 FIRST_OFFSET = sizeof(U8);
+    }
+
+    static_assert(CompactSpacePostBatch::ARENA_SIZE <= 0xFFFF, "Offsets into the arena must fit into a U16");
+    static_assert(BATCH_SIZE <= 0xFF, "The number of SpacePosts must fit into the U8 of a SpacePost_Batch");
+
+    CompactSpacePostBatch::CompactSpacePostBatch()
+        : m_offsets()
+    {
+        // The arena is left uninitialized. Only the bytes up to getSerializedSize() are ever read
+        this->clear();
+    }
+
+    void CompactSpacePostBatch::clear()
+    {
+        this->m_offsets[0] = FIRST_OFFSET;
+        this->m_arena[0] = 0;
+        this->clearUnusedEntries();
+    }
+
+    U8 CompactSpacePostBatch::getNumPosts() const
+    {
+        return this->m_arena[0];
+    }
+
+    const U8 *CompactSpacePostBatch::getText(const U32 index) const
+    {
+        FW_ASSERT(index < this->getNumPosts(), index, this->getNumPosts());
+        return &this->m_arena[this->m_offsets[index] + LENGTH_SIZE];
+    }
+
+    U32 CompactSpacePostBatch::getTextLength(const U32 index) const
+    {
+        FW_ASSERT(index < this->getNumPosts(), index, this->getNumPosts());
+        return this->m_offsets[index + 1] - this->m_offsets[index] - LENGTH_SIZE;
+    }
+
+    U32 CompactSpacePostBatch::getSerializedSize() const
+    {
+        // The unused entries are serialized as empty texts, i.e., just their length
+        const U8 num_posts = this->getNumPosts();
+        return this->m_offsets[num_posts] + (BATCH_SIZE - num_posts) * LENGTH_SIZE;
+    }
+
+    bool CompactSpacePostBatch::append(const U8 *const text, const U32 length)
+    {
+        FW_ASSERT(length <= MAX_TEXT_LENGTH, length);
+        const U8 num_posts = this->getNumPosts();
+        if (num_posts >= BATCH_SIZE)
+        {
+            return false;
+        }
+
+        // Fits: the arena is sized for a full batch of SpacePosts of maximum length
+        (void)std::memcpy(&this->m_arena[this->m_offsets[num_posts] + LENGTH_SIZE], text, length);
+        this->commit(length);
+        return true;
+    }
+
+    bool CompactSpacePostBatch::append(const SpacePost &post)
+    {
+        const Fw::StringBase &text = post.getmessage_content();
+        return this->append(reinterpret_cast<const U8 *>(text.toChar()), text.length());
+    }
+
+    Fw::SerializeStatus CompactSpacePostBatch::appendSerialized(Fw::SerializeBufferBase &buffer)
+    {
+        const U8 num_posts = this->getNumPosts();
+        if (num_posts >= BATCH_SIZE)
+        {
+            return Fw::FW_SERIALIZE_NO_ROOM_LEFT;
+        }
+
+        // Deserialize the text straight into the arena behind the place of its length
+        const U32 offset = this->m_offsets[num_posts];
+        U8 *const text = &this->m_arena[offset + LENGTH_SIZE];
+        NATIVE_UINT_TYPE length{MAX_TEXT_LENGTH}; // Overwritten with the number of characters deserialized
+        const Fw::SerializeStatus status = buffer.deserialize(text, length);
+        if (status != Fw::FW_SERIALIZE_OK)
+        {
+            // The unused entries may have been overwritten
+            this->clearUnusedEntries();
+            return status;
+        }
+
+        // Like a deserialized SpacePost, the text ends at the first null-terminator
+        const U8 *const terminator = static_cast<const U8 *>(std::memchr(text, 0, length));
+        if (terminator != nullptr)
+        {
+            length = static_cast<NATIVE_UINT_TYPE>(terminator - text);
+        }
+        this->commit(length);
+        return Fw::FW_SERIALIZE_OK;
+    }
+
+    void CompactSpacePostBatch::truncate(const U8 numPosts)
+    {
+        FW_ASSERT(numPosts <= this->getNumPosts(), numPosts, this->getNumPosts());
+        this->m_arena[0] = numPosts;
+        this->clearUnusedEntries();
+    }
+
+    U8 CompactSpacePostBatch::fromBatch(const SpacePost_Batch &batch)
+    {
+        this->clear();
+        const U32 num_posts = (batch.getnumValidMessages() < BATCH_SIZE) ? batch.getnumValidMessages() : BATCH_SIZE;
+        const SpacePost_Array &posts = batch.getmessages();
+        for (U32 i = 0; i < num_posts; i++)
+        {
+            (void)this->append(posts[i]);
+        }
+        return this->getNumPosts();
+    }
+
+    void CompactSpacePostBatch::toBatch(SpacePost_Batch &batch) const
+    {
+        // Deserialization only reads the arena
+        Fw::ExternalSerializeBuffer buffer{const_cast<U8 *>(this->m_arena), this->getSerializedSize()};
+        Fw::SerializeStatus status = buffer.setBuffLen(this->getSerializedSize());
+        FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+        status = batch.deserialize(buffer);
+        FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    }
+
+    Fw::SerializeStatus CompactSpacePostBatch::serialize(Fw::SerializeBufferBase &buffer) const
+    {
+        return buffer.serialize(this->m_arena, this->getSerializedSize(), true);
+    }
+
+    Fw::SerializeStatus CompactSpacePostBatch::deserialize(Fw::SerializeBufferBase &buffer)
+    {
+        this->clear();
+        U8 num_posts{0};
+        Fw::SerializeStatus status = buffer.deserialize(num_posts);
+        if (status != Fw::FW_SERIALIZE_OK)
+        {
+            return status;
+        }
+        if (num_posts > BATCH_SIZE)
+        {
+            return Fw::FW_DESERIALIZE_FORMAT_ERROR;
+        }
+
+        // Every entry is serialized, but only the valid ones are kept
+        for (U32 i = 0; i < BATCH_SIZE && status == Fw::FW_SERIALIZE_OK; i++)
+        {
+            if (i < num_posts)
+            {
+                status = this->appendSerialized(buffer);
+            }
+            else
+            {
+                U8 discarded[MAX_TEXT_LENGTH];
+                NATIVE_UINT_TYPE length{sizeof(discarded)};
+                status = buffer.deserialize(discarded, length);
+            }
+        }
+        if (status != Fw::FW_SERIALIZE_OK)
+        {
+            this->clear();
+        }
+        return status;
+    }
+
+    void CompactSpacePostBatch::commit(const U32 length)
+    {
+        const U8 num_posts = this->getNumPosts();
+        const U32 offset = this->m_offsets[num_posts];
+
+        // The length in front of the text, in the format of a serialized string
+        Fw::ExternalSerializeBuffer length_buffer{&this->m_arena[offset], LENGTH_SIZE};
+        const Fw::SerializeStatus status = length_buffer.serialize(static_cast<FwBuffSizeType>(length));
+        FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+
+        this->m_offsets[num_posts + 1] = static_cast<U16>(offset + LENGTH_SIZE + length);
+        this->m_arena[0] = num_posts + 1;
+        this->clearUnusedEntries();
+    }
+
+    void CompactSpacePostBatch::clearUnusedEntries()
+    {
+        const U8 num_posts = this->getNumPosts();
+        (void)std::memset(&this->m_arena[this->m_offsets[num_posts]], 0, (BATCH_SIZE - num_posts) * LENGTH_SIZE);
+    }
+}
@@ -0,0 +1,160 @@
+// ======================================================================
+// \title  CompactSpacePostBatch.hpp
+// \author Marius Baden
+// \brief  hpp file for a batch of SpacePosts whose texts are packed back to back
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#ifndef CompactSpacePostBatch_HPP
+#define CompactSpacePostBatch_HPP
+
+#include "Fw/Types/BasicTypes.hpp"
+#include "Fw/Types/Serializable.hpp"
+#include "SpacePosts/MessageTypes/FppConstantsAc.hpp"
+#include "SpacePosts/MessageTypes/SpacePostSerializableAc.hpp"
+#include "SpacePosts/MessageTypes/SpacePost_BatchSerializableAc.hpp"
+
+namespace SpacePosts
+{
+    /**
+     * @brief A batch of SpacePosts whose texts are packed back to back into one arena
+     *
+     * A SpacePost_Batch reserves SpacePost_MaxCStrLength characters for each of its SpacePost_Batch_Size entries,
+     * no matter how many of them are valid and how long their texts are. Constructing, copying, or assigning one
+     * thus touches about 8 KB. A CompactSpacePostBatch only writes the bytes of the texts appended to it, and an
+     * offset table locates each of them.
+     *
+     * The arena holds the SpacePosts in the serialized form of a SpacePost_Batch: the number of valid SpacePosts,
+     * each text with its length in front of it, and an empty text for every unused entry. Hence:
+     *  - toBatch() deserializes the arena straight into a SpacePost_Batch, without an intermediate SpacePost_Array
+     *  - appendSerialized() appends a serialized SpacePost, e.g., as read from a message file, with a single copy
+     *  - serialize() produces the same bytes as serializing the equivalent SpacePost_Batch
+     */
+    class CompactSpacePostBatch : public Fw::Serializable
+    {
+        public:
+
+            //! The number of bytes of the length in front of each text, as F' serializes strings
+            static constexpr U32 LENGTH_SIZE = sizeof(FwBuffSizeType);
+
+            //! The number of bytes of the arena: a full batch of SpacePosts of maximum length
+            static constexpr U32 ARENA_SIZE =
+                sizeof(U8) + FppConstant_SpacePost_Batch_Size::SpacePost_Batch_Size *
+                                 (LENGTH_SIZE + FppConstant_SpacePost_MaxTextLength::SpacePost_MaxTextLength);
+
+            /**
+             * @brief Constructs an empty batch
+             */
+            CompactSpacePostBatch();
+
+            /**
+             * @brief Removes all SpacePosts
+             */
+            void clear();
+
+            //! The number of SpacePosts in the batch
+            U8 getNumPosts() const;
+
+            /**
+             * @brief Returns the text of a SpacePost. It is not null-terminated
+             *
+             * @param index The position of the SpacePost in the batch. Must be less than getNumPosts()
+             */
+            const U8 *getText(const U32 index) const;
+
+            /**
+             * @brief Returns the number of characters of the text of a SpacePost
+             *
+             * @param index The position of the SpacePost in the batch. Must be less than getNumPosts()
+             */
+            U32 getTextLength(const U32 index) const;
+
+            //! The number of bytes of the batch serialized as SpacePost_Batch
+            U32 getSerializedSize() const;
+
+            /**
+             * @brief Appends a SpacePost with the given text
+             *
+             * @param text The text. Must not contain a null-terminator
+             * @param length The number of characters of text. At most SpacePost_MaxTextLength
+             * @return true iff the SpacePost has been appended. False if the batch already holds SpacePost_Batch_Size
+             */
+            bool append(const U8 *const text, const U32 length);
+
+            /**
+             * @brief Appends a copy of the given SpacePost
+             *
+             * @return true iff the SpacePost has been appended. False if the batch already holds SpacePost_Batch_Size
+             */
+            bool append(const SpacePost &post);
+
+            /**
+             * @brief Deserializes a SpacePost from the buffer and appends it
+             *
+             * Like deserializing a SpacePost, the text ends at a null-terminator within it.
+             *
+             * @param buffer The buffer to deserialize the SpacePost from
+             * @return Fw::FW_SERIALIZE_OK iff the SpacePost has been appended. Fw::FW_SERIALIZE_NO_ROOM_LEFT if the
+             *         batch already holds SpacePost_Batch_Size SpacePosts. Otherwise, the error of the deserialization
+             */
+            Fw::SerializeStatus appendSerialized(Fw::SerializeBufferBase &buffer);
+
+            /**
+             * @brief Removes the SpacePosts from the given position on
+             *
+             * @param numPosts The number of SpacePosts to keep. At most getNumPosts()
+             */
+            void truncate(const U8 numPosts);
+
+            /**
+             * @brief Replaces the content of this batch with the valid SpacePosts of the given one
+             *
+             * @return The number of SpacePosts copied
+             */
+            U8 fromBatch(const SpacePost_Batch &batch);
+
+            /**
+             * @brief Replaces the content of the given SpacePost_Batch with the SpacePosts of this batch
+             *
+             * The unused entries of the SpacePost_Batch become empty SpacePosts.
+             */
+            void toBatch(SpacePost_Batch &batch) const;
+
+            /**
+             * @brief Serializes the batch in the format of a SpacePost_Batch
+             */
+            Fw::SerializeStatus serialize(Fw::SerializeBufferBase &buffer) const override;
+
+            /**
+             * @brief Replaces the content of this batch with a SpacePost_Batch deserialized from the buffer
+             */
+            Fw::SerializeStatus deserialize(Fw::SerializeBufferBase &buffer) override;
+
+        private:
+
+            //! The start of each SpacePost's length in the arena, and the end of the last SpacePost behind them
+            U16 m_offsets[FppConstant_SpacePost_Batch_Size::SpacePost_Batch_Size + 1];
+
+            //! The serialized SpacePost_Batch. The number of SpacePosts is its first byte
+            U8 m_arena[ARENA_SIZE];
+
+            /**
+             * @brief Appends the SpacePost whose text has been written behind the end of the last one
+             *
+             * @param length The number of characters of the text
+             */
+            void commit(const U32 length);
+
+            /**
+             * @brief Zeroes the lengths of the unused entries behind the last SpacePost
+             */
+            void clearUnusedEntries();
+    };
+}
+
+#endif
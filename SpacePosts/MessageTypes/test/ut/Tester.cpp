@@ -0,0 +1,162 @@
+// ======================================================================
+// \title  MessageTypes/test/ut/Tester.cpp
+// \author Marius Baden
+// \brief  cpp file for the tests of the CompactSpacePostBatch
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "Tester.hpp"
+#include "SpacePosts/MessageTypes/CompactSpacePostBatch.hpp"
+#include "SpacePosts/MessageTypes/FppConstantsAc.hpp"
+
+namespace SpacePosts
+{
+
+  namespace
+  {
+    constexpr U32 MAX_MSGTEXT_LENGTH = FppConstant_SpacePost_MaxTextLength::SpacePost_MaxTextLength;
+    constexpr U32 MAX_MSGBATCH_SIZE = FppConstant_SpacePost_Batch_Size::SpacePost_Batch_Size;
+    constexpr U32 LENGTH_SIZE = CompactSpacePostBatch::LENGTH_SIZE;
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  void Tester::testRoundTrip(const U8 numPosts, const U32 textLength)
+  {
+    const SpacePost_Batch batch = makeBatch(numPosts, textLength);
+    const std::vector<U8> batch_bytes = serializeToBytes(batch);
+
+    CompactSpacePostBatch compact{};
+    ASSERT_EQ(compact.fromBatch(batch), numPosts);
+    for (U32 i = 0; i < numPosts; i++)
+    {
+      const Fw::StringBase &text = batch.getmessages()[i].getmessage_content();
+      ASSERT_EQ(compact.getTextLength(i), textLength);
+      ASSERT_EQ(std::string(reinterpret_cast<const char *>(compact.getText(i)), compact.getTextLength(i)),
+                std::string(text.toChar()));
+    }
+    ASSERT_EQ(compact.getSerializedSize(), batch_bytes.size());
+    ASSERT_EQ(serializeToBytes(compact), batch_bytes);
+
+    // Deserialize into a batch which held other SpacePosts before
+    CompactSpacePostBatch deserialized{};
+    (void)deserialized.fromBatch(makeBatch(MAX_MSGBATCH_SIZE, MAX_MSGTEXT_LENGTH));
+    std::vector<U8> bytes = batch_bytes;
+    Fw::ExternalSerializeBuffer buffer{bytes.data(), static_cast<NATIVE_UINT_TYPE>(bytes.size())};
+    ASSERT_EQ(buffer.setBuffLen(static_cast<NATIVE_UINT_TYPE>(bytes.size())), Fw::FW_SERIALIZE_OK);
+    ASSERT_EQ(deserialized.deserialize(buffer), Fw::FW_SERIALIZE_OK);
+    ASSERT_EQ(buffer.getBuffLeft(), 0U);
+    ASSERT_EQ(deserialized.getNumPosts(), numPosts);
+    ASSERT_EQ(serializeToBytes(deserialized), batch_bytes);
+
+    SpacePost_Batch converted = makeBatch(MAX_MSGBATCH_SIZE, MAX_MSGTEXT_LENGTH);
+    deserialized.toBatch(converted);
+    ASSERT_EQ(converted, batch);
+  }
+
+  void Tester::testDeserializeTooManyPosts()
+  {
+    std::vector<U8> bytes = serializeToBytes(makeBatch(MAX_MSGBATCH_SIZE, 5));
+    bytes[0] = MAX_MSGBATCH_SIZE + 1;
+
+    CompactSpacePostBatch compact{};
+    (void)compact.fromBatch(makeBatch(3, 5));
+    Fw::ExternalSerializeBuffer buffer{bytes.data(), static_cast<NATIVE_UINT_TYPE>(bytes.size())};
+    ASSERT_EQ(buffer.setBuffLen(static_cast<NATIVE_UINT_TYPE>(bytes.size())), Fw::FW_SERIALIZE_OK);
+    ASSERT_EQ(compact.deserialize(buffer), Fw::FW_DESERIALIZE_FORMAT_ERROR);
+    ASSERT_EQ(compact.getNumPosts(), 0);
+    ASSERT_EQ(serializeToBytes(compact), serializeToBytes(SpacePost_Batch{}));
+  }
+
+  void Tester::testDeserializeTooLongText(const U8 numPosts, const U8 entry)
+  {
+    ASSERT_LT(entry, MAX_MSGBATCH_SIZE);
+    const U32 text_length = 5;
+    std::vector<U8> bytes = serializeToBytes(makeBatch(numPosts, text_length));
+
+    // The valid entries have texts of text_length characters, the unused ones are empty
+    U32 offset = sizeof(U8);
+    for (U32 i = 0; i < entry; i++)
+    {
+      offset += LENGTH_SIZE + ((i < numPosts) ? text_length : 0);
+    }
+    Fw::ExternalSerializeBuffer length_buffer{&bytes[offset], LENGTH_SIZE};
+    ASSERT_EQ(length_buffer.serialize(static_cast<FwBuffSizeType>(MAX_MSGTEXT_LENGTH + 1)), Fw::FW_SERIALIZE_OK);
+
+    checkBothReject(bytes);
+  }
+
+  void Tester::testDeserializeTruncated(const U32 numMissingBytes)
+  {
+    std::vector<U8> bytes = serializeToBytes(makeBatch(MAX_MSGBATCH_SIZE, MAX_MSGTEXT_LENGTH));
+    ASSERT_GE(numMissingBytes, 1U);
+    ASSERT_LE(numMissingBytes, bytes.size());
+    bytes.resize(bytes.size() - numMissingBytes);
+
+    checkBothReject(bytes);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper Methods
+  // ----------------------------------------------------------------------
+
+  SpacePost_Batch Tester::makeBatch(const U8 numPosts, const U32 textLength)
+  {
+    SpacePost_Array messages{};
+    for (U32 i = 0; i < numPosts; i++)
+    {
+      std::string text{};
+      for (U32 j = 0; j < textLength; j++)
+      {
+        text.push_back(static_cast<char>('a' + (i + j) % 26));
+      }
+      messages[i] = SpacePost{text.c_str()};
+    }
+    return SpacePost_Batch{numPosts, messages};
+  }
+
+  std::vector<U8> Tester::serializeToBytes(const Fw::Serializable &serializable)
+  {
+    std::vector<U8> bytes(SpacePost_Batch::SERIALIZED_SIZE);
+    Fw::ExternalSerializeBuffer buffer{bytes.data(), static_cast<NATIVE_UINT_TYPE>(bytes.size())};
+    EXPECT_EQ(serializable.serialize(buffer), Fw::FW_SERIALIZE_OK);
+    bytes.resize(buffer.getBuffLength());
+    return bytes;
+  }
+
+  void Tester::checkBothReject(const std::vector<U8> &bytes)
+  {
+    std::vector<U8> compact_bytes = bytes;
+    Fw::ExternalSerializeBuffer compact_buffer{compact_bytes.data(), static_cast<NATIVE_UINT_TYPE>(bytes.size())};
+    ASSERT_EQ(compact_buffer.setBuffLen(static_cast<NATIVE_UINT_TYPE>(bytes.size())), Fw::FW_SERIALIZE_OK);
+    CompactSpacePostBatch compact{};
+    (void)compact.fromBatch(makeBatch(3, 5));
+    const Fw::SerializeStatus compact_status = compact.deserialize(compact_buffer);
+
+    std::vector<U8> batch_bytes = bytes;
+    Fw::ExternalSerializeBuffer batch_buffer{batch_bytes.data(), static_cast<NATIVE_UINT_TYPE>(bytes.size())};
+    ASSERT_EQ(batch_buffer.setBuffLen(static_cast<NATIVE_UINT_TYPE>(bytes.size())), Fw::FW_SERIALIZE_OK);
+    SpacePost_Batch batch{};
+    const Fw::SerializeStatus batch_status = batch.deserialize(batch_buffer);
+
+    ASSERT_NE(batch_status, Fw::FW_SERIALIZE_OK);
+    ASSERT_EQ(compact_status, batch_status);
+
+    // No SpacePost deserialized before the malformed entry and none of before remains
+    ASSERT_EQ(compact.getNumPosts(), 0);
+    ASSERT_EQ(serializeToBytes(compact), serializeToBytes(SpacePost_Batch{}));
+  }
+
+} // end namespace SpacePosts
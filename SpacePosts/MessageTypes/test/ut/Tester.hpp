@@ -0,0 +1,110 @@
+// ======================================================================
+// \title  MessageTypes/test/ut/Tester.hpp
+// \author Marius Baden
+// \brief  hpp file for the tests of the CompactSpacePostBatch
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#ifndef TESTER_HPP
+#define TESTER_HPP
+
+#include <vector>
+
+#include "Fw/Types/BasicTypes.hpp"
+#include "Fw/Types/Serializable.hpp"
+#include "SpacePosts/MessageTypes/SpacePost_BatchSerializableAc.hpp"
+
+namespace SpacePosts
+{
+
+  /**
+   * @brief Tests that a CompactSpacePostBatch is serialized and deserialized exactly like a SpacePost_Batch.
+   *
+   * The MessageTypes are no component, so there is no component under test and no ports to connect.
+   */
+  class Tester
+  {
+
+  public:
+    // ----------------------------------------------------------------------
+    // Tests
+    // ----------------------------------------------------------------------
+
+    /*
+        UT-MSG-010
+        Test that a CompactSpacePostBatch round-trips through the serialized form of a SpacePost_Batch
+    */
+
+    /**
+     * @brief Builds a SpacePost_Batch, copies it into a CompactSpacePostBatch, and checks that both serialize to the
+     * same bytes.
+     *
+     * Then deserializes these bytes into a second CompactSpacePostBatch and checks that it serializes to them again
+     * and that converting it back yields the original SpacePost_Batch, without any stale SpacePost of the batch it
+     * is converted into.
+     *
+     * @param numPosts The number of valid SpacePosts. At most SpacePost_Batch_Size
+     * @param textLength The number of characters of each SpacePost's text. At most SpacePost_MaxTextLength
+     */
+    void testRoundTrip(const U8 numPosts, const U32 textLength);
+
+    /*
+        UT-MSG-020
+        Test rejecting serialized SpacePost_Batches with a malformed length
+    */
+
+    /**
+     * @brief Deserializes a SpacePost_Batch whose number of valid SpacePosts exceeds SpacePost_Batch_Size and checks
+     * that the CompactSpacePostBatch rejects it and is left empty.
+     */
+    void testDeserializeTooManyPosts();
+
+    /**
+     * @brief Deserializes a SpacePost_Batch whose entry has a text length beyond SpacePost_MaxTextLength and checks
+     * that the CompactSpacePostBatch rejects it like a SpacePost_Batch and is left empty.
+     *
+     * @param numPosts The number of valid SpacePosts
+     * @param entry The entry whose length is malformed. May be a valid or an unused one
+     */
+    void testDeserializeTooLongText(const U8 numPosts, const U8 entry);
+
+    /**
+     * @brief Deserializes a full SpacePost_Batch of maximum length whose serialized form is cut short and checks that
+     * the CompactSpacePostBatch rejects it like a SpacePost_Batch and is left empty.
+     *
+     * @param numMissingBytes The number of bytes cut off the end of the serialized form. At least 1
+     */
+    void testDeserializeTruncated(const U32 numMissingBytes);
+
+  private:
+    // ----------------------------------------------------------------------
+    // Helper Methods
+    // ----------------------------------------------------------------------
+
+    /**
+     * @brief Builds a SpacePost_Batch whose SpacePosts have texts of the given length which differ from each other
+     */
+    static SpacePost_Batch makeBatch(const U8 numPosts, const U32 textLength);
+
+    /**
+     * @brief Serializes the given object into a buffer of the size of a serialized SpacePost_Batch
+     *
+     * @return The serialized bytes
+     */
+    static std::vector<U8> serializeToBytes(const Fw::Serializable &serializable);
+
+    /**
+     * @brief Deserializes the given bytes into a CompactSpacePostBatch and into a SpacePost_Batch and checks that
+     * both fail with the same status and that the CompactSpacePostBatch is left empty
+     */
+    static void checkBothReject(const std::vector<U8> &bytes);
+  };
+
+} // end namespace SpacePosts
+
+#endif
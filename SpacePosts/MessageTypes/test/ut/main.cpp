@@ -0,0 +1,84 @@
+#include "Tester.hpp"
+#include "gtest/gtest.h"
+
+#include "SpacePosts/MessageTypes/FppConstantsAc.hpp"
+
+using namespace SpacePosts;
+
+constexpr const U32 MAX_MSGTEXT_LENGTH = SpacePosts::FppConstant_SpacePost_MaxTextLength::SpacePost_MaxTextLength;
+
+constexpr const U8 MAX_MSGBATCH_SIZE = SpacePosts::FppConstant_SpacePost_Batch_Size::SpacePost_Batch_Size;
+
+/*
+    UT-MSG-010
+    Test that a CompactSpacePostBatch round-trips through the serialized form of a SpacePost_Batch
+*/
+
+TEST(CompactSpacePostBatchTest, TestRoundTripNominalEmpty)
+{
+    Tester tester{};
+    tester.testRoundTrip(0, 0);
+}
+TEST(CompactSpacePostBatchTest, TestRoundTripNominalEmptyText)
+{
+    Tester tester{};
+    tester.testRoundTrip(1, 0);
+}
+TEST(CompactSpacePostBatchTest, TestRoundTripNominalSinglePost)
+{
+    Tester tester{};
+    tester.testRoundTrip(1, 12);
+}
+TEST(CompactSpacePostBatchTest, TestRoundTripNominalFull)
+{
+    Tester tester{};
+    tester.testRoundTrip(MAX_MSGBATCH_SIZE, 12);
+}
+TEST(CompactSpacePostBatchTest, TestRoundTripNominalFullMaxLength)
+{
+    Tester tester{};
+    tester.testRoundTrip(MAX_MSGBATCH_SIZE, MAX_MSGTEXT_LENGTH);
+}
+
+/*
+    UT-MSG-020
+    Test rejecting serialized SpacePost_Batches with a malformed length
+*/
+
+TEST(CompactSpacePostBatchTest, TestDeserializeErrorTooManyPosts)
+{
+    Tester tester{};
+    tester.testDeserializeTooManyPosts();
+}
+TEST(CompactSpacePostBatchTest, TestDeserializeErrorTooLongFirstText)
+{
+    Tester tester{};
+    tester.testDeserializeTooLongText(3, 0);
+}
+TEST(CompactSpacePostBatchTest, TestDeserializeErrorTooLongLaterText)
+{
+    Tester tester{};
+    tester.testDeserializeTooLongText(3, 2);
+}
+TEST(CompactSpacePostBatchTest, TestDeserializeErrorTooLongUnusedText)
+{
+    Tester tester{};
+    tester.testDeserializeTooLongText(3, MAX_MSGBATCH_SIZE - 1);
+}
+TEST(CompactSpacePostBatchTest, TestDeserializeErrorTruncatedInLastText)
+{
+    Tester tester{};
+    tester.testDeserializeTruncated(1);
+}
+TEST(CompactSpacePostBatchTest, TestDeserializeErrorTruncatedInLastLength)
+{
+    Tester tester{};
+    tester.testDeserializeTruncated(MAX_MSGTEXT_LENGTH + 1);
+}
+
+// Execute tests
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,129 @@
+// ======================================================================
+// \title  ActiveModerator.cpp
+// \author Marius Baden
+// \brief  cpp file for ActiveModerator component implementation class
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#include <SpacePosts/Moderator/ActiveModerator.hpp>
+#include <config/ModeratorCfg.hpp>
+#include "Fw/Types/BasicTypes.hpp"
+
+#include "ModerationStrategy.hpp"
+
+namespace SpacePosts
+{
+
+  // ----------------------------------------------------------------------
+  // Construction, initialization, and destruction
+  // ----------------------------------------------------------------------
+
+  ActiveModerator ::
+      ActiveModerator(
+          const char *const compName,
+          ModerationStrategy &moderationStrategy) : ActiveModeratorComponentBase(compName),
+                                                    m_moderationStrategy(moderationStrategy),
+                                                    m_numDrops(0),
+                                                    m_lastTelemetryUs(0),
+                                                    m_telemetryWritten(false)
+  {
+  }
+
+  void ActiveModerator ::
+      init(
+          const NATIVE_INT_TYPE queueDepth,
+          const NATIVE_INT_TYPE instance)
+  {
+    ActiveModeratorComponentBase::init(queueDepth, instance);
+  }
+
+  ActiveModerator ::
+      ~ActiveModerator()
+  {
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for user-defined typed input ports
+  // ----------------------------------------------------------------------
+
+  SpacePosts::MessageStorageStatus ActiveModerator ::
+      moderateMessage_handler(
+          const NATIVE_INT_TYPE portNum,
+          const SpacePosts::SpacePost &data)
+  {
+    // The internal port drops the message if the queue is full and counts it. The port is guarded, so no other
+    // thread can drop a message in between
+    const NATIVE_INT_TYPE num_dropped = this->getNumMsgsDropped();
+    this->moderateQueued_internalInterfaceInvoke(data);
+    if (this->getNumMsgsDropped() != num_dropped)
+    {
+      this->tlmWrite_QUEUE_DROPS(++this->m_numDrops);
+      this->log_WARNING_LO_MESSAGE_DROPPED(static_cast<U32>(this->m_queue.getQueueSize()));
+    }
+    else
+    {
+      this->tlmWrite_QUEUE_HIGH_WATER(static_cast<U32>(this->m_queue.getMaxMsgs()));
+
+      // Report drops again once a message fits into the queue again. Only this handler logs the event, so the
+      // throttle is only touched under the port's guard
+      this->log_WARNING_LO_MESSAGE_DROPPED_ThrottleClear();
+    }
+
+    // Return no error so that the behavior for a component using the input port is the same no matter whether
+    // an ActiveModerator is used inbetween two components' SpacePostSet ports (e.g. Transceiver and MessageStorage)
+    // or not. The actual result is only known after the check
+    return SpacePosts::MessageStorageStatus::OK;
+  }
+
+  // ----------------------------------------------------------------------
+  // Internal interface handlers
+  // ----------------------------------------------------------------------
+
+  void ActiveModerator ::
+      moderateQueued_internalInterfaceHandler(
+          const SpacePosts::SpacePost &data)
+  {
+    if (this->m_moderationStrategy.checkMessage(data))
+    {
+      (void)this->acceptedMessage_out(0, data);
+    }
+    else
+    {
+      this->log_ACTIVITY_HI_MESSAGE_REJECTED();
+    }
+
+    this->writeStrategyStatistics();
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper methods
+  // ----------------------------------------------------------------------
+
+  void ActiveModerator ::
+      writeStrategyStatistics()
+  {
+    const Fw::Time now = this->getTime();
+    const U64 now_us = static_cast<U64>(now.getSeconds()) * 1000000 + now.getUSeconds();
+
+    // A time which went backwards also lets the telemetry be written, so it cannot get stuck
+    if (this->m_telemetryWritten && now_us >= this->m_lastTelemetryUs &&
+        now_us - this->m_lastTelemetryUs < static_cast<U64>(MODERATOR_TELEMETRY_INTERVAL_MS) * 1000)
+    {
+      return;
+    }
+
+    SpacePosts::ModerationStrategyStats_Array stats{};
+    if (this->m_moderationStrategy.getStatistics(stats) > 0)
+    {
+      this->m_telemetryWritten = true;
+      this->m_lastTelemetryUs = now_us;
+      this->tlmWrite_STRATEGY_STATS(stats);
+    }
+  }
+
+} // end namespace SpacePosts
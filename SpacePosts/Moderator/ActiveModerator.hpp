@@ -0,0 +1,102 @@
+// ======================================================================
+// \title  ActiveModerator.hpp
+// \author Marius Baden
+// \brief  hpp file for ActiveModerator component implementation class
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#ifndef ActiveModerator_HPP
+#define ActiveModerator_HPP
+
+#include "SpacePosts/Moderator/ActiveModeratorComponentAc.hpp"
+#include "ModerationStrategy.hpp"
+
+namespace SpacePosts
+{
+
+  class ActiveModerator : public ActiveModeratorComponentBase
+  {
+
+    PRIVATE :
+
+        //! The moderation strategy to use to decide whether to forward or discard a SpacePost
+        //!
+        //! Only called on the component's thread.
+        ModerationStrategy &m_moderationStrategy;
+
+        //! The number of messages dropped because the queue was full
+        U32 m_numDrops;
+
+        //! The time of the last write of the STRATEGY_STATS telemetry, in microseconds
+        U64 m_lastTelemetryUs;
+
+        //! False until the STRATEGY_STATS telemetry has been written once
+        bool m_telemetryWritten;
+
+    public:
+      // ----------------------------------------------------------------------
+      // Construction, initialization, and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object ActiveModerator
+      //!
+      ActiveModerator(
+          const char *const compName,            /*!< The component name*/
+          ModerationStrategy &moderationStrategy /*!< The moderation strategy to use to decide whether to forward
+                                                      or discard a SpacePost*/
+      );
+
+      //! Initialize object ActiveModerator
+      //!
+      void init(
+          const NATIVE_INT_TYPE queueDepth,  /*!< The queue depth, i.e., the most messages waiting for the check*/
+          const NATIVE_INT_TYPE instance = 0 /*!< The instance number*/
+      );
+
+      //! Destroy object ActiveModerator
+      //!
+      ~ActiveModerator();
+
+    PRIVATE :
+
+        // ----------------------------------------------------------------------
+        // Handler implementations for user-defined typed input ports
+        // ----------------------------------------------------------------------
+
+        //! Handler implementation for moderateMessage
+        //!
+        //! Queues the message for the check on the component's thread. Drops it if the queue is full.
+        SpacePosts::MessageStorageStatus
+        moderateMessage_handler(
+            const NATIVE_INT_TYPE portNum,    /*!< The port number*/
+            const SpacePosts::SpacePost &data /*!< the SpacePost to store */
+        );
+
+        // ----------------------------------------------------------------------
+        // Internal interface handlers
+        // ----------------------------------------------------------------------
+
+        //! Internal interface handler for moderateQueued
+        //!
+        //! Checks the message and outputs it on acceptedMessage iff it passes the check.
+        void moderateQueued_internalInterfaceHandler(
+            const SpacePosts::SpacePost &data /*!< the SpacePost to check */
+        );
+
+        // ----------------------------------------------------------------------
+        // Helper methods
+        // ----------------------------------------------------------------------
+
+        //! Writes the statistics of the moderation strategy's individual strategies as telemetry, if it reports any
+        //! and MODERATOR_TELEMETRY_INTERVAL_MS has passed since they were last written
+        void writeStrategyStatistics();
+  };
+
+} // end namespace SpacePosts
+
+#endif
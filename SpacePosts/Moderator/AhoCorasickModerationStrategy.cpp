@@ -0,0 +1,243 @@
+// ======================================================================
+// \title  AhoCorasickModerationStrategy.cpp
+// \author Marius Baden
+// \brief  cpp file for the blocklist moderation strategy based on an Aho-Corasick automaton
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#include <cstring>
+#include <deque>
+
+#include <config/ModeratorCfg.hpp>
+#include "AhoCorasickModerationStrategy.hpp"
+#include "CompiledBlocklist.hpp"
+#include "Fw/Types/Assert.hpp"
+
+namespace SpacePosts
+{
+    namespace
+    {
+        // Marks a missing edge of the trie while building
+        constexpr U32 NO_STATE = 0xFFFFFFFF;
+    }
+
+    AhoCorasickModerationStrategy::AhoCorasickModerationStrategy(const bool ignoreCase)
+        : m_ignoreCase(ignoreCase),
+          m_built(false),
+          m_patterns(),
+          m_byteClasses(),
+          m_numClasses(1),
+          m_numStates(1),
+          m_transitions()
+    {
+    }
+
+    bool AhoCorasickModerationStrategy::addPattern(const char *const pattern, const U32 length)
+    {
+        if (this->m_built || length == 0)
+        {
+            return false;
+        }
+
+        std::string folded{pattern, length};
+        for (char &character : folded)
+        {
+            character = static_cast<char>(this->foldCase(static_cast<U8>(character)));
+        }
+        this->m_patterns.push_back(folded);
+        return true;
+    }
+
+    void AhoCorasickModerationStrategy::build()
+    {
+        FW_ASSERT(!this->m_built);
+
+        /*
+         *  Byte classes: one per distinct byte in the terms, class 0 for all others
+         */
+        (void)std::memset(this->m_byteClasses, 0, sizeof(this->m_byteClasses));
+        U32 num_classes{1};
+        for (const std::string &pattern : this->m_patterns)
+        {
+            for (const char character : pattern)
+            {
+                U8 &byte_class = this->m_byteClasses[static_cast<U8>(character)];
+                if (byte_class == 0)
+                {
+                    FW_ASSERT(num_classes < 256, num_classes);
+                    byte_class = static_cast<U8>(num_classes++);
+                }
+            }
+        }
+        // Terms are stored folded. Let the other case of a letter share its class
+        if (this->m_ignoreCase)
+        {
+            for (U32 byte = 'A'; byte <= 'Z'; byte++)
+            {
+                this->m_byteClasses[byte] = this->m_byteClasses[byte - 'A' + 'a'];
+            }
+        }
+        FW_ASSERT(num_classes <= 256, num_classes);
+
+        /*
+         *  Trie of all terms
+         */
+        std::vector<U32> trie(num_classes, NO_STATE); // Row per state, as the final table
+        std::vector<bool> completes_term(1, false);
+        U32 num_states{1};
+        for (const std::string &pattern : this->m_patterns)
+        {
+            U32 state{0};
+            for (const char character : pattern)
+            {
+                const U32 edge = state * num_classes + this->m_byteClasses[static_cast<U8>(character)];
+                if (trie[edge] == NO_STATE)
+                {
+                    trie[edge] = num_states++;
+                    trie.resize(num_states * num_classes, NO_STATE);
+                    completes_term.push_back(false);
+                }
+                state = trie[edge];
+            }
+            completes_term[state] = true;
+        }
+
+        /*
+         *  Turn the trie into the deterministic automaton in breadth-first order. A missing edge continues where the
+         *  failure link (longest proper suffix which is a trie state) continues. The failure link of a state is less
+         *  deep, so its row is already complete when it is needed.
+         */
+        std::vector<U32> failure(num_states, 0);
+        std::deque<U32> queue{};
+        for (U32 byte_class = 0; byte_class < num_classes; byte_class++)
+        {
+            U32 &next = trie[byte_class];
+            if (next == NO_STATE)
+            {
+                next = 0;
+            }
+            else
+            {
+                queue.push_back(next);
+            }
+        }
+        while (!queue.empty())
+        {
+            const U32 state = queue.front();
+            queue.pop_front();
+            const U32 failure_row = failure[state] * num_classes;
+
+            for (U32 byte_class = 0; byte_class < num_classes; byte_class++)
+            {
+                U32 &next = trie[state * num_classes + byte_class];
+                if (next == NO_STATE)
+                {
+                    next = trie[failure_row + byte_class];
+                }
+                else
+                {
+                    failure[next] = trie[failure_row + byte_class];
+                    // A state completes a term if any of its suffixes does
+                    completes_term[next] = completes_term[next] || completes_term[failure[next]];
+                    queue.push_back(next);
+                }
+            }
+        }
+
+        /*
+         *  Flat transition table: row offsets with match flags
+         */
+        FW_ASSERT(static_cast<U64>(num_states) * num_classes < MATCH_FLAG, num_states, num_classes);
+        for (U32 &entry : trie)
+        {
+            entry = entry * num_classes | (completes_term[entry] ? MATCH_FLAG : 0);
+        }
+
+        this->m_transitions.swap(trie);
+        this->m_numClasses = num_classes;
+        this->m_numStates = num_states;
+        this->m_built = true;
+
+        // The terms are compiled into the table
+        std::vector<std::string>{}.swap(this->m_patterns);
+    }
+
+    bool AhoCorasickModerationStrategy::containsPattern(const U8 *const text, const U32 length) const
+    {
+        FW_ASSERT(this->m_built);
+        return containsPattern(this->m_transitions.data(), this->m_byteClasses, text, length);
+    }
+
+    bool AhoCorasickModerationStrategy::containsPattern(const U32 *const transitions, const U8 *const byteClasses,
+                                                        const U8 *const text, const U32 length)
+    {
+        U32 row{0};
+        for (U32 i = 0; i < length; i++)
+        {
+            const U32 entry = transitions[row + byteClasses[text[i]]];
+            if (entry & MATCH_FLAG)
+            {
+                return true;
+            }
+            row = entry;
+        }
+        return false;
+    }
+
+    U32 AhoCorasickModerationStrategy::serialize(U8 *const buffer, const U32 bufferSize) const
+    {
+        const U32 size = this->getSerializedSize();
+        if (!this->m_built || bufferSize < size)
+        {
+            return 0;
+        }
+
+        const U32 header[CompiledBlocklist::HEADER_WORDS] = {MODERATOR_BLOCKLIST_FILE_MAGIC,
+                                                             MODERATOR_BLOCKLIST_FILE_VERSION, this->m_numClasses,
+                                                             this->m_numStates};
+        U8 *position = buffer;
+        (void)std::memcpy(position, header, sizeof(header));
+        position += sizeof(header);
+        (void)std::memcpy(position, this->m_byteClasses, sizeof(this->m_byteClasses));
+        position += sizeof(this->m_byteClasses);
+        (void)std::memcpy(position, this->m_transitions.data(), this->m_transitions.size() * sizeof(U32));
+        return size;
+    }
+
+    U32 AhoCorasickModerationStrategy::getSerializedSize() const
+    {
+        return CompiledBlocklist::HEADER_WORDS * sizeof(U32) + sizeof(this->m_byteClasses) +
+               this->m_transitions.size() * sizeof(U32);
+    }
+
+    bool AhoCorasickModerationStrategy::checkMessage(const SpacePosts::SpacePost &message)
+    {
+        const Fw::StringBase &text = message.getmessage_content();
+        return !this->containsPattern(reinterpret_cast<const U8 *>(text.toChar()), text.length());
+    }
+
+    U32 AhoCorasickModerationStrategy::getNumStates() const
+    {
+        return this->m_numStates;
+    }
+
+    U32 AhoCorasickModerationStrategy::getNumClasses() const
+    {
+        return this->m_numClasses;
+    }
+
+    U32 AhoCorasickModerationStrategy::getTableSize() const
+    {
+        return this->m_transitions.size() * sizeof(U32);
+    }
+
+    U8 AhoCorasickModerationStrategy::foldCase(const U8 character) const
+    {
+        return (this->m_ignoreCase && character >= 'A' && character <= 'Z') ? character - 'A' + 'a' : character;
+    }
+}
@@ -0,0 +1,160 @@
+// ======================================================================
+// \title  AhoCorasickModerationStrategy.hpp
+// \author Marius Baden
+// \brief  hpp file for the blocklist moderation strategy based on an Aho-Corasick automaton
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#ifndef AhoCorasickModerationStrategy_HPP
+#define AhoCorasickModerationStrategy_HPP
+
+#include <string>
+#include <vector>
+
+#include "Fw/Types/BasicTypes.hpp"
+#include "SpacePosts/MessageTypes/SpacePostSerializableAc.hpp"
+#include "ModerationStrategy.hpp"
+
+namespace SpacePosts
+{
+    /**
+     * @brief Moderation strategy which rejects every SpacePost containing a term of a blocklist
+     *
+     * All terms are matched in a single pass over the message content, no matter how many terms the blocklist has.
+     * For this, the terms are compiled into a deterministic Aho-Corasick automaton once, after all of them have been
+     * added with addPattern() and before the first check.
+     *
+     * The automaton is stored as a flat transition table with one row per state and one column per byte class. Bytes
+     * which occur in no term share a single class, so the rows only have as many entries as the blocklist has distinct
+     * characters. Each entry holds the offset of the next state's row and a flag for whether reaching that state
+     * completes a term. Thus, checking a byte is a single table lookup.
+     *
+     * Building allocates memory. Checking does not allocate memory and does not modify the strategy.
+     */
+    class AhoCorasickModerationStrategy final : public ModerationStrategy
+    {
+        public:
+
+            /**
+             * @brief Constructs an empty strategy. Terms are added with addPattern()
+             *
+             * @param ignoreCase Whether terms match regardless of the case of ASCII letters
+             */
+            explicit AhoCorasickModerationStrategy(const bool ignoreCase);
+
+            /**
+             * @brief Adds a term to the blocklist
+             *
+             * @param pattern The characters of the term. Need not be null-terminated
+             * @param length The number of characters of the term
+             * @return true iff the term was added. False if it is empty or the automaton has already been built
+             */
+            bool addPattern(const char *const pattern, const U32 length);
+
+            /**
+             * @brief Compiles all added terms into the automaton
+             *
+             * Must be called exactly once, after all terms have been added and before the first check.
+             */
+            void build();
+
+            /**
+             * @brief Checks whether the given text contains any term of the blocklist
+             *
+             * The automaton must have been built.
+             *
+             * @param text The text to check
+             * @param length The number of characters of text
+             * @return true iff at least one term occurs in text
+             */
+            bool containsPattern(const U8 *const text, const U32 length) const;
+
+            /**
+             * @brief Rejects the SpacePost iff its message content contains any term of the blocklist
+             *
+             * The automaton must have been built.
+             *
+             * @param message the SpacePost to check
+             * @return true if the message contains no term, false otherwise
+             */
+            bool checkMessage(
+                const SpacePosts::SpacePost &message /*!< the SpacePost to check */
+            ) override;
+
+            /**
+             * @brief Writes the built automaton in the compiled blocklist file format (see CompiledBlocklist.hpp)
+             *
+             * Used on the ground to compile the blocklist which the Moderator loads with RELOAD_BLOCKLIST.
+             *
+             * @param buffer The buffer to write to
+             * @param bufferSize The number of bytes of buffer. Must be at least getSerializedSize()
+             * @return The number of bytes written. 0 if the automaton has not been built or the buffer is too small
+             */
+            U32 serialize(U8 *const buffer, const U32 bufferSize) const;
+
+            //! The number of bytes serialize() writes
+            U32 getSerializedSize() const;
+
+            /**
+             * @brief Runs an automaton given by its tables over the given text
+             *
+             * Shared by the strategy and by compiled blocklists loaded from a file.
+             *
+             * @param transitions The transition table, as m_transitions
+             * @param byteClasses The byte class of every byte value, as m_byteClasses
+             * @param text The text to check
+             * @param length The number of characters of text
+             * @return true iff at least one term occurs in text
+             */
+            static bool containsPattern(const U32 *const transitions, const U8 *const byteClasses,
+                                        const U8 *const text, const U32 length);
+
+            //! The number of states of the built automaton
+            U32 getNumStates() const;
+
+            //! The number of byte classes, i.e., the number of entries per state in the transition table
+            U32 getNumClasses() const;
+
+            //! The size of the transition table in bytes
+            U32 getTableSize() const;
+
+            //! Flag in a transition table entry which marks that the next state completes a term
+            static constexpr U32 MATCH_FLAG = 0x80000000;
+
+        private:
+
+            //! Whether terms match regardless of the case of ASCII letters
+            const bool m_ignoreCase;
+
+            //! True iff build() has been called
+            bool m_built;
+
+            //! The added terms. Only needed until build() and released afterwards
+            std::vector<std::string> m_patterns;
+
+            //! The byte class of every byte value. Class 0 holds all bytes which occur in no term
+            U8 m_byteClasses[256];
+
+            //! The number of byte classes
+            U32 m_numClasses;
+
+            //! The number of states of the automaton
+            U32 m_numStates;
+
+            //! The transition table: m_numStates rows of m_numClasses entries each.
+            //!
+            //! An entry is the offset of the next state's row (next state * m_numClasses), ORed with MATCH_FLAG if the
+            //! next state completes a term. The row of the start state is at offset 0.
+            std::vector<U32> m_transitions;
+
+            //! Folds the case of an ASCII letter if m_ignoreCase
+            U8 foldCase(const U8 character) const;
+    };
+}
+
+#endif
@@ -0,0 +1,203 @@
+// ======================================================================
+// \title  ByteClassModerationStrategy.cpp
+// \author Marius Baden
+// \brief  cpp file for the moderation strategy which screens SpacePosts for control characters and binary data
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#include <cstring>
+
+#include "ByteClassModerationStrategy.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace SpacePosts
+{
+    namespace
+    {
+        constexpr U8 CLASS_CONTROL = 0x1;
+        constexpr U8 CLASS_HIGH_BIT = 0x2;
+
+        // Byte classes of all 256 byte values for the scalar variant
+        struct ByteClassTable
+        {
+            U8 classes[256];
+
+            ByteClassTable() : classes()
+            {
+                for (U32 byte = 0; byte < 256; byte++)
+                {
+                    const bool whitespace = byte == '\t' || byte == '\n' || byte == '\r';
+                    if ((byte < 0x20 && !whitespace) || byte == 0x7F)
+                    {
+                        this->classes[byte] = CLASS_CONTROL;
+                    }
+                    else if (byte >= 0x80)
+                    {
+                        this->classes[byte] = CLASS_HIGH_BIT;
+                    }
+                }
+            }
+        };
+
+        const ByteClassTable BYTE_CLASS_TABLE{};
+
+#if defined(__AVX2__)
+        // Sums up the 32 byte-wise counters of a vector
+        U32 horizontalSum(const __m256i counters)
+        {
+            const __m256i sums = _mm256_sad_epu8(counters, _mm256_setzero_si256());
+            const __m128i half_sums = _mm_add_epi64(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1));
+            return static_cast<U32>(_mm_cvtsi128_si32(half_sums) + _mm_cvtsi128_si32(_mm_srli_si128(half_sums, 8)));
+        }
+#elif defined(__SSE2__)
+        // Sums up the 16 byte-wise counters of a vector
+        U32 horizontalSum(const __m128i counters)
+        {
+            const __m128i sums = _mm_sad_epu8(counters, _mm_setzero_si128());
+            return static_cast<U32>(_mm_cvtsi128_si32(sums) + _mm_cvtsi128_si32(_mm_srli_si128(sums, 8)));
+        }
+#endif
+    }
+
+    ByteClassModerationStrategy::ByteClassModerationStrategy(const U32 maxControlBytes, const U32 maxHighBitBytes)
+        : m_maxControlBytes(maxControlBytes),
+          m_maxHighBitBytes(maxHighBitBytes)
+    {
+    }
+
+    bool ByteClassModerationStrategy::checkMessage(const SpacePosts::SpacePost &message)
+    {
+        const Fw::StringBase &text = message.getmessage_content();
+        const ByteCounts counts = countByteClasses(reinterpret_cast<const U8 *>(text.toChar()), text.length());
+        return counts.control <= this->m_maxControlBytes && counts.highBit <= this->m_maxHighBitBytes;
+    }
+
+    ByteClassModerationStrategy::ByteCounts ByteClassModerationStrategy::countByteClasses(const U8 *const text,
+                                                                                          const U32 length)
+    {
+        /*
+         *  A compare yields 0xFF per matching byte, so subtracting it from a byte-wise accumulator counts the matches
+         *  without leaving the vector registers. The accumulators are summed up horizontally before they could
+         *  overflow, i.e., at the latest after 255 vectors. The bytes after the last full vector are copied into a
+         *  vector padded with spaces, which are printable and thus not counted.
+         *
+         *  The signed compare "< 0x20" also holds for high-bit bytes, so these are masked out of the control
+         *  characters. Tab, line feed, and carriage return are masked out as well, DEL is added.
+         */
+#if defined(__AVX2__)
+        constexpr U32 VECTOR_SIZE = 32;
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i space = _mm256_set1_epi8(0x20);
+        const __m256i tab = _mm256_set1_epi8('\t');
+        const __m256i line_feed = _mm256_set1_epi8('\n');
+        const __m256i carriage_return = _mm256_set1_epi8('\r');
+        const __m256i del = _mm256_set1_epi8(0x7F);
+
+        U32 control{0};
+        U32 high_bit{0};
+        U32 i{0};
+        while (i < length)
+        {
+            __m256i control_acc = zero;
+            __m256i high_bit_acc = zero;
+            for (U32 n = 0; n < 255 && i < length; n++, i += VECTOR_SIZE)
+            {
+                __m256i bytes;
+                if (i + VECTOR_SIZE <= length)
+                {
+                    bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(text + i));
+                }
+                else
+                {
+                    U8 padded[VECTOR_SIZE];
+                    (void)std::memset(padded, 0x20, VECTOR_SIZE);
+                    (void)std::memcpy(padded, text + i, length - i);
+                    bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(padded));
+                }
+                const __m256i high = _mm256_cmpgt_epi8(zero, bytes);
+                const __m256i whitespace = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(bytes, tab), _mm256_cmpeq_epi8(bytes, line_feed)),
+                    _mm256_cmpeq_epi8(bytes, carriage_return));
+                const __m256i ctrl = _mm256_or_si256(
+                    _mm256_andnot_si256(_mm256_or_si256(high, whitespace), _mm256_cmpgt_epi8(space, bytes)),
+                    _mm256_cmpeq_epi8(bytes, del));
+                control_acc = _mm256_sub_epi8(control_acc, ctrl);
+                high_bit_acc = _mm256_sub_epi8(high_bit_acc, high);
+            }
+            control += horizontalSum(control_acc);
+            high_bit += horizontalSum(high_bit_acc);
+        }
+        return ByteCounts{control, high_bit};
+#elif defined(__SSE2__)
+        constexpr U32 VECTOR_SIZE = 16;
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i space = _mm_set1_epi8(0x20);
+        const __m128i tab = _mm_set1_epi8('\t');
+        const __m128i line_feed = _mm_set1_epi8('\n');
+        const __m128i carriage_return = _mm_set1_epi8('\r');
+        const __m128i del = _mm_set1_epi8(0x7F);
+
+        U32 control{0};
+        U32 high_bit{0};
+        U32 i{0};
+        while (i < length)
+        {
+            __m128i control_acc = zero;
+            __m128i high_bit_acc = zero;
+            for (U32 n = 0; n < 255 && i < length; n++, i += VECTOR_SIZE)
+            {
+                __m128i bytes;
+                if (i + VECTOR_SIZE <= length)
+                {
+                    bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + i));
+                }
+                else
+                {
+                    U8 padded[VECTOR_SIZE];
+                    (void)std::memset(padded, 0x20, VECTOR_SIZE);
+                    (void)std::memcpy(padded, text + i, length - i);
+                    bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(padded));
+                }
+                const __m128i high = _mm_cmplt_epi8(bytes, zero);
+                const __m128i whitespace =
+                    _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(bytes, tab), _mm_cmpeq_epi8(bytes, line_feed)),
+                                 _mm_cmpeq_epi8(bytes, carriage_return));
+                const __m128i ctrl =
+                    _mm_or_si128(_mm_andnot_si128(_mm_or_si128(high, whitespace), _mm_cmplt_epi8(bytes, space)),
+                                 _mm_cmpeq_epi8(bytes, del));
+                control_acc = _mm_sub_epi8(control_acc, ctrl);
+                high_bit_acc = _mm_sub_epi8(high_bit_acc, high);
+            }
+            control += horizontalSum(control_acc);
+            high_bit += horizontalSum(high_bit_acc);
+        }
+        return ByteCounts{control, high_bit};
+#else
+        return countByteClassesScalar(text, length);
+#endif
+    }
+
+    ByteClassModerationStrategy::ByteCounts ByteClassModerationStrategy::countByteClassesScalar(const U8 *const text,
+                                                                                                const U32 length)
+    {
+        U32 control{0};
+        U32 high_bit{0};
+        for (U32 i = 0; i < length; i++)
+        {
+            const U8 byte_class = BYTE_CLASS_TABLE.classes[text[i]];
+            control += byte_class & CLASS_CONTROL;
+            high_bit += byte_class >> 1;
+        }
+        return ByteCounts{control, high_bit};
+    }
+}
@@ -0,0 +1,94 @@
+// ======================================================================
+// \title  ByteClassModerationStrategy.hpp
+// \author Marius Baden
+// \brief  hpp file for the moderation strategy which screens SpacePosts for control characters and binary data
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#ifndef ByteClassModerationStrategy_HPP
+#define ByteClassModerationStrategy_HPP
+
+#include "Fw/Types/BasicTypes.hpp"
+#include "SpacePosts/MessageTypes/SpacePostSerializableAc.hpp"
+#include "ModerationStrategy.hpp"
+
+namespace SpacePosts
+{
+    /**
+     * @brief Moderation strategy which rejects SpacePosts that look like binary noise or control character spam
+     *
+     * Every byte of the message content is classified as either printable, a control character, or a byte with the
+     * high bit set. Tab, line feed, and carriage return count as printable. A SpacePost is rejected if it has more
+     * control characters or more high-bit bytes than allowed.
+     *
+     * The bytes are classified 32 (AVX2) or 16 (SSE2) at a time with vector compares, depending on the instruction
+     * set the build targets. Other targets classify them one at a time with a lookup table. All variants count the
+     * same. The check is cheap enough to run before any expensive moderation strategy.
+     */
+    class ByteClassModerationStrategy final : public ModerationStrategy
+    {
+        public:
+
+            //! The number of bytes of each class in a text
+            struct ByteCounts
+            {
+                U32 control;  //!< Control characters except tab, line feed, and carriage return; and DEL
+                U32 highBit;  //!< Bytes from 0x80 to 0xFF, e.g., UTF-8 sequences or binary data
+            };
+
+            /**
+             * @brief Constructs the strategy with the given thresholds
+             *
+             * @param maxControlBytes The maximum number of control characters an accepted SpacePost may contain
+             * @param maxHighBitBytes The maximum number of high-bit bytes an accepted SpacePost may contain
+             */
+            ByteClassModerationStrategy(const U32 maxControlBytes, const U32 maxHighBitBytes);
+
+            /**
+             * @brief Rejects the SpacePost iff its message content exceeds any of the thresholds
+             *
+             * @param message the SpacePost to check
+             * @return true if the message is within the thresholds, false otherwise
+             */
+            bool checkMessage(
+                const SpacePosts::SpacePost &message /*!< the SpacePost to check */
+            ) override;
+
+            /**
+             * @brief Counts the bytes of each class in the given text with the fastest variant of the build target
+             *
+             * @param text The text to classify
+             * @param length The number of bytes of text
+             * @return The number of bytes of each class
+             */
+            static ByteCounts countByteClasses(const U8 *const text, const U32 length);
+
+            /**
+             * @brief Counts the bytes of each class in the given text one byte at a time
+             *
+             * Used by countByteClasses on targets without SSE2, e.g., the ARM flight computer. The vectorized variants
+             * do not call it for the bytes after the last full vector but pad them to a full vector. Also the reference
+             * which the unit tests and the benchmark compare the vectorized variants with.
+             *
+             * @param text The text to classify
+             * @param length The number of bytes of text
+             * @return The number of bytes of each class
+             */
+            static ByteCounts countByteClassesScalar(const U8 *const text, const U32 length);
+
+        private:
+
+            //! The maximum number of control characters an accepted SpacePost may contain
+            const U32 m_maxControlBytes;
+
+            //! The maximum number of high-bit bytes an accepted SpacePost may contain
+            const U32 m_maxHighBitBytes;
+    };
+}
+
+#endif
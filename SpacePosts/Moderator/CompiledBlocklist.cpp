@@ -0,0 +1,180 @@
+// ======================================================================
+// \title  CompiledBlocklist.cpp
+// \author Marius Baden
+// \brief  cpp file for a blocklist automaton memory-mapped from a compiled blocklist file
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <config/ModeratorCfg.hpp>
+#include "CompiledBlocklist.hpp"
+#include "AhoCorasickModerationStrategy.hpp"
+#include "Fw/Types/Assert.hpp"
+
+namespace SpacePosts
+{
+    namespace
+    {
+        // Byte offsets of the parts of a compiled blocklist file
+        constexpr size_t BYTE_CLASSES_OFFSET = CompiledBlocklist::HEADER_WORDS * sizeof(U32);
+        constexpr size_t TRANSITIONS_OFFSET = BYTE_CLASSES_OFFSET + 256;
+    }
+
+    CompiledBlocklist::CompiledBlocklist()
+        : m_mapping(nullptr),
+          m_mappedSize(0),
+          m_byteClasses(nullptr),
+          m_transitions(nullptr),
+          m_numStates(0)
+    {
+    }
+
+    CompiledBlocklist::~CompiledBlocklist()
+    {
+        this->unload();
+    }
+
+    bool CompiledBlocklist::load(const char *const path, SpacePosts::BlocklistFileError &stage, I32 &errorCode)
+    {
+        this->unload();
+
+        const int fd = ::open(path, O_RDONLY);
+        if (fd < 0)
+        {
+            stage = SpacePosts::BlocklistFileError::OPEN;
+            errorCode = errno;
+            return false;
+        }
+
+        struct stat file_stat{};
+        if (::fstat(fd, &file_stat) != 0)
+        {
+            stage = SpacePosts::BlocklistFileError::SIZE;
+            errorCode = errno;
+            (void)::close(fd);
+            return false;
+        }
+        if (file_stat.st_size < static_cast<off_t>(TRANSITIONS_OFFSET))
+        {
+            stage = SpacePosts::BlocklistFileError::SIZE;
+            errorCode = static_cast<I32>(file_stat.st_size);
+            (void)::close(fd);
+            return false;
+        }
+        const size_t size = static_cast<size_t>(file_stat.st_size);
+
+        void *const mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        const int map_errno = errno;
+        // The mapping stays valid after closing the file
+        (void)::close(fd);
+        if (mapping == MAP_FAILED)
+        {
+            stage = SpacePosts::BlocklistFileError::MAP;
+            errorCode = map_errno;
+            return false;
+        }
+
+        const U8 *const data = static_cast<const U8 *>(mapping);
+        const I32 invalid_offset = validate(data, size);
+        if (invalid_offset >= 0)
+        {
+            (void)::munmap(mapping, size);
+            stage = SpacePosts::BlocklistFileError::CONTENT;
+            errorCode = invalid_offset;
+            return false;
+        }
+
+        this->m_mapping = mapping;
+        this->m_mappedSize = size;
+        this->m_byteClasses = data + BYTE_CLASSES_OFFSET;
+        this->m_transitions = reinterpret_cast<const U32 *>(data + TRANSITIONS_OFFSET);
+        this->m_numStates = reinterpret_cast<const U32 *>(data)[3];
+        return true;
+    }
+
+    void CompiledBlocklist::unload()
+    {
+        if (this->m_mapping != nullptr)
+        {
+            (void)::munmap(this->m_mapping, this->m_mappedSize);
+        }
+        this->m_mapping = nullptr;
+        this->m_mappedSize = 0;
+        this->m_byteClasses = nullptr;
+        this->m_transitions = nullptr;
+        this->m_numStates = 0;
+    }
+
+    bool CompiledBlocklist::isLoaded() const
+    {
+        return this->m_mapping != nullptr;
+    }
+
+    bool CompiledBlocklist::containsPattern(const U8 *const text, const U32 length) const
+    {
+        FW_ASSERT(this->m_mapping != nullptr);
+        return AhoCorasickModerationStrategy::containsPattern(this->m_transitions, this->m_byteClasses, text, length);
+    }
+
+    U32 CompiledBlocklist::getNumStates() const
+    {
+        return this->m_numStates;
+    }
+
+    I32 CompiledBlocklist::validate(const U8 *const data, const size_t size)
+    {
+        // mmap returns page-aligned memory and all parts start at multiples of 4 bytes, so the words can be read
+        // in place
+        const U32 *const header = reinterpret_cast<const U32 *>(data);
+        if (header[0] != MODERATOR_BLOCKLIST_FILE_MAGIC)
+        {
+            return 0;
+        }
+        if (header[1] != MODERATOR_BLOCKLIST_FILE_VERSION)
+        {
+            return sizeof(U32);
+        }
+        const U32 num_classes = header[2];
+        if (num_classes == 0 || num_classes > 256)
+        {
+            return 2 * sizeof(U32);
+        }
+        const U32 num_states = header[3];
+        const U64 num_entries = static_cast<U64>(num_states) * num_classes;
+        if (num_states == 0 || num_entries >= AhoCorasickModerationStrategy::MATCH_FLAG ||
+            size != TRANSITIONS_OFFSET + num_entries * sizeof(U32))
+        {
+            return 3 * sizeof(U32);
+        }
+
+        for (U32 byte = 0; byte < 256; byte++)
+        {
+            if (data[BYTE_CLASSES_OFFSET + byte] >= num_classes)
+            {
+                return static_cast<I32>(BYTE_CLASSES_OFFSET + byte);
+            }
+        }
+
+        // Every entry must be the start of a row of the table
+        const U32 *const transitions = reinterpret_cast<const U32 *>(data + TRANSITIONS_OFFSET);
+        for (U64 i = 0; i < num_entries; i++)
+        {
+            const U32 row = transitions[i] & ~AhoCorasickModerationStrategy::MATCH_FLAG;
+            if (row >= num_entries || row % num_classes != 0)
+            {
+                return static_cast<I32>(TRANSITIONS_OFFSET + i * sizeof(U32));
+            }
+        }
+        return -1;
+    }
+}
@@ -0,0 +1,111 @@
+// ======================================================================
+// \title  CompiledBlocklist.hpp
+// \author Marius Baden
+// \brief  hpp file for a blocklist automaton memory-mapped from a compiled blocklist file
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#ifndef CompiledBlocklist_HPP
+#define CompiledBlocklist_HPP
+
+#include <cstddef>
+
+#include "Fw/Types/BasicTypes.hpp"
+#include "SpacePosts/Moderator/BlocklistFileErrorEnumAc.hpp"
+
+namespace SpacePosts
+{
+    /**
+     * @brief Aho-Corasick automaton of a blocklist, memory-mapped read-only from a compiled blocklist file
+     *
+     * The file is written by AhoCorasickModerationStrategy::serialize on the ground. It consists of, in the byte
+     * order of the flight computer:
+     *  - a header of HEADER_WORDS U32s: MODERATOR_BLOCKLIST_FILE_MAGIC, MODERATOR_BLOCKLIST_FILE_VERSION, the
+     *    number of byte classes C, and the number of states S (see ModeratorCfg.hpp)
+     *  - the byte class of every byte value (256 U8s)
+     *  - the transition table (S * C U32s) as in AhoCorasickModerationStrategy
+     *
+     * The automaton is used right from the mapping, so loading it needs no heap memory. Every word is validated
+     * before the automaton is used, so a corrupt file cannot make a check read outside the mapping. Validating
+     * reads the whole file, which also faults in all pages of the mapping before it is used.
+     */
+    class CompiledBlocklist
+    {
+        public:
+
+            //! The number of U32s in the header of a compiled blocklist file
+            static constexpr U32 HEADER_WORDS = 4;
+
+            //! Constructs an unloaded blocklist
+            CompiledBlocklist();
+
+            //! Unmaps the loaded file, if any
+            ~CompiledBlocklist();
+
+            /**
+             * @brief Maps and validates the given compiled blocklist file, after unloading the current one
+             *
+             * @param path The path of the file
+             * @param stage Set to the stage which failed if loading fails
+             * @param errorCode Set to an additional error code of the failed stage: the errno of a failed system
+             *                  call, the file size if it is too small, or the byte offset of the first invalid word
+             * @return true iff the file has been loaded
+             */
+            bool load(const char *const path, SpacePosts::BlocklistFileError &stage, I32 &errorCode);
+
+            //! Unmaps the loaded file, if any
+            void unload();
+
+            //! Whether a file is loaded
+            bool isLoaded() const;
+
+            /**
+             * @brief Checks whether any term of the loaded blocklist occurs in the given text
+             *
+             * @param text The text to check
+             * @param length The number of characters of text
+             * @return true iff at least one term occurs in text. Must only be called if a file is loaded
+             */
+            bool containsPattern(const U8 *const text, const U32 length) const;
+
+            //! The number of states of the loaded automaton
+            U32 getNumStates() const;
+
+        private:
+
+            //! The mapping of the loaded file. nullptr if none is loaded
+            void *m_mapping;
+
+            //! The number of bytes of m_mapping
+            size_t m_mappedSize;
+
+            //! The byte classes within m_mapping
+            const U8 *m_byteClasses;
+
+            //! The transition table within m_mapping
+            const U32 *m_transitions;
+
+            //! The number of states of the loaded automaton
+            U32 m_numStates;
+
+            // The mapping is owned by exactly one object
+            CompiledBlocklist(const CompiledBlocklist &) = delete;
+            CompiledBlocklist &operator=(const CompiledBlocklist &) = delete;
+
+            /**
+             * @brief Checks that the mapped data is a complete automaton which only refers to its own states
+             *
+             * @param data The mapped data
+             * @param size The number of bytes of data
+             * @return -1 if the data is valid, else the byte offset of the first invalid word
+             */
+            static I32 validate(const U8 *const data, const size_t size);
+    };
+}
+
+#endif
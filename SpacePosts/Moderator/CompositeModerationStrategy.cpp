@@ -0,0 +1,163 @@
+// ======================================================================
+// \title  CompositeModerationStrategy.cpp
+// \author Marius Baden
+// \brief  cpp file for the moderation strategy which chains multiple strategies in an adaptive order
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#include <chrono>
+
+#include <config/ModeratorCfg.hpp>
+#include "CompositeModerationStrategy.hpp"
+
+namespace SpacePosts
+{
+    CompositeModerationStrategy::CompositeModerationStrategy()
+        : m_links(),
+          m_numLinks(0),
+          m_order(),
+          m_checksSinceReorder(0),
+          m_checksSinceSample(0)
+    {
+    }
+
+    bool CompositeModerationStrategy::addStrategy(ModerationStrategy &strategy, const bool pinned)
+    {
+        if (this->m_numLinks >= MAX_STRATEGIES)
+        {
+            return false;
+        }
+
+        this->m_links[this->m_numLinks] = Link{};
+        this->m_links[this->m_numLinks].strategy = &strategy;
+        this->m_links[this->m_numLinks].pinned = pinned;
+        this->m_order[this->m_numLinks] = this->m_numLinks;
+        ++this->m_numLinks;
+        return true;
+    }
+
+    bool CompositeModerationStrategy::checkMessage(const SpacePosts::SpacePost &message)
+    {
+        const bool timed = ++this->m_checksSinceSample >= MODERATOR_COMPOSITE_COST_SAMPLE_INTERVAL;
+        if (timed)
+        {
+            this->m_checksSinceSample = 0;
+        }
+
+        bool accepted{true};
+        for (U8 i = 0; i < this->m_numLinks && accepted; ++i)
+        {
+            Link &link = this->m_links[this->m_order[i]];
+
+            if (timed)
+            {
+                const auto start = std::chrono::steady_clock::now();
+                accepted = link.strategy->checkMessage(message);
+                const auto end = std::chrono::steady_clock::now();
+
+                const U64 cost_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+                link.costNs += cost_ns;
+                ++link.costSamples;
+                link.recentCostNs += cost_ns;
+                link.recentCostSamples += 1.0;
+            }
+            else
+            {
+                accepted = link.strategy->checkMessage(message);
+            }
+
+            ++link.checks;
+            link.recentChecks += 1.0;
+            if (!accepted)
+            {
+                ++link.rejections;
+                link.recentRejections += 1.0;
+            }
+        }
+
+        if (++this->m_checksSinceReorder >= MODERATOR_COMPOSITE_REORDER_INTERVAL)
+        {
+            this->m_checksSinceReorder = 0;
+            this->reorder();
+        }
+
+        return accepted;
+    }
+
+    U8 CompositeModerationStrategy::getStatistics(SpacePosts::ModerationStrategyStats_Array &stats) const
+    {
+        for (U8 position = 0; position < MAX_STRATEGIES; ++position)
+        {
+            if (position >= this->m_numLinks)
+            {
+                stats[position] = SpacePosts::ModerationStrategyStats{};
+                continue;
+            }
+
+            const U8 index = this->m_order[position];
+            const Link &link = this->m_links[index];
+            const U32 avg_cost_ns = (link.costSamples == 0) ? 0 : static_cast<U32>(link.costNs / link.costSamples);
+            stats[index] = SpacePosts::ModerationStrategyStats{position, link.checks, link.rejections, avg_cost_ns};
+        }
+        return this->m_numLinks;
+    }
+
+    void CompositeModerationStrategy::reorder()
+    {
+        // Insertion sort, which keeps the order of equally good strategies. The chain is short. Pinned strategies
+        // never move, so they split the chain into segments which are sorted separately
+        U8 segment_start{0};
+        for (U8 i = 0; i < this->m_numLinks; ++i)
+        {
+            const U8 index = this->m_order[i];
+            if (this->m_links[index].pinned)
+            {
+                segment_start = i + 1;
+                continue;
+            }
+
+            U8 j = i;
+            while (j > segment_start && runsBefore(this->m_links[index], this->m_links[this->m_order[j - 1]]))
+            {
+                this->m_order[j] = this->m_order[j - 1];
+                --j;
+            }
+            this->m_order[j] = index;
+        }
+
+        for (U8 i = 0; i < this->m_numLinks; ++i)
+        {
+            Link &link = this->m_links[i];
+            link.recentChecks /= 2.0;
+            link.recentRejections /= 2.0;
+            link.recentCostNs /= 2.0;
+            link.recentCostSamples /= 2.0;
+        }
+    }
+
+    bool CompositeModerationStrategy::runsBefore(const Link &first, const Link &second)
+    {
+        // A strategy which has not been timed yet is assumed to be free, so it runs early and gets timed
+        const F64 first_cost = (first.recentCostSamples == 0.0) ? 0.0 : first.recentCostNs / first.recentCostSamples;
+        const F64 second_cost =
+            (second.recentCostSamples == 0.0) ? 0.0 : second.recentCostNs / second.recentCostSamples;
+
+        if (first.recentRejections == 0.0 || second.recentRejections == 0.0)
+        {
+            if (first.recentRejections != second.recentRejections)
+            {
+                return second.recentRejections == 0.0;
+            }
+            return first_cost < second_cost;
+        }
+
+        // cost / rejection rate = cost * checks / rejections, compared without dividing
+        return first_cost * first.recentChecks * second.recentRejections <
+               second_cost * second.recentChecks * first.recentRejections;
+    }
+}
@@ -0,0 +1,135 @@
+// ======================================================================
+// \title  CompositeModerationStrategy.hpp
+// \author Marius Baden
+// \brief  hpp file for the moderation strategy which chains multiple strategies in an adaptive order
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#ifndef CompositeModerationStrategy_HPP
+#define CompositeModerationStrategy_HPP
+
+#include "Fw/Types/BasicTypes.hpp"
+#include "SpacePosts/MessageTypes/SpacePostSerializableAc.hpp"
+#include "SpacePosts/Moderator/FppConstantsAc.hpp"
+#include "ModerationStrategy.hpp"
+
+namespace SpacePosts
+{
+    /**
+     * @brief Moderation strategy which accepts a SpacePost iff all of its chained strategies accept it
+     *
+     * The chain stops at the first strategy which rejects the SpacePost. The chain measures the time each strategy
+     * takes and how often it rejects, and reorders the strategies every MODERATOR_COMPOSITE_REORDER_INTERVAL checks
+     * (see ModeratorCfg.hpp). Strategies with a low time per rejection, i.e., cheap and highly selective ones, run
+     * first.
+     *
+     * For stateless strategies, the order decides how much time the chain takes, but not whether it accepts a
+     * SpacePost. A stateful strategy (e.g., the RepetitionModerationStrategy) decides based on the SpacePosts it has
+     * checked before, i.e., the ones all strategies before it accepted. Thus, moving it changes what the chain
+     * accepts. Such a strategy must be added pinned: it keeps its position and no strategy is moved across it. The
+     * strategies before it are only reordered among each other, which does not change which SpacePosts reach it.
+     *
+     * The chain does not allocate memory. It holds references to the strategies, which must outlive it.
+     */
+    class CompositeModerationStrategy final : public ModerationStrategy
+    {
+        public:
+
+            //! Constructs an empty chain, which accepts every SpacePost
+            CompositeModerationStrategy();
+
+            /**
+             * @brief Appends a strategy to the chain
+             *
+             * Must be called before the first check. The chain starts in the order in which the strategies are added.
+             *
+             * @param strategy The strategy to append
+             * @param pinned Whether the strategy keeps its position and no strategy is moved across it. Required for
+             * strategies whose decision depends on the SpacePosts they checked before
+             * @return true iff the strategy was added. False if the chain already has Moderator_MaxChainedStrategies
+             */
+            bool addStrategy(ModerationStrategy &strategy, const bool pinned = false);
+
+            /**
+             * @brief Accepts the SpacePost iff all strategies of the chain accept it
+             *
+             * @param message the SpacePost to check
+             * @return true if the message is acceptable, false if it is inappropriate
+             */
+            bool checkMessage(
+                const SpacePosts::SpacePost &message /*!< the SpacePost to check */
+            ) override;
+
+            /**
+             * @brief Reports the statistics of each strategy of the chain, in the order in which they were added
+             *
+             * @param stats Filled with the statistics of each strategy. Unused entries are zero
+             * @return The number of strategies in the chain
+             */
+            U8 getStatistics(
+                SpacePosts::ModerationStrategyStats_Array &stats /*!< the statistics of each individual strategy */
+            ) const override;
+
+        private:
+
+            static constexpr U8 MAX_STRATEGIES =
+                FppConstant_Moderator_MaxChainedStrategies::Moderator_MaxChainedStrategies;
+
+            //! A strategy of the chain with its statistics
+            struct Link
+            {
+                ModerationStrategy *strategy;
+
+                // Whether the strategy keeps its position in the order
+                bool pinned;
+
+                // Totals since construction, reported as telemetry
+                U32 checks;
+                U32 rejections;
+                U64 costNs;
+                U32 costSamples;
+
+                // Basis of the order. Halved at every reordering so that recent checks weigh more
+                F64 recentChecks;
+                F64 recentRejections;
+                F64 recentCostNs;
+                F64 recentCostSamples;
+            };
+
+            //! The strategies in the order in which they were added
+            Link m_links[MAX_STRATEGIES];
+
+            //! The number of strategies in the chain
+            U8 m_numLinks;
+
+            //! The indices in m_links in the order in which the strategies run
+            U8 m_order[MAX_STRATEGIES];
+
+            //! The number of checks since the last reordering
+            U32 m_checksSinceReorder;
+
+            //! The number of checks since the last timed check
+            U32 m_checksSinceSample;
+
+            /**
+             * @brief Sorts the strategies between pinned ones by their recent time per rejection and halves their recent
+             * statistics
+             */
+            void reorder();
+
+            /**
+             * @brief Whether the first strategy runs before the second, i.e., has a lower recent time per rejection
+             *
+             * Strategies which have not rejected a SpacePost recently sort after all others, by their recent time
+             * per check.
+             */
+            static bool runsBefore(const Link &first, const Link &second);
+    };
+}
+
+#endif
@@ -1,9 +1,8 @@
 #ifndef ConcreteModerationStrategyExample_HPP
 #define ConcreteModerationStrategyExample_HPP
 
-#include "ConcreteModerationStrategyExample.hpp"
+#include "SpacePosts/MessageTypes/SpacePostSerializableAc.hpp"
 #include "ModerationStrategy.hpp"
-#include "Moderator.hpp"
 
 namespace SpacePosts
 {
@@ -12,7 +11,7 @@ namespace SpacePosts
      * 
      * This is just an example. It does not implement any moderation criteria. 
      */
-    class ConcreteModerationStrategyExample : ModerationStrategy
+    class ConcreteModerationStrategyExample : public ModerationStrategy
     {
         public:
             virtual bool checkMessage(
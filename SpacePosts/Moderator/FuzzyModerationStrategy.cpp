@@ -0,0 +1,166 @@
+// ======================================================================
+// \title  FuzzyModerationStrategy.cpp
+// \author Marius Baden
+// \brief  cpp file for the moderation strategy which rejects SpacePosts containing obfuscated blocklist terms
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#include <cstring>
+
+#include "FuzzyModerationStrategy.hpp"
+#include "Fw/Types/Assert.hpp"
+#include "SpacePosts/MessageTypes/FppConstantsAc.hpp"
+
+namespace SpacePosts
+{
+    namespace
+    {
+        constexpr U32 MAX_TEXT_LENGTH = FppConstant_SpacePost_MaxTextLength::SpacePost_MaxTextLength;
+
+        // Character classes of normalized texts
+        constexpr U8 SPACE_CLASS = 1;
+        constexpr U8 FIRST_LETTER_CLASS = 2;
+        constexpr U8 FIRST_DIGIT_CLASS = FIRST_LETTER_CLASS + 26;
+
+        // Characters which stand for a letter in leetspeak and the letter they stand for
+        constexpr char LEET_CHARACTERS[] = "0134578@$!|";
+        constexpr char LEET_LETTERS[] = "oieastbasil";
+    }
+
+    FuzzyModerationStrategy::FuzzyModerationStrategy(const U32 maxEdits)
+        : m_maxEdits(maxEdits),
+          m_foldTable(),
+          m_terms()
+    {
+        (void)std::memset(this->m_foldTable, DROPPED, sizeof(this->m_foldTable));
+        for (U32 letter = 0; letter < 26; letter++)
+        {
+            this->m_foldTable['a' + letter] = static_cast<U8>(FIRST_LETTER_CLASS + letter);
+            this->m_foldTable['A' + letter] = static_cast<U8>(FIRST_LETTER_CLASS + letter);
+        }
+        this->m_foldTable['2'] = FIRST_DIGIT_CLASS;
+        this->m_foldTable['6'] = FIRST_DIGIT_CLASS + 1;
+        this->m_foldTable['9'] = FIRST_DIGIT_CLASS + 2;
+        for (U32 i = 0; i < sizeof(LEET_CHARACTERS) - 1; i++)
+        {
+            this->m_foldTable[static_cast<U8>(LEET_CHARACTERS[i])] =
+                static_cast<U8>(FIRST_LETTER_CLASS + LEET_LETTERS[i] - 'a');
+        }
+        this->m_foldTable[' '] = SPACE_CLASS;
+        this->m_foldTable['\t'] = SPACE_CLASS;
+        this->m_foldTable['\n'] = SPACE_CLASS;
+        this->m_foldTable['\r'] = SPACE_CLASS;
+        static_assert(FIRST_DIGIT_CLASS + 3 == NUM_CLASSES, "Every character class must have a bit mask");
+    }
+
+    bool FuzzyModerationStrategy::addTerm(const char *const term, const U32 length)
+    {
+        std::vector<U8> normalized(length);
+        const U32 normalized_length = this->normalize(reinterpret_cast<const U8 *>(term), length, normalized.data());
+        if (normalized_length <= this->m_maxEdits || normalized_length > MAX_TERM_LENGTH)
+        {
+            return false;
+        }
+
+        Term prepared{};
+        for (U32 i = 0; i < normalized_length; i++)
+        {
+            prepared.positions[normalized[i]] |= static_cast<U64>(1) << i;
+        }
+        prepared.lastBit = static_cast<U64>(1) << (normalized_length - 1);
+        prepared.length = normalized_length;
+        this->m_terms.push_back(prepared);
+        return true;
+    }
+
+    bool FuzzyModerationStrategy::checkMessage(const SpacePosts::SpacePost &message)
+    {
+        const Fw::StringBase &text = message.getmessage_content();
+        return !this->containsTerm(reinterpret_cast<const U8 *>(text.toChar()), text.length());
+    }
+
+    bool FuzzyModerationStrategy::containsTerm(const U8 *const text, const U32 length) const
+    {
+        FW_ASSERT(length <= MAX_TEXT_LENGTH, length);
+
+        // Normalize once for all terms
+        U8 normalized[MAX_TEXT_LENGTH];
+        const U32 normalized_length = this->normalize(text, length, normalized);
+
+        for (const Term &term : this->m_terms)
+        {
+            if (this->matchesTerm(term, normalized, normalized_length))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    U32 FuzzyModerationStrategy::normalize(const U8 *const text, const U32 length, U8 *const normalized) const
+    {
+        U32 normalized_length{0};
+        U8 previous{DROPPED};
+        for (U32 i = 0; i < length; i++)
+        {
+            const U8 character_class = this->m_foldTable[text[i]];
+            // Dropped characters do not separate repeated characters, e.g., "l.l" is collapsed to "l"
+            if (character_class != DROPPED && character_class != previous)
+            {
+                normalized[normalized_length++] = character_class;
+                previous = character_class;
+            }
+        }
+        return normalized_length;
+    }
+
+    U32 FuzzyModerationStrategy::getNumTerms() const
+    {
+        return static_cast<U32>(this->m_terms.size());
+    }
+
+    bool FuzzyModerationStrategy::matchesTerm(const Term &term, const U8 *const normalized, const U32 length) const
+    {
+        /*
+         *  Myers' algorithm: bit i of the vertical deltas tells whether the edit distance between the first i + 1
+         *  characters of the term and the best substring ending at the current text position is one more (vp) or
+         *  one less (vn) than for the first i characters. A match may start anywhere in the text, so the distance
+         *  for the empty prefix stays 0 and no horizontal delta enters at the bottom bit.
+         */
+        U64 vp{~static_cast<U64>(0)};
+        U64 vn{0};
+        U32 distance{term.length};
+        for (U32 i = 0; i < length; i++)
+        {
+            const U64 equal = term.positions[normalized[i]];
+            const U64 xv = equal | vn;
+            const U64 xh = (((equal & vp) + vp) ^ vp) | equal;
+            U64 hp = vn | ~(xh | vp);
+            U64 hn = vp & xh;
+
+            if (hp & term.lastBit)
+            {
+                ++distance;
+            }
+            else if (hn & term.lastBit)
+            {
+                --distance;
+            }
+            if (distance <= this->m_maxEdits)
+            {
+                return true;
+            }
+
+            hp <<= 1;
+            hn <<= 1;
+            vp = hn | ~(xv | hp);
+            vn = hp & xv;
+        }
+        return false;
+    }
+}
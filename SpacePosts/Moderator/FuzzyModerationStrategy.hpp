@@ -0,0 +1,135 @@
+// ======================================================================
+// \title  FuzzyModerationStrategy.hpp
+// \author Marius Baden
+// \brief  hpp file for the moderation strategy which rejects SpacePosts containing obfuscated blocklist terms
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#ifndef FuzzyModerationStrategy_HPP
+#define FuzzyModerationStrategy_HPP
+
+#include <vector>
+
+#include "Fw/Types/BasicTypes.hpp"
+#include "SpacePosts/MessageTypes/SpacePostSerializableAc.hpp"
+#include "ModerationStrategy.hpp"
+
+namespace SpacePosts
+{
+    /**
+     * @brief Moderation strategy which rejects SpacePosts containing a term of a blocklist up to a number of edits
+     *
+     * Texts and terms are normalized before matching, so that common obfuscations do not need edits:
+     *  - ASCII letters are folded to lowercase
+     *  - Leetspeak digits and symbols are folded to the letters they stand for, e.g., "h3ll0" to "hello"
+     *  - Whitespace is folded to a single space. All other characters (punctuation, control and high-bit bytes)
+     *    are dropped, e.g., "s.p.a.m" to "spam"
+     *  - Repeated characters are collapsed, e.g., "heeellooo" to "helo"
+     * All of this is done with one lookup in a 256-entry folding table per byte.
+     *
+     * A SpacePost is rejected if its normalized text contains a substring within maxEdits insertions, deletions, or
+     * substitutions of a normalized term. Each term is matched with Myers' bit-parallel algorithm, which keeps a
+     * column of the edit distance matrix in two machine words. A check thus takes time linear in the length of the
+     * message per term, no matter how many edits are allowed.
+     */
+    class FuzzyModerationStrategy final : public ModerationStrategy
+    {
+        public:
+
+            //! The maximum length of a normalized term, i.e., the number of bits of a machine word
+            static constexpr U32 MAX_TERM_LENGTH = 64;
+
+            /**
+             * @brief Constructs the strategy without terms
+             *
+             * @param maxEdits The maximum edit distance at which a substring of the text matches a term
+             */
+            explicit FuzzyModerationStrategy(const U32 maxEdits);
+
+            /**
+             * @brief Adds a term to the blocklist
+             *
+             * @param term The term. It is normalized as the texts are
+             * @param length The number of characters of term
+             * @return true iff the term has been added. Terms whose normalized length is at most maxEdits (they
+             *         would match every text) or more than MAX_TERM_LENGTH are not added
+             */
+            bool addTerm(const char *const term, const U32 length);
+
+            /**
+             * @brief Rejects the SpacePost iff its message content contains any term within maxEdits edits
+             *
+             * @param message the SpacePost to check
+             * @return true if the message is acceptable, false if it contains a term
+             */
+            bool checkMessage(
+                const SpacePosts::SpacePost &message /*!< the SpacePost to check */
+            ) override;
+
+            /**
+             * @brief Checks whether the normalized text contains any term within maxEdits edits
+             *
+             * @param text The text to check
+             * @param length The number of characters of text. At most SpacePost_MaxTextLength
+             * @return true iff at least one term occurs in text
+             */
+            bool containsTerm(const U8 *const text, const U32 length) const;
+
+            /**
+             * @brief Normalizes a text (see class description)
+             *
+             * @param text The text to normalize
+             * @param length The number of characters of text
+             * @param normalized The buffer to write the normalized text to, as character classes. At least length
+             *                   bytes
+             * @return The number of characters of the normalized text
+             */
+            U32 normalize(const U8 *const text, const U32 length, U8 *const normalized) const;
+
+            //! The number of terms in the blocklist
+            U32 getNumTerms() const;
+
+        private:
+
+            //! Character class of dropped characters in the folding table
+            static constexpr U8 DROPPED = 0;
+
+            //! The number of character classes of normalized texts: dropped, space, the letters, and the digits
+            //! 2, 6, and 9, which stand for no letter
+            static constexpr U32 NUM_CLASSES = 31;
+
+            //! A normalized term prepared for Myers' algorithm
+            struct Term
+            {
+                //! Per character class, the positions in the term at which it occurs as a bit mask
+                U64 positions[NUM_CLASSES];
+
+                //! The bit of the last position of the term
+                U64 lastBit;
+
+                //! The number of characters of the normalized term
+                U32 length;
+            };
+
+            //! The maximum edit distance at which a substring of the text matches a term
+            const U32 m_maxEdits;
+
+            //! The character class of every byte value
+            U8 m_foldTable[256];
+
+            //! The terms of the blocklist
+            std::vector<Term> m_terms;
+
+            /**
+             * @brief Checks whether the normalized text contains the term within m_maxEdits edits
+             */
+            bool matchesTerm(const Term &term, const U8 *const normalized, const U32 length) const;
+    };
+}
+
+#endif
@@ -0,0 +1,52 @@
+// ======================================================================
+// \title  LatencyHistogram.cpp
+// \author Marius Baden
+// \brief  cpp file for the histogram of latencies the Moderator reports as telemetry
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#include "LatencyHistogram.hpp"
+
+namespace SpacePosts
+{
+    LatencyHistogram::LatencyHistogram()
+        : m_counts(),
+          m_max(0)
+    {
+    }
+
+    void LatencyHistogram::record(const U64 latencyNs)
+    {
+        U32 bucket{0};
+        U64 bound = static_cast<U64>(1) << MODERATOR_LATENCY_FIRST_BUCKET_LOG2_NS;
+        while (bucket < NUM_BUCKETS - 1 && latencyNs >= bound)
+        {
+            ++bucket;
+            bound <<= 1;
+        }
+        ++this->m_counts[bucket];
+
+        const U32 latency = (latencyNs < 0xFFFFFFFF) ? static_cast<U32>(latencyNs) : 0xFFFFFFFF;
+        this->m_max = (latency > this->m_max) ? latency : this->m_max;
+    }
+
+    const SpacePosts::LatencyHistogram_Array &LatencyHistogram::getCounts() const
+    {
+        return this->m_counts;
+    }
+
+    U32 LatencyHistogram::getMax() const
+    {
+        return this->m_max;
+    }
+
+    void LatencyHistogram::resetMax()
+    {
+        this->m_max = 0;
+    }
+}
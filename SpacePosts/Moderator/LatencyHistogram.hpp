@@ -0,0 +1,67 @@
+// ======================================================================
+// \title  LatencyHistogram.hpp
+// \author Marius Baden
+// \brief  hpp file for the histogram of latencies the Moderator reports as telemetry
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#ifndef LatencyHistogram_HPP
+#define LatencyHistogram_HPP
+
+#include <config/ModeratorCfg.hpp>
+#include "Fw/Types/BasicTypes.hpp"
+#include "SpacePosts/Moderator/FppConstantsAc.hpp"
+#include "SpacePosts/Moderator/LatencyHistogram_ArrayArrayAc.hpp"
+
+namespace SpacePosts
+{
+    /**
+     * @brief Counts latencies in buckets whose bounds double from one bucket to the next
+     *
+     * Bucket 0 counts latencies below 2^MODERATOR_LATENCY_FIRST_BUCKET_LOG2_NS nanoseconds (see ModeratorCfg.hpp).
+     * Each following bucket counts latencies up to twice the bound of the one before. The last bucket counts all
+     * longer latencies. Thus, the histogram covers several orders of magnitude with Moderator_LatencyBuckets
+     * counters and records a latency in constant time.
+     */
+    class LatencyHistogram
+    {
+        public:
+
+            //! The number of buckets
+            static constexpr U32 NUM_BUCKETS = FppConstant_Moderator_LatencyBuckets::Moderator_LatencyBuckets;
+
+            //! Constructs an empty histogram
+            LatencyHistogram();
+
+            /**
+             * @brief Counts a latency
+             *
+             * @param latencyNs The latency in nanoseconds
+             */
+            void record(const U64 latencyNs);
+
+            //! The counts of all buckets since construction. Counts wrap around at the maximum value of U32
+            const SpacePosts::LatencyHistogram_Array &getCounts() const;
+
+            //! The longest latency recorded since the last call of resetMax, in nanoseconds. Saturates at MAX_U32
+            U32 getMax() const;
+
+            //! Starts the next period for getMax
+            void resetMax();
+
+        private:
+
+            //! The counts of all buckets
+            SpacePosts::LatencyHistogram_Array m_counts;
+
+            //! The longest latency recorded since the last call of resetMax, in nanoseconds
+            U32 m_max;
+    };
+}
+
+#endif
@@ -1,6 +1,9 @@
 #ifndef ModerationStrategy_HPP
 #define ModerationStrategy_HPP
 
+#include "Fw/Types/BasicTypes.hpp"
+#include "SpacePosts/Moderator/ModerationStrategyStats_ArrayArrayAc.hpp"
+
 namespace SpacePosts
 {
     /**
@@ -33,6 +36,23 @@ namespace SpacePosts
             virtual bool checkMessage(
                 const SpacePosts::SpacePost &message /*!< the SpacePost to check */
             ) = 0;
+
+            /**
+             * @brief Reports runtime statistics of the individual strategies this strategy consists of
+             *
+             * Only implemented by strategies which combine multiple strategies, e.g., the CompositeModerationStrategy.
+             * The Moderator component writes the reported statistics as telemetry.
+             *
+             * @param stats Filled with the statistics of each individual strategy
+             * @return The number of valid entries in stats. 0 if the strategy does not report statistics
+             */
+            virtual U8 getStatistics(
+                SpacePosts::ModerationStrategyStats_Array &stats /*!< the statistics of each individual strategy */
+            ) const
+            {
+                (void)stats;
+                return 0;
+            }
     };
     
 }
@@ -18,6 +18,9 @@
 namespace SpacePosts
 {
 
+  // The port handlers are implemented in StrategyModerator.hpp
+  template class StrategyModerator<ModerationStrategy>;
+
   // ----------------------------------------------------------------------
   // Construction, initialization, and destruction
   // ----------------------------------------------------------------------
@@ -25,16 +28,9 @@ namespace SpacePosts
   Moderator ::
       Moderator(
           const char *const compName,
-          ModerationStrategy &moderationStrategy) : ModeratorComponentBase(compName),
-                                                    m_moderationStrategy(moderationStrategy)
-  {
-  }
-
-  void Moderator ::
-      init(
-          const NATIVE_INT_TYPE instance)
+          ModerationStrategy &moderationStrategy) : StrategyModerator<ModerationStrategy>(compName,
+                                                                                          moderationStrategy)
   {
-    ModeratorComponentBase::init(instance);
   }
 
   Moderator ::
@@ -42,28 +38,4 @@ namespace SpacePosts
   {
   }
 
-  // ----------------------------------------------------------------------
-  // Handler implementations for user-defined typed input ports
-  // ----------------------------------------------------------------------
-
-  SpacePosts::MessageStorageStatus Moderator ::
-      moderateMessage_handler(
-          const NATIVE_INT_TYPE portNum,
-          const SpacePosts::SpacePost &data)
-  {
-    if (this->m_moderationStrategy.checkMessage(data))
-    {
-      return this->acceptedMessage_out(0, data);
-    }
-    else
-    {
-      this->log_ACTIVITY_HI_MESSAGE_REJECTED();
-
-      // Return no error so that the behavior for a component using the input port is the same no matter whether
-      // a Moderator is used inbetween two components' SpacePostSet ports (e.g. Transceiver and MessageStorage)
-      // or not.
-      return SpacePosts::MessageStorageStatus::OK;
-    }
-  }
-
 } // end namespace SpacePosts
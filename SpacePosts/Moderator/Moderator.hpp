@@ -15,22 +15,25 @@
 
 #include "SpacePosts/Moderator/ModeratorComponentAc.hpp"
 #include "ModerationStrategy.hpp"
+#include "StrategyModerator.hpp"
 
 namespace SpacePosts
 {
 
-  class Moderator : public ModeratorComponentBase
+  // Compiled once in Moderator.cpp
+  extern template class StrategyModerator<ModerationStrategy>;
+
+  //! Moderator component which uses any implementation of the ModerationStrategy interface
+  //!
+  //! The components uses the strategy design pattern. An object which implements the `ModerationStrategy`
+  //! strategy interface can be injected into the component in its constructor. The `ModerationStrategy`
+  //! interface requires a single method, which has the signature `bool checkMessage(SpacePost message)`.
+  //!
+  //! The strategy is called via virtual dispatch. To bind a concrete strategy at compile time instead, use
+  //! StrategyModerator with the strategy's type.
+  class Moderator : public StrategyModerator<ModerationStrategy>
   {
 
-    PRIVATE :
-
-        //! The moderation strategy to use to decide whether to forward or discard a SpacePost
-        //!
-        //! The components uses the strategy design pattern. An object which implements the `ModerationStrategy`
-        //! strategy interface can be injected into the component in its constructor. The `ModerationStrategy`
-        //! interface requires a single method, which has the signature `bool checkMessage(SpacePost message)`.
-        ModerationStrategy &m_moderationStrategy;
-
     public:
       // ----------------------------------------------------------------------
       // Construction, initialization, and destruction
@@ -44,31 +47,9 @@ namespace SpacePosts
                                                             or discard a SpacePost*/
       );
 
-      //! Initialize object Moderator
-      //!
-      void init(
-          const NATIVE_INT_TYPE instance = 0 /*!< The instance number*/
-      );
-
       //! Destroy object Moderator
       //!
       ~Moderator();
-
-    PRIVATE :
-
-        // ----------------------------------------------------------------------
-        // Handler implementations for user-defined typed input ports
-        // ----------------------------------------------------------------------
-
-        //! Handler implementation for moderateMessage
-        //!
-        SpacePosts::MessageStorageStatus
-        moderateMessage_handler(
-            const NATIVE_INT_TYPE portNum, /*!< The port number*/
-            const SpacePosts::SpacePost &data    /*!<
-           the SpacePost to store
-           */
-        );
   };
 
 } // end namespace SpacePosts
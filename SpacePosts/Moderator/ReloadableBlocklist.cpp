@@ -0,0 +1,85 @@
+// ======================================================================
+// \title  ReloadableBlocklist.cpp
+// \author Marius Baden
+// \brief  cpp file for a compiled blocklist which can be replaced while SpacePosts are checked against it
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#include <thread>
+
+#include "ReloadableBlocklist.hpp"
+
+namespace SpacePosts
+{
+    ReloadableBlocklist::ReloadableBlocklist()
+        : m_slots(),
+          m_published(NO_SLOT),
+          m_readers()
+    {
+        this->m_readers[0].store(0);
+        this->m_readers[1].store(0);
+    }
+
+    bool ReloadableBlocklist::containsPattern(const U8 *const text, const U32 length)
+    {
+        U32 slot = this->m_published.load();
+        while (true)
+        {
+            if (slot == NO_SLOT)
+            {
+                return false;
+            }
+
+            // Register before using the slot. If a reload has published the other slot in the meantime, the
+            // reload may not have seen this check and may unload the slot. Retry with the new one
+            this->m_readers[slot].fetch_add(1);
+            const U32 published = this->m_published.load();
+            if (published == slot)
+            {
+                break;
+            }
+            this->m_readers[slot].fetch_sub(1);
+            slot = published;
+        }
+
+        const bool contains = this->m_slots[slot].containsPattern(text, length);
+        this->m_readers[slot].fetch_sub(1);
+        return contains;
+    }
+
+    bool ReloadableBlocklist::reload(const char *const path, SpacePosts::BlocklistFileError &stage, I32 &errorCode)
+    {
+        const U32 previous = this->m_published.load();
+        const U32 next = (previous == 0) ? 1 : 0;
+
+        // No check uses the unpublished slot: the previous reload waited for the checks which did, and a check
+        // which registers for it now finds it unpublished and retries
+        if (!this->m_slots[next].load(path, stage, errorCode))
+        {
+            return false;
+        }
+        this->m_published.store(next);
+
+        if (previous != NO_SLOT)
+        {
+            // Grace period: checks which registered before the switch are still running on the previous slot
+            while (this->m_readers[previous].load() != 0)
+            {
+                std::this_thread::yield();
+            }
+            this->m_slots[previous].unload();
+        }
+        return true;
+    }
+
+    U32 ReloadableBlocklist::getNumStates() const
+    {
+        const U32 slot = this->m_published.load();
+        return (slot == NO_SLOT) ? 0 : this->m_slots[slot].getNumStates();
+    }
+}
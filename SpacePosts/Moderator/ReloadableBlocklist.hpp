@@ -0,0 +1,82 @@
+// ======================================================================
+// \title  ReloadableBlocklist.hpp
+// \author Marius Baden
+// \brief  hpp file for a compiled blocklist which can be replaced while SpacePosts are checked against it
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#ifndef ReloadableBlocklist_HPP
+#define ReloadableBlocklist_HPP
+
+#include <atomic>
+
+#include "Fw/Types/BasicTypes.hpp"
+#include "CompiledBlocklist.hpp"
+
+namespace SpacePosts
+{
+    /**
+     * @brief Compiled blocklist which can be reloaded from a file while other threads check texts against it
+     *
+     * The blocklist has two slots. The published slot is used by the checks. A reload loads the file into the
+     * other slot and publishes it with an atomic store (read-copy-update). Afterwards, it waits until no check
+     * uses the previous slot anymore and only then unloads it (deferred reclamation). Checks thus never wait for
+     * a reload, never take a lock, and never allocate memory. Each slot counts the checks which use it, so the
+     * reload only waits for the checks that started before the switch.
+     *
+     * Any number of threads can check concurrently. Reloads must not run concurrently with each other.
+     */
+    class ReloadableBlocklist
+    {
+        public:
+
+            //! Constructs a blocklist without terms
+            ReloadableBlocklist();
+
+            /**
+             * @brief Checks whether any term of the published blocklist occurs in the given text
+             *
+             * @param text The text to check
+             * @param length The number of characters of text
+             * @return true iff at least one term occurs in text. false if no blocklist has been loaded
+             */
+            bool containsPattern(const U8 *const text, const U32 length);
+
+            /**
+             * @brief Loads the given compiled blocklist file and publishes it in place of the current one
+             *
+             * Blocks until the previous blocklist is no longer used. If loading fails, the current blocklist stays
+             * published.
+             *
+             * @param path The path of the file
+             * @param stage Set to the stage which failed if loading fails
+             * @param errorCode Set to an additional error code of the failed stage (see CompiledBlocklist::load)
+             * @return true iff the file has been loaded and published
+             */
+            bool reload(const char *const path, SpacePosts::BlocklistFileError &stage, I32 &errorCode);
+
+            //! The number of states of the published automaton. 0 if no blocklist has been loaded
+            U32 getNumStates() const;
+
+        private:
+
+            //! Value of m_published while no blocklist has been loaded
+            static constexpr U32 NO_SLOT = 2;
+
+            //! The published blocklist and the one which has been or will be replaced
+            CompiledBlocklist m_slots[2];
+
+            //! The index of the slot used by checks, or NO_SLOT
+            std::atomic<U32> m_published;
+
+            //! The number of checks using each slot
+            std::atomic<U32> m_readers[2];
+    };
+}
+
+#endif
@@ -0,0 +1,147 @@
+// ======================================================================
+// \title  RepetitionModerationStrategy.cpp
+// \author Marius Baden
+// \brief  cpp file for the moderation strategy which rejects SpacePosts repeated too often within a time window
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#include <chrono>
+#include <cstring>
+
+#include "Fw/Types/Assert.hpp"
+#include "RepetitionModerationStrategy.hpp"
+
+static_assert((MODERATOR_REPETITION_FILTER_SIZE & (MODERATOR_REPETITION_FILTER_SIZE - 1)) == 0,
+              "MODERATOR_REPETITION_FILTER_SIZE must be a power of two");
+
+namespace SpacePosts
+{
+    namespace
+    {
+        constexpr U64 FNV_OFFSET_BASIS = 0xCBF29CE484222325ULL;
+        constexpr U64 FNV_PRIME = 0x100000001B3ULL;
+
+        // FNV-1a hash of the text with the case of ASCII letters ignored and all ASCII characters which are no
+        // letters or digits skipped. Bytes of non-ASCII characters are kept, so that texts in other scripts do not
+        // all hash alike. Returns false if no character is left, i.e., there is no text to compare
+        bool hashNormalized(const U8 *const text, const U32 length, U64 &hash)
+        {
+            hash = FNV_OFFSET_BASIS;
+            bool hashed{false};
+            for (U32 i = 0; i < length; i++)
+            {
+                U8 character = text[i];
+                if (character >= 'A' && character <= 'Z')
+                {
+                    character = character - 'A' + 'a';
+                }
+                else if (character < 0x80 &&
+                         !((character >= 'a' && character <= 'z') || (character >= '0' && character <= '9')))
+                {
+                    continue;
+                }
+                hash = (hash ^ character) * FNV_PRIME;
+                hashed = true;
+            }
+            return hashed;
+        }
+    }
+
+    RepetitionModerationStrategy::RepetitionModerationStrategy(const U32 windowSeconds, const U32 maxCopies)
+        : m_generationMs(static_cast<U64>(windowSeconds) * 1000 / MODERATOR_REPETITION_GENERATIONS),
+          m_maxCopies(maxCopies),
+          m_counters(),
+          m_currentGeneration(0),
+          m_generationStartMs(0),
+          m_started(false)
+    {
+        FW_ASSERT(this->m_generationMs > 0, windowSeconds);
+    }
+
+    bool RepetitionModerationStrategy::checkMessage(const SpacePosts::SpacePost &message)
+    {
+        const U64 now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                               std::chrono::steady_clock::now().time_since_epoch())
+                               .count();
+        const Fw::StringBase &text = message.getmessage_content();
+        return this->countCopy(reinterpret_cast<const U8 *>(text.toChar()), text.length(), now_ms) <=
+               this->m_maxCopies;
+    }
+
+    U32 RepetitionModerationStrategy::countCopy(const U8 *const text, const U32 length, const U64 nowMs)
+    {
+        this->rotate(nowMs);
+
+        // Texts of punctuation and spacing only would all be copies of each other
+        U64 hash{0};
+        if (!hashNormalized(text, length, hash))
+        {
+            return 0;
+        }
+
+        // Double hashing: the k-th counter is at h1 + k * h2. An odd h2 reaches every counter of the filter
+        const U32 hash1 = static_cast<U32>(hash);
+        const U32 hash2 = static_cast<U32>(hash >> 32) | 1;
+        U32 positions[MODERATOR_REPETITION_NUM_HASHES];
+        for (U32 k = 0; k < MODERATOR_REPETITION_NUM_HASHES; k++)
+        {
+            positions[k] = (hash1 + k * hash2) & (MODERATOR_REPETITION_FILTER_SIZE - 1);
+        }
+
+        U8 *const current = this->m_counters[this->m_currentGeneration];
+        for (U32 k = 0; k < MODERATOR_REPETITION_NUM_HASHES; k++)
+        {
+            if (current[positions[k]] < 0xFF)
+            {
+                ++current[positions[k]];
+            }
+        }
+
+        // The count of a text in a generation is the smallest of its counters, because other texts can only have
+        // incremented them further
+        U32 copies{0};
+        for (U32 generation = 0; generation < MODERATOR_REPETITION_GENERATIONS; generation++)
+        {
+            const U8 *const counters = this->m_counters[generation];
+            U8 count{0xFF};
+            for (U32 k = 0; k < MODERATOR_REPETITION_NUM_HASHES; k++)
+            {
+                count = (counters[positions[k]] < count) ? counters[positions[k]] : count;
+            }
+            copies += count;
+        }
+        return copies;
+    }
+
+    void RepetitionModerationStrategy::rotate(const U64 nowMs)
+    {
+        if (!this->m_started)
+        {
+            this->m_started = true;
+            this->m_generationStartMs = nowMs;
+            return;
+        }
+
+        const U64 elapsed_ms = nowMs - this->m_generationStartMs;
+        if (elapsed_ms < this->m_generationMs)
+        {
+            return;
+        }
+
+        // Skip generations in which nothing was counted. After the whole window, all generations are cleared
+        const U64 num_generations = elapsed_ms / this->m_generationMs;
+        const U64 num_cleared = (num_generations < MODERATOR_REPETITION_GENERATIONS) ? num_generations
+                                                                                     : MODERATOR_REPETITION_GENERATIONS;
+        for (U64 i = 0; i < num_cleared; i++)
+        {
+            this->m_currentGeneration = (this->m_currentGeneration + 1) % MODERATOR_REPETITION_GENERATIONS;
+            (void)std::memset(this->m_counters[this->m_currentGeneration], 0, MODERATOR_REPETITION_FILTER_SIZE);
+        }
+        this->m_generationStartMs += num_generations * this->m_generationMs;
+    }
+}
@@ -0,0 +1,99 @@
+// ======================================================================
+// \title  RepetitionModerationStrategy.hpp
+// \author Marius Baden
+// \brief  hpp file for the moderation strategy which rejects SpacePosts repeated too often within a time window
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#ifndef RepetitionModerationStrategy_HPP
+#define RepetitionModerationStrategy_HPP
+
+#include <config/ModeratorCfg.hpp>
+#include "Fw/Types/BasicTypes.hpp"
+#include "SpacePosts/MessageTypes/SpacePostSerializableAc.hpp"
+#include "ModerationStrategy.hpp"
+
+namespace SpacePosts
+{
+    /**
+     * @brief Moderation strategy which rejects copies of a SpacePost beyond a threshold within a time window
+     *
+     * Two SpacePosts count as copies if their normalized message contents are equal. Normalizing ignores the case
+     * of ASCII letters and all ASCII characters which are no letters or digits, so that spammers cannot evade the
+     * check by changing punctuation or spacing. Non-ASCII characters are compared as they are. SpacePosts which are
+     * empty after normalizing are neither counted nor rejected.
+     *
+     * The SpacePosts of the time window are counted in MODERATOR_REPETITION_GENERATIONS counting Bloom filters of
+     * fixed size, each of which covers an equal part of the window (see ModeratorCfg.hpp). When the oldest filter
+     * has left the window, it is cleared and counts the newest SpacePosts. Thus, the strategy needs neither heap
+     * memory nor time proportional to the number of SpacePosts in the window. Like any Bloom filter, it can count
+     * different SpacePosts as copies of each other, but never misses a copy.
+     *
+     * Every checked SpacePost is counted, including rejected ones, so a continuing flood stays rejected.
+     */
+    class RepetitionModerationStrategy final : public ModerationStrategy
+    {
+        public:
+
+            /**
+             * @brief Constructs the strategy with empty filters
+             *
+             * @param windowSeconds The length of the time window in which copies are counted. Must be positive
+             * @param maxCopies The maximum number of copies of a SpacePost accepted within the window
+             */
+            RepetitionModerationStrategy(const U32 windowSeconds, const U32 maxCopies);
+
+            /**
+             * @brief Rejects the SpacePost iff more than maxCopies copies of it were checked within the time window
+             *
+             * @param message the SpacePost to check
+             * @return true if the message is acceptable, false if it is a copy beyond the threshold
+             */
+            bool checkMessage(
+                const SpacePosts::SpacePost &message /*!< the SpacePost to check */
+            ) override;
+
+            /**
+             * @brief Counts a text at the given time and returns how often it has been counted within the window
+             *
+             * @param text The message content
+             * @param length The number of characters of text
+             * @param nowMs The current time in milliseconds of a monotonic clock
+             * @return The number of copies of text in the window, including this one. Can be too high, never too low.
+             * 0 if the normalized text is empty, which is not counted
+             */
+            U32 countCopy(const U8 *const text, const U32 length, const U64 nowMs);
+
+        private:
+
+            //! The length of the time each generation covers, in milliseconds
+            const U64 m_generationMs;
+
+            //! The maximum number of copies of a SpacePost accepted within the window
+            const U32 m_maxCopies;
+
+            //! The counting Bloom filters of all generations. Counters saturate at 255
+            U8 m_counters[MODERATOR_REPETITION_GENERATIONS][MODERATOR_REPETITION_FILTER_SIZE];
+
+            //! The generation which counts the newest SpacePosts
+            U32 m_currentGeneration;
+
+            //! The time at which the current generation started counting, in milliseconds
+            U64 m_generationStartMs;
+
+            //! False until the first SpacePost has been counted
+            bool m_started;
+
+            /**
+             * @brief Clears the generations which have left the window and starts new ones up to the given time
+             */
+            void rotate(const U64 nowMs);
+    };
+}
+
+#endif
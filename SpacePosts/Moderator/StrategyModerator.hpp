@@ -0,0 +1,619 @@
+// ======================================================================
+// \title  StrategyModerator.hpp
+// \author Marius Baden
+// \brief  hpp file for the Moderator component implementation with a moderation strategy bound at compile time
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#ifndef StrategyModerator_HPP
+#define StrategyModerator_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <type_traits>
+
+#include <config/ModeratorCfg.hpp>
+#include "Fw/Types/BasicTypes.hpp"
+#include "SpacePosts/Moderator/ModeratorComponentAc.hpp"
+#include "SpacePosts/MessageTypes/CompactSpacePostBatch.hpp"
+#include "SpacePosts/MessageTypes/FppConstantsAc.hpp"
+#include "LatencyHistogram.hpp"
+#include "ModerationStrategy.hpp"
+#include "ReloadableBlocklist.hpp"
+#include "UplinkRateLimiter.hpp"
+#include "Utf8Validator.hpp"
+
+namespace SpacePosts
+{
+
+  //! Calls the methods of a moderation strategy of type Strategy
+  //!
+  //! If Strategy is a concrete type, the calls name its methods explicitly. They are thus not dispatched virtually and
+  //! the compiler can inline them. If Strategy is abstract (e.g., the ModerationStrategy interface), they are
+  //! dispatched virtually to the object's actual type.
+  //!
+  //! A concrete Strategy must be final. A qualified call runs Strategy's own method even if the object is of a derived
+  //! type which overrides it, so a derived strategy would silently be skipped.
+  template <typename Strategy, bool = std::is_abstract<Strategy>::value>
+  struct StrategyDispatch
+  {
+    static_assert(std::is_final<Strategy>::value || std::is_abstract<Strategy>::value,
+                  "A concrete moderation strategy must be final to be called without virtual dispatch");
+
+    static bool checkMessage(Strategy &strategy, const SpacePosts::SpacePost &message)
+    {
+      return strategy.Strategy::checkMessage(message);
+    }
+
+    static U8 getStatistics(const Strategy &strategy, SpacePosts::ModerationStrategyStats_Array &stats)
+    {
+      return strategy.Strategy::getStatistics(stats);
+    }
+  };
+
+  template <typename Strategy>
+  struct StrategyDispatch<Strategy, true>
+  {
+    static bool checkMessage(Strategy &strategy, const SpacePosts::SpacePost &message)
+    {
+      return strategy.checkMessage(message);
+    }
+
+    static U8 getStatistics(const Strategy &strategy, SpacePosts::ModerationStrategyStats_Array &stats)
+    {
+      return strategy.getStatistics(stats);
+    }
+  };
+
+  //! Implementation of the Moderator component for moderation strategies of type Strategy
+  //!
+  //! The strategy of a flight build is fixed when the topology is constructed. Instantiating this template with the
+  //! concrete strategy type (e.g., `StrategyModerator<CompositeModerationStrategy>`) binds the strategy at compile
+  //! time, so its checks are called without virtual dispatch and can be inlined into the port handlers.
+  //!
+  //! The `Moderator` component is this template instantiated with the `ModerationStrategy` interface. It accepts
+  //! any strategy at runtime, e.g., test doubles.
+  //!
+  //! Strategy must provide the methods of the ModerationStrategy interface. It does not need to derive from it. It
+  //! must be abstract or final (see StrategyDispatch).
+  template <typename Strategy>
+  class StrategyModerator : public ModeratorComponentBase
+  {
+
+    PRIVATE :
+
+        //! The moderation strategy to use to decide whether to forward or discard a SpacePost
+        Strategy &m_moderationStrategy;
+
+        //! Sheds SpacePosts beyond the UPLINK_RATE_LIMIT before they are checked
+        UplinkRateLimiter m_rateLimiter;
+
+        //! Blocklist loaded with the RELOAD_BLOCKLIST command. Checked before the moderation strategy
+        ReloadableBlocklist m_blocklist;
+
+        //! The number of SpacePosts which passed the moderation check
+        U32 m_acceptCount;
+
+        //! The number of SpacePosts which failed the moderation check
+        U32 m_rejectCount;
+
+        //! The time the moderation checks take
+        LatencyHistogram m_checkLatency;
+
+        //! The time the calls of acceptedMessage and acceptedMessages take
+        LatencyHistogram m_downstreamLatency;
+
+        //! The accepted SpacePosts of the batch being moderated. Only used by moderateMessages_handler
+        CompactSpacePostBatch m_accepted;
+
+        //! The batch passed on to acceptedMessages, built from m_accepted. A member, so that moderating a batch does
+        //! not put another SpacePost_Batch on the stack. Only used by moderateMessages_handler
+        SpacePosts::SpacePost_Batch m_acceptedBatch;
+
+        //! The time of the last write of the telemetry, in microseconds
+        U64 m_lastTelemetryUs;
+
+        //! False until the telemetry has been written once
+        bool m_telemetryWritten;
+
+        //! Guards the rejected SpacePosts collected for the quarantine. Separate from the component's guard, so that
+        //! passing them on to the quarantine store does not block the moderation
+        std::mutex m_quarantineLock;
+
+        //! The rejected SpacePosts collected since the last call of quarantineSchedIn
+        CompactSpacePostBatch m_quarantine;
+
+        //! The batch passed on to quarantineMessages, built from m_quarantine. Only used by quarantineSchedIn
+        SpacePosts::SpacePost_Batch m_quarantineBatch;
+
+        //! The number of rejected SpacePosts which were not quarantined
+        std::atomic<U32> m_quarantineDrops;
+
+        //! The number of rejected SpacePosts the quarantine store has stored. Only used by quarantineSchedIn
+        U32 m_quarantineCount;
+
+    public:
+      // ----------------------------------------------------------------------
+      // Construction, initialization, and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object StrategyModerator
+      //!
+      StrategyModerator(
+          const char *const compName,  /*!< The component name*/
+          Strategy &moderationStrategy /*!< The moderation strategy to use to decide whether to forward
+                                                            or discard a SpacePost*/
+          ) : ModeratorComponentBase(compName),
+              m_moderationStrategy(moderationStrategy),
+              m_rateLimiter(),
+              m_blocklist(),
+              m_acceptCount(0),
+              m_rejectCount(0),
+              m_checkLatency(),
+              m_downstreamLatency(),
+              m_accepted(),
+              m_acceptedBatch(),
+              m_lastTelemetryUs(0),
+              m_telemetryWritten(false),
+              m_quarantineLock(),
+              m_quarantine(),
+              m_quarantineBatch(),
+              m_quarantineDrops(0),
+              m_quarantineCount(0)
+      {
+      }
+
+      //! Initialize object StrategyModerator
+      //!
+      void init(
+          const NATIVE_INT_TYPE instance = 0 /*!< The instance number*/
+      )
+      {
+        ModeratorComponentBase::init(instance);
+      }
+
+      //! Destroy object StrategyModerator
+      //!
+      virtual ~StrategyModerator()
+      {
+      }
+
+    PRIVATE :
+
+        // ----------------------------------------------------------------------
+        // Handler implementations for user-defined typed input ports
+        // ----------------------------------------------------------------------
+
+        //! Handler implementation for moderateMessage
+        //!
+        SpacePosts::MessageStorageStatus
+        moderateMessage_handler(
+            const NATIVE_INT_TYPE portNum,    /*!< The port number*/
+            const SpacePosts::SpacePost &data /*!<
+           the SpacePost to store
+           */
+        );
+
+        //! Handler implementation for moderateMessages
+        //!
+        //! Checks every message of the batch and passes the accepted ones on in a single call of acceptedMessages.
+        //! The statuses of the accepted messages are mapped back to their positions in the given batch. Rejected
+        //! messages are reported as OK, as in moderateMessage_handler.
+        U8 moderateMessages_handler(
+            const NATIVE_INT_TYPE portNum,                   /*!< The port number*/
+            const SpacePosts::SpacePost_Batch &data,         /*!< The SpacePosts to store */
+            SpacePosts::MessageStorageStatus_Batch &statuses /*!< The status of storing each SpacePost */
+        );
+
+        //! Handler implementation for quarantineSchedIn
+        //!
+        //! Takes the rejected SpacePosts collected since the last call and passes them on to quarantineMessages.
+        //! Runs on the thread of a low-priority rate group, concurrently with the moderation.
+        void quarantineSchedIn_handler(
+            const NATIVE_INT_TYPE portNum, /*!< The port number*/
+            NATIVE_UINT_TYPE context       /*!< The call order*/
+        );
+
+        // ----------------------------------------------------------------------
+        // Command handler implementations
+        // ----------------------------------------------------------------------
+
+        //! Implementation for RELOAD_BLOCKLIST command handler
+        //! Load the compiled blocklist file at the given path and check all subsequent SpacePosts against it
+        void RELOAD_BLOCKLIST_cmdHandler(
+            const FwOpcodeType opCode,    /*!< The opcode*/
+            const U32 cmdSeq,             /*!< The command sequence number*/
+            const Fw::CmdStringArg &path /*!< The absolute path of the compiled blocklist file*/
+        );
+
+        // ----------------------------------------------------------------------
+        // Helper methods
+        // ----------------------------------------------------------------------
+
+        //! Runs the moderation check on the SpacePost, counts and times it, and reports a rejection
+        //!
+        //! \return The SpacePost to pass on: message itself, or sanitized if its encoding has been sanitized.
+        //!         nullptr if the SpacePost is rejected
+        const SpacePosts::SpacePost *moderate(
+            const SpacePosts::SpacePost &message, /*!< The SpacePost to check */
+            SpacePosts::SpacePost &sanitized      /*!< Set to the sanitized SpacePost if bytes are replaced */
+        );
+
+        //! Validates the encoding of the SpacePost's message content as UTF8_POLICY demands
+        //!
+        //! \return The SpacePost to check further: message itself, or sanitized if bytes of message had to be
+        //!         replaced. nullptr if the SpacePost is rejected
+        const SpacePosts::SpacePost *screenEncoding(
+            const SpacePosts::SpacePost &message, /*!< The SpacePost to validate */
+            SpacePosts::SpacePost &sanitized      /*!< Set to the sanitized SpacePost if bytes are replaced */
+        );
+
+        //! Checks the SpacePost against the loaded blocklist and the moderation strategy
+        //!
+        //! \return true iff the SpacePost passes both
+        bool checkMessage(const SpacePosts::SpacePost &message);
+
+        //! Collects a rejected SpacePost for the quarantine if the quarantineMessages port is connected
+        //!
+        //! Counts it as dropped if the quarantine already holds a full batch
+        void quarantine(
+            const SpacePosts::SpacePost &message /*!< The rejected SpacePost as it was received */
+        );
+
+        //! Writes the statistics of the moderation strategy's individual strategies as telemetry, if it reports any
+        void writeStrategyStatistics();
+
+        //! Decides whether the UPLINK_RATE_LIMIT admits one more SpacePost to the moderation check
+        //!
+        //! \return true iff the SpacePost is admitted. A shed SpacePost is treated as rejected
+        bool admitMessage(
+            const U64 nowUs /*!< The current time in microseconds*/
+        );
+
+        //! Writes the number of admitted and shed SpacePosts in the current rate window as telemetry
+        void writeRateTelemetry();
+
+        //! Writes all telemetry if MODERATOR_TELEMETRY_INTERVAL_MS has passed since it was last written
+        void writeTelemetry(
+            const U64 nowUs /*!< The current time in microseconds*/
+        );
+
+        //! The current time in microseconds
+        U64 getTimeUs();
+
+        //! The time in nanoseconds which has passed since start
+        static U64 elapsedNs(const std::chrono::steady_clock::time_point start);
+  };
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for user-defined typed input ports
+  // ----------------------------------------------------------------------
+
+  template <typename Strategy>
+  SpacePosts::MessageStorageStatus StrategyModerator<Strategy> ::
+      moderateMessage_handler(
+          const NATIVE_INT_TYPE portNum,
+          const SpacePosts::SpacePost &data)
+  {
+    // Return no error for rejected and shed messages so that the behavior for a component using the input port is
+    // the same no matter whether a Moderator is used inbetween two components' SpacePostSet ports (e.g. Transceiver
+    // and MessageStorage) or not.
+    SpacePosts::MessageStorageStatus status{SpacePosts::MessageStorageStatus::OK};
+
+    // Shed load before spending time on the content
+    const U64 now_us = this->getTimeUs();
+    if (this->admitMessage(now_us))
+    {
+      SpacePosts::SpacePost sanitized{};
+      const SpacePosts::SpacePost *const accepted = this->moderate(data, sanitized);
+      if (accepted != nullptr)
+      {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        status = this->acceptedMessage_out(0, *accepted);
+        this->m_downstreamLatency.record(elapsedNs(start));
+      }
+    }
+
+    this->writeTelemetry(now_us);
+    return status;
+  }
+
+  template <typename Strategy>
+  U8 StrategyModerator<Strategy> ::
+      moderateMessages_handler(
+          const NATIVE_INT_TYPE portNum,
+          const SpacePosts::SpacePost_Batch &data,
+          SpacePosts::MessageStorageStatus_Batch &statuses)
+  {
+    const U8 num_messages = (data.getnumValidMessages() < SpacePost_Batch_Size) ? data.getnumValidMessages()
+                                                                               : SpacePost_Batch_Size;
+    const SpacePosts::SpacePost_Array &messages = data.getmessages();
+
+    // Position in data of each accepted message, to map the statuses back. The accepted messages are collected in
+    // the member m_accepted, which the component's guard protects
+    this->m_accepted.clear();
+    U8 accepted_positions[SpacePost_Batch_Size];
+    const U64 now_us = this->getTimeUs();
+    for (U8 i = 0; i < SpacePost_Batch_Size; ++i)
+    {
+      if (i >= num_messages)
+      {
+        statuses[i] = SpacePosts::MessageStorageStatus::ERROR;
+        continue;
+      }
+
+      // Rejected messages are reported as OK (see moderateMessage_handler). Accepted ones are overwritten below
+      statuses[i] = SpacePosts::MessageStorageStatus::OK;
+
+      // Shed load before spending time on the content
+      if (!this->admitMessage(now_us))
+      {
+        continue;
+      }
+
+      SpacePosts::SpacePost sanitized{};
+      const SpacePosts::SpacePost *const accepted = this->moderate(messages[i], sanitized);
+      if (accepted != nullptr)
+      {
+        accepted_positions[this->m_accepted.getNumPosts()] = i;
+        const bool appended = this->m_accepted.append(*accepted);
+        FW_ASSERT(appended, i);
+      }
+    }
+
+    const U8 num_accepted = this->m_accepted.getNumPosts();
+    if (num_accepted == 0)
+    {
+      this->writeTelemetry(now_us);
+      return num_messages;
+    }
+
+    this->m_accepted.toBatch(this->m_acceptedBatch);
+    SpacePosts::MessageStorageStatus_Batch accepted_statuses{};
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    const U8 num_stored = this->acceptedMessages_out(0, this->m_acceptedBatch, accepted_statuses);
+    this->m_downstreamLatency.record(elapsedNs(start));
+    this->writeTelemetry(now_us);
+    for (U8 i = 0; i < num_accepted; ++i)
+    {
+      statuses[accepted_positions[i]] = accepted_statuses[i];
+    }
+
+    // Rejected messages count as stored
+    return num_messages - num_accepted + num_stored;
+  }
+
+  template <typename Strategy>
+  void StrategyModerator<Strategy> ::
+      quarantineSchedIn_handler(
+          const NATIVE_INT_TYPE portNum,
+          NATIVE_UINT_TYPE context)
+  {
+    if (!this->isConnected_quarantineMessages_OutputPort(0))
+    {
+      return;
+    }
+
+    // Only drain the SpacePosts into the outgoing batch under the lock. Storing them takes long and must not block
+    // the moderation
+    U8 num_messages{0};
+    {
+      const std::lock_guard<std::mutex> lock(this->m_quarantineLock);
+      num_messages = this->m_quarantine.getNumPosts();
+      if (num_messages > 0)
+      {
+        this->m_quarantine.toBatch(this->m_quarantineBatch);
+        this->m_quarantine.clear();
+      }
+    }
+    if (num_messages == 0)
+    {
+      return;
+    }
+
+    // The quarantine store reports the reason for each SpacePost it failed to store in its own events
+    SpacePosts::MessageStorageStatus_Batch statuses{};
+    const U8 num_stored = this->quarantineMessages_out(0, this->m_quarantineBatch, statuses);
+    this->m_quarantineDrops += num_messages - num_stored;
+    this->m_quarantineCount += num_stored;
+    this->tlmWrite_QUARANTINE_COUNT(this->m_quarantineCount);
+  }
+
+  // ----------------------------------------------------------------------
+  // Command handler implementations
+  // ----------------------------------------------------------------------
+
+  template <typename Strategy>
+  void StrategyModerator<Strategy> ::
+      RELOAD_BLOCKLIST_cmdHandler(
+          const FwOpcodeType opCode,
+          const U32 cmdSeq,
+          const Fw::CmdStringArg &path)
+  {
+    // Runs on the thread of the command dispatcher. The port handlers keep checking against the previous blocklist
+    // until the new one is published
+    SpacePosts::BlocklistFileError stage{};
+    I32 error_code{0};
+    if (!this->m_blocklist.reload(path.toChar(), stage, error_code))
+    {
+      this->log_WARNING_LO_BLOCKLIST_FILE_ERROR(stage, error_code);
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+      return;
+    }
+
+    const Fw::LogStringArg path_arg{path.toChar()};
+    this->log_ACTIVITY_HI_BLOCKLIST_RELOADED(path_arg, this->m_blocklist.getNumStates());
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper methods
+  // ----------------------------------------------------------------------
+
+  template <typename Strategy>
+  const SpacePosts::SpacePost *StrategyModerator<Strategy> ::
+      moderate(const SpacePosts::SpacePost &message, SpacePosts::SpacePost &sanitized)
+  {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    const SpacePosts::SpacePost *const screened = this->screenEncoding(message, sanitized);
+    const bool accepted = screened != nullptr && this->checkMessage(*screened);
+    this->m_checkLatency.record(elapsedNs(start));
+
+    if (!accepted)
+    {
+      ++this->m_rejectCount;
+      this->log_ACTIVITY_HI_MESSAGE_REJECTED();
+      this->quarantine(message);
+      return nullptr;
+    }
+    ++this->m_acceptCount;
+    return screened;
+  }
+
+  template <typename Strategy>
+  const SpacePosts::SpacePost *StrategyModerator<Strategy> ::
+      screenEncoding(const SpacePosts::SpacePost &message, SpacePosts::SpacePost &sanitized)
+  {
+    Fw::ParamValid valid;
+    const SpacePosts::Utf8Policy policy = paramGet_UTF8_POLICY(valid);
+    FW_ASSERT(valid.e == Fw::ParamValid::VALID || valid.e == Fw::ParamValid::DEFAULT, valid.e);
+    if (policy.e == SpacePosts::Utf8Policy::ACCEPT)
+    {
+      return &message;
+    }
+
+    const Fw::StringBase &text = message.getmessage_content();
+    const U32 length = text.length();
+    if (Utf8Validator::isValid(reinterpret_cast<const U8 *>(text.toChar()), length))
+    {
+      return &message;
+    }
+    if (policy.e == SpacePosts::Utf8Policy::REJECT)
+    {
+      return nullptr;
+    }
+
+    // Sanitizing replaces bytes one by one, so the content keeps its length
+    char content[SpacePost_MaxCStrLength];
+    FW_ASSERT(length < sizeof(content), length);
+    (void)std::memcpy(content, text.toChar(), length);
+    content[length] = '\0';
+    const U32 replaced_bytes = Utf8Validator::sanitize(reinterpret_cast<U8 *>(content), length);
+    sanitized = SpacePosts::SpacePost{content};
+    this->log_ACTIVITY_LO_MESSAGE_SANITIZED(replaced_bytes);
+    return &sanitized;
+  }
+
+  template <typename Strategy>
+  bool StrategyModerator<Strategy> ::
+      checkMessage(const SpacePosts::SpacePost &message)
+  {
+    const Fw::StringBase &text = message.getmessage_content();
+    if (this->m_blocklist.containsPattern(reinterpret_cast<const U8 *>(text.toChar()), text.length()))
+    {
+      return false;
+    }
+    return StrategyDispatch<Strategy>::checkMessage(this->m_moderationStrategy, message);
+  }
+
+  template <typename Strategy>
+  void StrategyModerator<Strategy> ::
+      quarantine(const SpacePosts::SpacePost &message)
+  {
+    if (!this->isConnected_quarantineMessages_OutputPort(0))
+    {
+      return;
+    }
+
+    const std::lock_guard<std::mutex> lock(this->m_quarantineLock);
+    if (!this->m_quarantine.append(message))
+    {
+      ++this->m_quarantineDrops;
+    }
+  }
+
+  template <typename Strategy>
+  void StrategyModerator<Strategy> ::
+      writeStrategyStatistics()
+  {
+    SpacePosts::ModerationStrategyStats_Array stats{};
+    if (StrategyDispatch<Strategy>::getStatistics(this->m_moderationStrategy, stats) > 0)
+    {
+      this->tlmWrite_STRATEGY_STATS(stats);
+    }
+  }
+
+  template <typename Strategy>
+  bool StrategyModerator<Strategy> ::
+      admitMessage(const U64 nowUs)
+  {
+    Fw::ParamValid valid;
+    const U32 limit = paramGet_UPLINK_RATE_LIMIT(valid);
+    FW_ASSERT(valid.e == Fw::ParamValid::VALID || valid.e == Fw::ParamValid::DEFAULT, valid.e);
+    const U32 window = paramGet_UPLINK_RATE_WINDOW(valid);
+    FW_ASSERT(valid.e == Fw::ParamValid::VALID || valid.e == Fw::ParamValid::DEFAULT, valid.e);
+
+    return this->m_rateLimiter.admit(nowUs, window, limit);
+  }
+
+  template <typename Strategy>
+  void StrategyModerator<Strategy> ::
+      writeRateTelemetry()
+  {
+    this->tlmWrite_UPLINK_ADMIT_RATE(this->m_rateLimiter.getAdmittedInWindow());
+    this->tlmWrite_UPLINK_SHED_RATE(this->m_rateLimiter.getShedInWindow());
+  }
+
+  template <typename Strategy>
+  void StrategyModerator<Strategy> ::
+      writeTelemetry(const U64 nowUs)
+  {
+    // A time which went backwards also lets the telemetry be written, so it cannot get stuck
+    if (this->m_telemetryWritten && nowUs >= this->m_lastTelemetryUs &&
+        nowUs - this->m_lastTelemetryUs < static_cast<U64>(MODERATOR_TELEMETRY_INTERVAL_MS) * 1000)
+    {
+      return;
+    }
+    this->m_telemetryWritten = true;
+    this->m_lastTelemetryUs = nowUs;
+
+    this->tlmWrite_ACCEPT_COUNT(this->m_acceptCount);
+    this->tlmWrite_REJECT_COUNT(this->m_rejectCount);
+    this->tlmWrite_CHECK_LATENCY(this->m_checkLatency.getCounts());
+    this->tlmWrite_CHECK_LATENCY_MAX(this->m_checkLatency.getMax());
+    this->tlmWrite_DOWNSTREAM_LATENCY(this->m_downstreamLatency.getCounts());
+    this->tlmWrite_DOWNSTREAM_LATENCY_MAX(this->m_downstreamLatency.getMax());
+    this->m_checkLatency.resetMax();
+    this->m_downstreamLatency.resetMax();
+
+    this->writeRateTelemetry();
+    this->writeStrategyStatistics();
+    this->tlmWrite_QUARANTINE_DROPS(this->m_quarantineDrops.load());
+  }
+
+  template <typename Strategy>
+  U64 StrategyModerator<Strategy> ::
+      getTimeUs()
+  {
+    const Fw::Time now = this->getTime();
+    return static_cast<U64>(now.getSeconds()) * 1000000 + now.getUSeconds();
+  }
+
+  template <typename Strategy>
+  U64 StrategyModerator<Strategy> ::
+      elapsedNs(const std::chrono::steady_clock::time_point start)
+  {
+    return static_cast<U64>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+  }
+
+} // end namespace SpacePosts
+
+#endif
@@ -0,0 +1,102 @@
+// ======================================================================
+// \title  UplinkRateLimiter.cpp
+// \author Marius Baden
+// \brief  cpp file for the sliding-window counter which limits the number of SpacePosts the Moderator admits
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#include <cstring>
+
+#include "UplinkRateLimiter.hpp"
+
+namespace SpacePosts
+{
+    UplinkRateLimiter::UplinkRateLimiter()
+        : m_admitted(),
+          m_shed(),
+          m_admittedInWindow(0),
+          m_shedInWindow(0),
+          m_currentBucket(0),
+          m_bucketStartUs(0),
+          m_windowSeconds(0)
+    {
+    }
+
+    bool UplinkRateLimiter::admit(const U64 nowUs, const U32 windowSeconds, const U32 maxPerWindow)
+    {
+        if (windowSeconds == 0)
+        {
+            return true;
+        }
+
+        // A changed window or a time which went backwards invalidates the buckets
+        if (windowSeconds != this->m_windowSeconds || nowUs < this->m_bucketStartUs)
+        {
+            this->reset(nowUs, windowSeconds);
+        }
+        else
+        {
+            this->slide(nowUs);
+        }
+
+        if (maxPerWindow != 0 && this->m_admittedInWindow >= maxPerWindow)
+        {
+            ++this->m_shed[this->m_currentBucket];
+            ++this->m_shedInWindow;
+            return false;
+        }
+
+        ++this->m_admitted[this->m_currentBucket];
+        ++this->m_admittedInWindow;
+        return true;
+    }
+
+    U32 UplinkRateLimiter::getAdmittedInWindow() const
+    {
+        return this->m_admittedInWindow;
+    }
+
+    U32 UplinkRateLimiter::getShedInWindow() const
+    {
+        return this->m_shedInWindow;
+    }
+
+    void UplinkRateLimiter::reset(const U64 nowUs, const U32 windowSeconds)
+    {
+        (void)std::memset(this->m_admitted, 0, sizeof(this->m_admitted));
+        (void)std::memset(this->m_shed, 0, sizeof(this->m_shed));
+        this->m_admittedInWindow = 0;
+        this->m_shedInWindow = 0;
+        this->m_currentBucket = 0;
+        this->m_bucketStartUs = nowUs;
+        this->m_windowSeconds = windowSeconds;
+    }
+
+    void UplinkRateLimiter::slide(const U64 nowUs)
+    {
+        const U64 bucket_us = static_cast<U64>(this->m_windowSeconds) * 1000000 / MODERATOR_RATE_LIMIT_BUCKETS;
+        const U64 num_buckets = (nowUs - this->m_bucketStartUs) / bucket_us;
+        if (num_buckets == 0)
+        {
+            return;
+        }
+
+        // After the whole window, all buckets are cleared
+        const U64 num_cleared = (num_buckets < MODERATOR_RATE_LIMIT_BUCKETS) ? num_buckets
+                                                                             : MODERATOR_RATE_LIMIT_BUCKETS;
+        for (U64 i = 0; i < num_cleared; i++)
+        {
+            this->m_currentBucket = (this->m_currentBucket + 1) % MODERATOR_RATE_LIMIT_BUCKETS;
+            this->m_admittedInWindow -= this->m_admitted[this->m_currentBucket];
+            this->m_shedInWindow -= this->m_shed[this->m_currentBucket];
+            this->m_admitted[this->m_currentBucket] = 0;
+            this->m_shed[this->m_currentBucket] = 0;
+        }
+        this->m_bucketStartUs += num_buckets * bucket_us;
+    }
+}
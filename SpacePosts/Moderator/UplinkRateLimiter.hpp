@@ -0,0 +1,89 @@
+// ======================================================================
+// \title  UplinkRateLimiter.hpp
+// \author Marius Baden
+// \brief  hpp file for the sliding-window counter which limits the number of SpacePosts the Moderator admits
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#ifndef UplinkRateLimiter_HPP
+#define UplinkRateLimiter_HPP
+
+#include <config/ModeratorCfg.hpp>
+#include "Fw/Types/BasicTypes.hpp"
+
+namespace SpacePosts
+{
+    /**
+     * @brief Limits the number of SpacePosts admitted within a sliding time window
+     *
+     * The window is divided into MODERATOR_RATE_LIMIT_BUCKETS buckets of equal length (see ModeratorCfg.hpp), each
+     * of which counts the admitted and shed SpacePosts of its part of the window. When the window slides past the
+     * oldest bucket, the bucket is cleared and counts the newest part. The counts of the whole window are kept as
+     * running sums. Thus, the limiter has a fixed memory footprint and decides in constant time.
+     */
+    class UplinkRateLimiter
+    {
+        public:
+
+            //! Constructs a limiter with empty buckets
+            UplinkRateLimiter();
+
+            /**
+             * @brief Decides whether to admit one more SpacePost and counts it as admitted or shed
+             *
+             * Changing the window length clears all buckets.
+             *
+             * @param nowUs The current time in microseconds
+             * @param windowSeconds The length of the sliding window. 0 admits every SpacePost
+             * @param maxPerWindow The maximum number of SpacePosts admitted within the window. 0 admits every SpacePost
+             * @return true iff the SpacePost is admitted
+             */
+            bool admit(const U64 nowUs, const U32 windowSeconds, const U32 maxPerWindow);
+
+            //! The number of SpacePosts admitted within the window up to the last call of admit
+            U32 getAdmittedInWindow() const;
+
+            //! The number of SpacePosts shed within the window up to the last call of admit
+            U32 getShedInWindow() const;
+
+        private:
+
+            //! The number of admitted SpacePosts per bucket
+            U32 m_admitted[MODERATOR_RATE_LIMIT_BUCKETS];
+
+            //! The number of shed SpacePosts per bucket
+            U32 m_shed[MODERATOR_RATE_LIMIT_BUCKETS];
+
+            //! The sum of m_admitted
+            U32 m_admittedInWindow;
+
+            //! The sum of m_shed
+            U32 m_shedInWindow;
+
+            //! The bucket which counts the newest SpacePosts
+            U32 m_currentBucket;
+
+            //! The time at which the current bucket started counting, in microseconds
+            U64 m_bucketStartUs;
+
+            //! The window length the buckets were counted for. 0 if nothing has been counted yet
+            U32 m_windowSeconds;
+
+            /**
+             * @brief Clears all buckets and starts counting at the given time
+             */
+            void reset(const U64 nowUs, const U32 windowSeconds);
+
+            /**
+             * @brief Clears the buckets which the window has slid past up to the given time
+             */
+            void slide(const U64 nowUs);
+    };
+}
+
+#endif
@@ -0,0 +1,267 @@
+// ======================================================================
+// \title  Utf8Validator.cpp
+// \author Marius Baden
+// \brief  cpp file for the UTF-8 validation and sanitization of message contents
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#include <cstring>
+
+#include "Utf8Validator.hpp"
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace SpacePosts
+{
+#if defined(__SSSE3__)
+    namespace
+    {
+        constexpr U32 VECTOR_SIZE = 16;
+
+        // Errors of two-byte windows (previous byte, current byte) as bits
+        constexpr U8 TOO_SHORT = 1 << 0;      // Lead byte followed by a lead byte or ASCII
+        constexpr U8 TOO_LONG = 1 << 1;       // ASCII followed by a continuation byte
+        constexpr U8 OVERLONG_3 = 1 << 2;     // E0 followed by 80..9F
+        constexpr U8 TOO_LARGE = 1 << 3;      // F4 followed by 90..BF, or F5..FF
+        constexpr U8 SURROGATE = 1 << 4;      // ED followed by A0..BF
+        constexpr U8 OVERLONG_2 = 1 << 5;     // C0 or C1
+        constexpr U8 TOO_LARGE_1000 = 1 << 6; // F5..FF followed by 80..8F
+        constexpr U8 OVERLONG_4 = 1 << 6;     // F0 followed by 80..8F
+        constexpr U8 TWO_CONTS = 1 << 7;      // Continuation byte followed by a continuation byte
+        constexpr U8 CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS;
+
+        // Looks up each byte's low nibble in the given table
+        inline __m128i lookup(const __m128i table, const __m128i nibbles)
+        {
+            return _mm_shuffle_epi8(table, nibbles);
+        }
+
+        inline __m128i highNibbles(const __m128i bytes)
+        {
+            return _mm_and_si128(_mm_srli_epi16(bytes, 4), _mm_set1_epi8(0x0F));
+        }
+
+        // Returns the bytes of current shifted by n positions, filled with the last bytes of previous
+        template <int n>
+        inline __m128i previousBytes(const __m128i current, const __m128i previous)
+        {
+            return _mm_alignr_epi8(current, previous, VECTOR_SIZE - n);
+        }
+
+        // Returns a non-zero byte for every error in the vector, given the vector before it
+        inline __m128i checkVector(const __m128i current, const __m128i previous)
+        {
+            const __m128i byte_1_high_table = _mm_setr_epi8(
+                TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+                TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+                TOO_SHORT | OVERLONG_2,
+                TOO_SHORT,
+                TOO_SHORT | OVERLONG_3 | SURROGATE,
+                TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4);
+            const __m128i byte_1_low_table = _mm_setr_epi8(
+                CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+                CARRY | OVERLONG_2,
+                CARRY, CARRY,
+                CARRY | TOO_LARGE,
+                CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+                CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+                CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+                CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+                CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+                CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000);
+            const __m128i byte_2_high_table = _mm_setr_epi8(
+                TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+                TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+                TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+                TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+                TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+                TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT);
+
+            // Errors of the windows of each byte and its predecessor
+            const __m128i previous_1 = previousBytes<1>(current, previous);
+            const __m128i special_cases = _mm_and_si128(
+                _mm_and_si128(lookup(byte_1_high_table, highNibbles(previous_1)),
+                              lookup(byte_1_low_table, _mm_and_si128(previous_1, _mm_set1_epi8(0x0F)))),
+                lookup(byte_2_high_table, highNibbles(current)));
+
+            // The third and fourth byte of a sequence must be continuation bytes. There, the special cases report
+            // TWO_CONTS, which must be cancelled out. Everywhere else, TWO_CONTS is an error
+            const __m128i is_third_byte =
+                _mm_subs_epu8(previousBytes<2>(current, previous), _mm_set1_epi8(0xE0 - 0x80));
+            const __m128i is_fourth_byte =
+                _mm_subs_epu8(previousBytes<3>(current, previous), _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+            const __m128i must_be_continuation =
+                _mm_and_si128(_mm_or_si128(is_third_byte, is_fourth_byte), _mm_set1_epi8(static_cast<char>(0x80)));
+            return _mm_xor_si128(must_be_continuation, special_cases);
+        }
+
+        // Returns a non-zero byte if the vector ends with a lead byte whose sequence needs more bytes
+        inline __m128i checkIncomplete(const __m128i current)
+        {
+            const __m128i max_complete = _mm_setr_epi8(
+                -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1));
+            return _mm_subs_epu8(current, max_complete);
+        }
+    }
+#endif
+
+    bool Utf8Validator::isValid(const U8 *const text, const U32 length)
+    {
+#if defined(__SSSE3__)
+        /*
+         *  The vector before the first one counts as ASCII. The bytes after the last full vector are copied into a
+         *  vector padded with ASCII, which also reveals a truncated sequence at the end of the text.
+         */
+        __m128i previous = _mm_setzero_si128();
+        __m128i previous_incomplete = _mm_setzero_si128();
+        __m128i errors = _mm_setzero_si128();
+        for (U32 i = 0; i < length; i += VECTOR_SIZE)
+        {
+            __m128i current;
+            if (i + VECTOR_SIZE <= length)
+            {
+                current = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + i));
+            }
+            else
+            {
+                U8 padded[VECTOR_SIZE] = {};
+                (void)std::memcpy(padded, text + i, length - i);
+                current = _mm_loadu_si128(reinterpret_cast<const __m128i *>(padded));
+            }
+
+            if (_mm_movemask_epi8(current) == 0)
+            {
+                // ASCII only. It is an error iff the previous vector ended with an incomplete sequence
+                errors = _mm_or_si128(errors, previous_incomplete);
+                previous_incomplete = _mm_setzero_si128();
+            }
+            else
+            {
+                errors = _mm_or_si128(errors, checkVector(current, previous));
+                previous_incomplete = checkIncomplete(current);
+            }
+            previous = current;
+        }
+        errors = _mm_or_si128(errors, previous_incomplete);
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(errors, _mm_setzero_si128())) == 0xFFFF;
+#elif defined(__SSE2__)
+        // Without byte shuffles, only runs of ASCII are skipped 16 bytes at a time
+        constexpr U32 VECTOR_SIZE = 16;
+        U32 i{0};
+        while (i < length)
+        {
+            if (i + VECTOR_SIZE <= length &&
+                _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(text + i))) == 0)
+            {
+                i += VECTOR_SIZE;
+                continue;
+            }
+            const U32 sequence_length = sequenceLength(text + i, length - i);
+            if (sequence_length == 0)
+            {
+                return false;
+            }
+            i += sequence_length;
+        }
+        return true;
+#else
+        return isValidScalar(text, length);
+#endif
+    }
+
+    bool Utf8Validator::isValidScalar(const U8 *const text, const U32 length)
+    {
+        U32 i{0};
+        while (i < length)
+        {
+            const U32 sequence_length = sequenceLength(text + i, length - i);
+            if (sequence_length == 0)
+            {
+                return false;
+            }
+            i += sequence_length;
+        }
+        return true;
+    }
+
+    U32 Utf8Validator::sanitize(U8 *const text, const U32 length)
+    {
+        U32 num_replaced{0};
+        U32 i{0};
+        while (i < length)
+        {
+            const U32 sequence_length = sequenceLength(text + i, length - i);
+            if (sequence_length == 0)
+            {
+                // Resynchronize at the next byte, so a valid sequence after the invalid byte is kept
+                text[i] = REPLACEMENT;
+                ++num_replaced;
+                ++i;
+            }
+            else
+            {
+                i += sequence_length;
+            }
+        }
+        return num_replaced;
+    }
+
+    U32 Utf8Validator::sequenceLength(const U8 *const text, const U32 length)
+    {
+        const U8 lead = text[0];
+        if (lead < 0x80)
+        {
+            return 1;
+        }
+
+        // The allowed range of the second byte depends on the lead byte (Unicode table 3-7). The others are
+        // continuation bytes 80..BF
+        U32 sequence_length;
+        U8 second_min{0x80};
+        U8 second_max{0xBF};
+        if (lead >= 0xC2 && lead <= 0xDF)
+        {
+            sequence_length = 2;
+        }
+        else if (lead >= 0xE0 && lead <= 0xEF)
+        {
+            sequence_length = 3;
+            second_min = (lead == 0xE0) ? 0xA0 : 0x80;
+            second_max = (lead == 0xED) ? 0x9F : 0xBF;
+        }
+        else if (lead >= 0xF0 && lead <= 0xF4)
+        {
+            sequence_length = 4;
+            second_min = (lead == 0xF0) ? 0x90 : 0x80;
+            second_max = (lead == 0xF4) ? 0x8F : 0xBF;
+        }
+        else
+        {
+            // Continuation byte, overlong lead byte C0 or C1, or lead byte beyond U+10FFFF
+            return 0;
+        }
+
+        if (length < sequence_length || text[1] < second_min || text[1] > second_max)
+        {
+            return 0;
+        }
+        for (U32 i = 2; i < sequence_length; i++)
+        {
+            if ((text[i] & 0xC0) != 0x80)
+            {
+                return 0;
+            }
+        }
+        return sequence_length;
+    }
+}
@@ -0,0 +1,80 @@
+// ======================================================================
+// \title  Utf8Validator.hpp
+// \author Marius Baden
+// \brief  hpp file for the UTF-8 validation and sanitization of message contents
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#ifndef Utf8Validator_HPP
+#define Utf8Validator_HPP
+
+#include "Fw/Types/BasicTypes.hpp"
+
+namespace SpacePosts
+{
+    /**
+     * @brief Validates and sanitizes UTF-8 text
+     *
+     * A text is valid iff it consists of well-formed UTF-8 sequences as defined by the Unicode standard, i.e.,
+     * without overlong encodings, surrogates, code points above U+10FFFF, and truncated sequences.
+     *
+     * On targets with SSSE3, 16 bytes are validated at a time with the lookup algorithm of Keiser and Lemire (as
+     * used by simdjson and simdutf): three table lookups on the nibbles of each byte and its predecessor classify
+     * all errors of two-byte windows, and the lengths of longer sequences are checked with saturating subtractions.
+     * Vectors of ASCII bytes are skipped after one compare. Targets with SSE2 only skip runs of 16 ASCII bytes and
+     * validate the rest one sequence at a time, other targets validate everything one sequence at a time. All
+     * variants agree.
+     */
+    class Utf8Validator
+    {
+        public:
+
+            //! Replaces each byte of an invalid sequence when sanitizing. ASCII, so the length stays the same
+            static constexpr U8 REPLACEMENT = '?';
+
+            /**
+             * @brief Checks whether the text is valid UTF-8 with the fastest variant of the build target
+             *
+             * @param text The text to validate
+             * @param length The number of bytes of text
+             * @return true iff text is valid UTF-8
+             */
+            static bool isValid(const U8 *const text, const U32 length);
+
+            /**
+             * @brief Checks whether the text is valid UTF-8 one byte at a time
+             *
+             * @param text The text to validate
+             * @param length The number of bytes of text
+             * @return true iff text is valid UTF-8
+             */
+            static bool isValidScalar(const U8 *const text, const U32 length);
+
+            /**
+             * @brief Replaces each byte which is not part of a valid UTF-8 sequence with REPLACEMENT
+             *
+             * @param text The text to sanitize in place
+             * @param length The number of bytes of text
+             * @return The number of replaced bytes
+             */
+            static U32 sanitize(U8 *const text, const U32 length);
+
+        private:
+
+            /**
+             * @brief Returns the length of the valid UTF-8 sequence at the start of text
+             *
+             * @param text The text
+             * @param length The number of bytes of text. Must be positive
+             * @return The number of bytes of the sequence. 0 if text does not start with a valid sequence
+             */
+            static U32 sequenceLength(const U8 *const text, const U32 length);
+    };
+}
+
+#endif
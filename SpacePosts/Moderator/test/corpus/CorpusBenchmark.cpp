@@ -0,0 +1,382 @@
+// ======================================================================
+// \title  Moderator/test/corpus/CorpusBenchmark.cpp
+// \author Marius Baden
+// \brief  cpp file for the benchmark of moderation strategies on a labeled corpus
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <thread>
+
+#include "Fw/Types/Assert.hpp"
+#include "SpacePosts/MessageTypes/FppConstantsAc.hpp"
+
+#include "CorpusBenchmark.hpp"
+
+/*
+ *  Heap accounting: the global operator new and operator delete of the benchmark build keep the size of each block
+ *  in a header in front of it, so that the number of bytes held on the heap is known at any time.
+ */
+namespace
+{
+    constexpr std::size_t HEADER_SIZE = alignof(std::max_align_t);
+
+    std::atomic<U64> heapBytes{0};
+
+    void *allocate(const std::size_t size)
+    {
+        void *const block = std::malloc(HEADER_SIZE + size);
+        if (block == nullptr)
+        {
+            return nullptr;
+        }
+        *static_cast<std::size_t *>(block) = size;
+        heapBytes.fetch_add(size, std::memory_order_relaxed);
+        return static_cast<char *>(block) + HEADER_SIZE;
+    }
+
+    void deallocate(void *const pointer)
+    {
+        if (pointer == nullptr)
+        {
+            return;
+        }
+        void *const block = static_cast<char *>(pointer) - HEADER_SIZE;
+        heapBytes.fetch_sub(*static_cast<std::size_t *>(block), std::memory_order_relaxed);
+        std::free(block);
+    }
+}
+
+void *operator new(std::size_t size)
+{
+    void *const pointer = allocate(size);
+    if (pointer == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void *operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    return allocate(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    return allocate(size);
+}
+
+void operator delete(void *pointer) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete[](void *pointer) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete(void *pointer, const std::nothrow_t &) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete[](void *pointer, const std::nothrow_t &) noexcept
+{
+    deallocate(pointer);
+}
+
+namespace SpacePosts
+{
+    namespace
+    {
+        constexpr U32 MAX_TEXT_LENGTH = FppConstant_SpacePost_MaxTextLength::SpacePost_MaxTextLength;
+
+        // Returns the latency below which the given share of the sorted latencies lies (nearest rank)
+        U64 percentile(const std::vector<U64> &sortedLatencies, const double share)
+        {
+            if (sortedLatencies.empty())
+            {
+                return 0;
+            }
+            const std::size_t rank = static_cast<std::size_t>(std::ceil(share * sortedLatencies.size()));
+            return sortedLatencies[std::max<std::size_t>(rank, 1) - 1];
+        }
+
+        // Returns the value of a hexadecimal digit, or -1 if the character is none
+        int hexValue(const char character)
+        {
+            if (character >= '0' && character <= '9')
+            {
+                return character - '0';
+            }
+            if (character >= 'a' && character <= 'f')
+            {
+                return character - 'a' + 10;
+            }
+            if (character >= 'A' && character <= 'F')
+            {
+                return character - 'A' + 10;
+            }
+            return -1;
+        }
+    }
+
+    bool CorpusBenchmark::loadCorpus(const std::string &path, std::string &error)
+    {
+        std::ifstream file{path};
+        if (!file)
+        {
+            error = "cannot open " + path;
+            return false;
+        }
+
+        std::vector<LabeledPost> corpus{};
+        std::string line{};
+        U32 line_number{0};
+        while (std::getline(file, line))
+        {
+            ++line_number;
+            if (line.empty() || line[0] == '#')
+            {
+                continue;
+            }
+
+            const std::string location = path + ":" + std::to_string(line_number) + ": ";
+            const std::size_t tab = line.find('\t');
+            if (tab == std::string::npos)
+            {
+                error = location + "expected a label and a tab";
+                return false;
+            }
+            const std::string label = line.substr(0, tab);
+            if (label != "accept" && label != "reject")
+            {
+                error = location + "unknown label '" + label + "'";
+                return false;
+            }
+            std::string text{};
+            if (!unescape(line.substr(tab + 1), text))
+            {
+                error = location + "invalid escape sequence";
+                return false;
+            }
+            if (text.length() > MAX_TEXT_LENGTH)
+            {
+                error = location + "message content longer than " + std::to_string(MAX_TEXT_LENGTH) + " bytes";
+                return false;
+            }
+            corpus.push_back(LabeledPost{SpacePost(text.c_str()), label == "accept"});
+        }
+
+        if (corpus.empty())
+        {
+            error = path + " contains no SpacePosts";
+            return false;
+        }
+        this->m_corpus = std::move(corpus);
+        return true;
+    }
+
+    bool CorpusBenchmark::loadBlocklist(const std::string &path, std::vector<std::string> &terms)
+    {
+        std::ifstream file{path};
+        if (!file)
+        {
+            return false;
+        }
+        std::string line{};
+        while (std::getline(file, line))
+        {
+            if (!line.empty() && line[0] != '#')
+            {
+                terms.push_back(line);
+            }
+        }
+        return true;
+    }
+
+    const std::vector<LabeledPost> &CorpusBenchmark::getCorpus() const
+    {
+        return this->m_corpus;
+    }
+
+    CorpusResult CorpusBenchmark::run(const StrategyFactory &strategy, const U32 threads, const U32 passes) const
+    {
+        FW_ASSERT(threads > 0);
+        FW_ASSERT(passes > 0);
+
+        CorpusResult result{strategy.name, threads, 0, 0.0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+
+        // Accuracy and latency. The latencies are reserved upfront, so they do not count towards the footprint
+        std::vector<U64> latencies{};
+        latencies.reserve(this->m_corpus.size());
+        const U64 heap_before = getHeapBytes();
+        {
+            const std::unique_ptr<ModerationStrategy> instance = strategy.create();
+            for (const LabeledPost &labeled : this->m_corpus)
+            {
+                const auto start = std::chrono::steady_clock::now();
+                const bool accepted = instance->checkMessage(labeled.post);
+                const auto end = std::chrono::steady_clock::now();
+                latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+
+                if (labeled.acceptable)
+                {
+                    ++result.acceptable;
+                    result.falsePositives += !accepted;
+                }
+                else
+                {
+                    ++result.inappropriate;
+                    result.falseNegatives += accepted;
+                }
+            }
+            const U64 heap_after = getHeapBytes();
+            result.footprintBytes = (heap_after > heap_before) ? heap_after - heap_before : 0;
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+        result.p50Ns = percentile(latencies, 0.50);
+        result.p90Ns = percentile(latencies, 0.90);
+        result.p99Ns = percentile(latencies, 0.99);
+        result.maxNs = latencies.empty() ? 0 : latencies.back();
+
+        // Throughput. The instances are created before the clock starts, each thread checks a contiguous share
+        std::vector<std::unique_ptr<ModerationStrategy>> instances{};
+        for (U32 i = 0; i < threads; i++)
+        {
+            instances.push_back(strategy.create());
+        }
+        std::vector<U32> accepted_counts(threads, 0);
+        std::vector<std::thread> workers{};
+
+        const auto start = std::chrono::steady_clock::now();
+        for (U32 i = 0; i < threads; i++)
+        {
+            const std::size_t begin = this->m_corpus.size() * i / threads;
+            const std::size_t end = this->m_corpus.size() * (i + 1) / threads;
+            workers.emplace_back([this, &instances, &accepted_counts, i, begin, end, passes]() {
+                ModerationStrategy &instance = *instances[i];
+                U32 accepted{0};
+                for (U32 pass = 0; pass < passes; pass++)
+                {
+                    for (std::size_t post = begin; post < end; post++)
+                    {
+                        accepted += instance.checkMessage(this->m_corpus[post].post);
+                    }
+                }
+                // Keeps the checks from being optimized away
+                accepted_counts[i] = accepted;
+            });
+        }
+        for (std::thread &worker : workers)
+        {
+            worker.join();
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        result.checks = static_cast<U64>(this->m_corpus.size()) * passes;
+        result.totalNs = std::chrono::duration<double, std::nano>(end - start).count();
+        return result;
+    }
+
+    U64 CorpusBenchmark::getHeapBytes()
+    {
+        return heapBytes.load(std::memory_order_relaxed);
+    }
+
+    void CorpusBenchmark::print(const CorpusResult &result)
+    {
+        std::printf("[ BENCHMARK ] %-14s %2u threads %12.0f msgs/s\n",
+                    result.name.c_str(), result.threads, result.messagesPerSecond());
+        std::printf("[ BENCHMARK ] %-14s latency p50 %8llu ns  p90 %8llu ns  p99 %8llu ns  max %8llu ns\n",
+                    result.name.c_str(),
+                    static_cast<unsigned long long>(result.p50Ns), static_cast<unsigned long long>(result.p90Ns),
+                    static_cast<unsigned long long>(result.p99Ns), static_cast<unsigned long long>(result.maxNs));
+        std::printf("[ BENCHMARK ] %-14s false positives %5u/%-5u (%5.1f %%)  false negatives %5u/%-5u (%5.1f %%)\n",
+                    result.name.c_str(),
+                    result.falsePositives, result.acceptable, 100.0 * result.falsePositiveRate(),
+                    result.falseNegatives, result.inappropriate, 100.0 * result.falseNegativeRate());
+        std::printf("[ BENCHMARK ] %-14s footprint %10llu bytes\n",
+                    result.name.c_str(), static_cast<unsigned long long>(result.footprintBytes));
+    }
+
+    bool CorpusBenchmark::unescape(const std::string &escaped, std::string &text)
+    {
+        text.clear();
+        for (std::size_t i = 0; i < escaped.length(); i++)
+        {
+            if (escaped[i] != '\\')
+            {
+                text.push_back(escaped[i]);
+                continue;
+            }
+            if (++i == escaped.length())
+            {
+                return false;
+            }
+            switch (escaped[i])
+            {
+                case 't':
+                    text.push_back('\t');
+                    break;
+                case 'n':
+                    text.push_back('\n');
+                    break;
+                case '\\':
+                    text.push_back('\\');
+                    break;
+                case 'x':
+                {
+                    if (i + 2 >= escaped.length())
+                    {
+                        return false;
+                    }
+                    const int high = hexValue(escaped[i + 1]);
+                    const int low = hexValue(escaped[i + 2]);
+                    // The message content is a C string, so it cannot hold a NUL byte
+                    if (high < 0 || low < 0 || (high == 0 && low == 0))
+                    {
+                        return false;
+                    }
+                    text.push_back(static_cast<char>(high * 16 + low));
+                    i += 2;
+                    break;
+                }
+                default:
+                    return false;
+            }
+        }
+        return true;
+    }
+}
@@ -0,0 +1,160 @@
+// ======================================================================
+// \title  Moderator/test/corpus/CorpusBenchmark.hpp
+// \author Marius Baden
+// \brief  hpp file for the benchmark of moderation strategies on a labeled corpus
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#ifndef CORPUSBENCHMARK_HPP
+#define CORPUSBENCHMARK_HPP
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Fw/Types/BasicTypes.hpp"
+#include "SpacePosts/MessageTypes/SpacePostSerializableAc.hpp"
+#include "SpacePosts/Moderator/ModerationStrategy.hpp"
+
+namespace SpacePosts
+{
+    /**
+     * @brief A SpacePost of the corpus and whether a moderation strategy should accept it
+     */
+    struct LabeledPost
+    {
+        SpacePost post;   //!< The SpacePost to check
+        bool acceptable;  //!< true if the SpacePost should be accepted, false if it should be rejected
+    };
+
+    /**
+     * @brief A registered moderation strategy
+     *
+     * Every thread of a benchmark run uses its own instance, as strategies may keep state between checks.
+     */
+    struct StrategyFactory
+    {
+        //! Name of the strategy in the printed results
+        std::string name;
+
+        //! Creates a ready-to-use instance of the strategy
+        std::function<std::unique_ptr<ModerationStrategy>()> create;
+    };
+
+    /**
+     * @brief Result of a benchmark run of one strategy over the corpus
+     */
+    struct CorpusResult
+    {
+        std::string name;      //!< Name of the strategy
+        U32 threads;           //!< Number of threads which checked the corpus in parallel
+        U64 checks;            //!< Number of checks of the throughput measurement
+        double totalNs;        //!< Wall-clock time of the throughput measurement in nanoseconds
+        U64 p50Ns;             //!< Median latency of a single check in nanoseconds
+        U64 p90Ns;             //!< 90th percentile of the latency of a single check in nanoseconds
+        U64 p99Ns;             //!< 99th percentile of the latency of a single check in nanoseconds
+        U64 maxNs;             //!< Longest latency of a single check in nanoseconds
+        U32 acceptable;        //!< Number of SpacePosts of the corpus labeled acceptable
+        U32 inappropriate;     //!< Number of SpacePosts of the corpus labeled inappropriate
+        U32 falsePositives;    //!< Number of acceptable SpacePosts which the strategy rejected
+        U32 falseNegatives;    //!< Number of inappropriate SpacePosts which the strategy accepted
+        U64 footprintBytes;    //!< Heap memory held by one instance of the strategy after checking the corpus
+
+        //! Number of checks per second of all threads together
+        double messagesPerSecond() const { return totalNs == 0.0 ? 0.0 : checks * 1e9 / totalNs; }
+
+        //! Share of the acceptable SpacePosts which were rejected
+        double falsePositiveRate() const
+        {
+            return acceptable == 0 ? 0.0 : static_cast<double>(falsePositives) / acceptable;
+        }
+
+        //! Share of the inappropriate SpacePosts which were accepted
+        double falseNegativeRate() const
+        {
+            return inappropriate == 0 ? 0.0 : static_cast<double>(falseNegatives) / inappropriate;
+        }
+    };
+
+    /**
+     * @brief Benchmark which runs moderation strategies over a corpus of labeled SpacePosts
+     *
+     * A corpus file has one SpacePost per line: the label "accept" or "reject", a tab, and the message content.
+     * Empty lines and lines starting with '#' are skipped. The escape sequences \\t, \\n, \\\\, and \\xHH (except
+     * \\x00) in the message content allow for any text a SpacePost can hold, e.g., binary noise or invalid UTF-8.
+     *
+     * Each run measures a strategy in two phases:
+     *  - Accuracy and latency: a fresh instance checks the corpus in order on one thread, timing every check. A
+     *    stateful strategy (e.g., the RepetitionModerationStrategy) thus sees the corpus like the Moderator would.
+     *    The heap memory the instance holds afterwards is its footprint.
+     *  - Throughput: one fresh instance per thread checks its share of the corpus repeatedly, and only the whole
+     *    run is timed, so the clock does not dominate cheap checks.
+     */
+    class CorpusBenchmark
+    {
+        public:
+
+            /**
+             * @brief Loads the corpus from a file
+             *
+             * @param path The path of the corpus file
+             * @param error Set to a description of the problem if the corpus cannot be loaded
+             * @return true iff the corpus has been loaded. A malformed line fails the whole corpus
+             */
+            bool loadCorpus(const std::string &path, std::string &error);
+
+            /**
+             * @brief Loads a blocklist file with one term per line. Empty lines and lines starting with '#' are skipped
+             *
+             * @param path The path of the blocklist file
+             * @param terms The terms of the file are appended to this
+             * @return true iff the file could be read
+             */
+            static bool loadBlocklist(const std::string &path, std::vector<std::string> &terms);
+
+            //! The SpacePosts of the loaded corpus
+            const std::vector<LabeledPost> &getCorpus() const;
+
+            /**
+             * @brief Runs the strategy over the corpus
+             *
+             * @param strategy The strategy to run
+             * @param threads The number of threads of the throughput measurement. Must be positive
+             * @param passes The number of times each thread checks its share of the corpus. Must be positive
+             * @return The result of the run
+             */
+            CorpusResult run(const StrategyFactory &strategy, const U32 threads, const U32 passes) const;
+
+            /**
+             * @brief The number of bytes the program currently holds on the heap
+             *
+             * Counted by the replacements of the global operator new and operator delete of the benchmark build.
+             */
+            static U64 getHeapBytes();
+
+            /**
+             * @brief Prints a result to stdout
+             */
+            static void print(const CorpusResult &result);
+
+        private:
+
+            //! The SpacePosts of the loaded corpus
+            std::vector<LabeledPost> m_corpus;
+
+            /**
+             * @brief Replaces the escape sequences of a message content of the corpus file
+             *
+             * @return true iff all escape sequences are valid
+             */
+            static bool unescape(const std::string &escaped, std::string &text);
+    };
+}
+
+#endif
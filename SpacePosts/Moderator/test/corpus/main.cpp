@@ -0,0 +1,202 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "SpacePosts/Moderator/AhoCorasickModerationStrategy.hpp"
+#include "SpacePosts/Moderator/ByteClassModerationStrategy.hpp"
+#include "SpacePosts/Moderator/CompositeModerationStrategy.hpp"
+#include "SpacePosts/Moderator/ConcreteModerationStrategyExample.hpp"
+#include "SpacePosts/Moderator/FuzzyModerationStrategy.hpp"
+#include "SpacePosts/Moderator/RepetitionModerationStrategy.hpp"
+
+#include "CorpusBenchmark.hpp"
+
+using namespace SpacePosts;
+
+// Number of checks of the throughput measurement per strategy, shared by all threads
+constexpr const U32 CHECKS_PER_RUN = 1000000;
+
+// Thresholds of the byte class screening: UTF-8 text passes, binary noise does not
+constexpr const U32 MAX_CONTROL_BYTES = 0;
+constexpr const U32 MAX_HIGH_BIT_BYTES = 64;
+
+// Thresholds of the repetition detection
+constexpr const U32 REPETITION_WINDOW_SECONDS = 600;
+constexpr const U32 REPETITION_MAX_COPIES = 2;
+
+// Maximum number of edits of the fuzzy blocklist
+constexpr const U32 FUZZY_MAX_EDITS = 1;
+
+// The corpus and blocklist next to this file, unless the environment variables MODERATOR_CORPUS and
+// MODERATOR_BLOCKLIST name others
+const std::string DIRECTORY = std::string(__FILE__).substr(0, std::string(__FILE__).rfind('/') + 1);
+const std::string DEFAULT_CORPUS = DIRECTORY + "sample_corpus.txt";
+const std::string DEFAULT_BLOCKLIST = DIRECTORY + "sample_blocklist.txt";
+
+// The blocklist of the blocklist strategies. Loaded before the benchmarks run
+std::vector<std::string> BLOCKLIST{};
+
+/**
+ * @brief The strategies a Moderator is configured with in flight: cheap screening first, then the blocklist, then the
+ * repetition detection, which has to see every remaining SpacePost
+ */
+class ChainModerationStrategy : public ModerationStrategy
+{
+    public:
+        ChainModerationStrategy()
+            : m_byteClass(MAX_CONTROL_BYTES, MAX_HIGH_BIT_BYTES),
+              m_blocklist(true),
+              m_repetition(REPETITION_WINDOW_SECONDS, REPETITION_MAX_COPIES),
+              m_chain()
+        {
+            for (const std::string &term : BLOCKLIST)
+            {
+                (void)this->m_blocklist.addPattern(term.c_str(), term.length());
+            }
+            this->m_blocklist.build();
+            (void)this->m_chain.addStrategy(this->m_byteClass);
+            (void)this->m_chain.addStrategy(this->m_blocklist);
+            // Pinned, so that reordering the other strategies never moves one of them behind it
+            (void)this->m_chain.addStrategy(this->m_repetition, true);
+        }
+
+        bool checkMessage(const SpacePosts::SpacePost &message) override
+        {
+            return this->m_chain.checkMessage(message);
+        }
+
+    private:
+        ByteClassModerationStrategy m_byteClass;
+        AhoCorasickModerationStrategy m_blocklist;
+        RepetitionModerationStrategy m_repetition;
+        CompositeModerationStrategy m_chain;
+};
+
+/*
+    Registry of the benchmarked strategies. To benchmark a new strategy, add a factory for it here
+*/
+
+const std::vector<StrategyFactory> STRATEGIES{
+    // Baseline: accepts everything, so it measures the cost of the harness and the call itself
+    {"Example", []() -> std::unique_ptr<ModerationStrategy> {
+         return std::unique_ptr<ModerationStrategy>(new ConcreteModerationStrategyExample());
+     }},
+    {"ByteClass", []() -> std::unique_ptr<ModerationStrategy> {
+         return std::unique_ptr<ModerationStrategy>(
+             new ByteClassModerationStrategy(MAX_CONTROL_BYTES, MAX_HIGH_BIT_BYTES));
+     }},
+    {"AhoCorasick", []() -> std::unique_ptr<ModerationStrategy> {
+         std::unique_ptr<AhoCorasickModerationStrategy> strategy{new AhoCorasickModerationStrategy(true)};
+         for (const std::string &term : BLOCKLIST)
+         {
+             (void)strategy->addPattern(term.c_str(), term.length());
+         }
+         strategy->build();
+         return std::unique_ptr<ModerationStrategy>(std::move(strategy));
+     }},
+    {"Fuzzy", []() -> std::unique_ptr<ModerationStrategy> {
+         std::unique_ptr<FuzzyModerationStrategy> strategy{new FuzzyModerationStrategy(FUZZY_MAX_EDITS)};
+         for (const std::string &term : BLOCKLIST)
+         {
+             (void)strategy->addTerm(term.c_str(), term.length());
+         }
+         return std::unique_ptr<ModerationStrategy>(std::move(strategy));
+     }},
+    {"Repetition", []() -> std::unique_ptr<ModerationStrategy> {
+         return std::unique_ptr<ModerationStrategy>(
+             new RepetitionModerationStrategy(REPETITION_WINDOW_SECONDS, REPETITION_MAX_COPIES));
+     }},
+    {"Chain", []() -> std::unique_ptr<ModerationStrategy> {
+         return std::unique_ptr<ModerationStrategy>(new ChainModerationStrategy());
+     }},
+};
+
+/**
+ * @brief Returns the value of the environment variable, or the default if it is not set
+ */
+std::string getEnvironment(const char *const name, const std::string &defaultValue)
+{
+    const char *const value = std::getenv(name);
+    return (value == nullptr) ? defaultValue : std::string(value);
+}
+
+class ModeratorCorpusBenchmark : public ::testing::TestWithParam<StrategyFactory>
+{
+    protected:
+        static void SetUpTestCase()
+        {
+            std::string error{};
+            corpusLoaded = benchmark.loadCorpus(getEnvironment("MODERATOR_CORPUS", DEFAULT_CORPUS), error);
+            if (!corpusLoaded)
+            {
+                std::printf("[ BENCHMARK ] %s\n", error.c_str());
+            }
+        }
+
+        static CorpusBenchmark benchmark;
+        static bool corpusLoaded;
+};
+
+CorpusBenchmark ModeratorCorpusBenchmark::benchmark{};
+bool ModeratorCorpusBenchmark::corpusLoaded{false};
+
+TEST_P(ModeratorCorpusBenchmark, Run)
+{
+    ASSERT_TRUE(corpusLoaded);
+
+    // All cores check the corpus in parallel
+    const U32 threads = std::max(std::thread::hardware_concurrency(), 1U);
+    const U32 corpus_size = static_cast<U32>(benchmark.getCorpus().size());
+    const U32 passes = std::max(CHECKS_PER_RUN / corpus_size, 1U);
+
+    const CorpusResult result = benchmark.run(GetParam(), threads, passes);
+    CorpusBenchmark::print(result);
+
+    EXPECT_EQ(result.acceptable + result.inappropriate, corpus_size);
+    EXPECT_LE(result.p50Ns, result.p90Ns);
+    EXPECT_LE(result.p90Ns, result.p99Ns);
+    EXPECT_LE(result.p99Ns, result.maxNs);
+}
+
+INSTANTIATE_TEST_CASE_P(Registered, ModeratorCorpusBenchmark, ::testing::ValuesIn(STRATEGIES),
+                        [](const ::testing::TestParamInfo<StrategyFactory> &info) { return info.param.name; });
+
+TEST(ModeratorCorpusBenchmarkHarness, BaselineAcceptsEverything)
+{
+    CorpusBenchmark benchmark{};
+    std::string error{};
+    ASSERT_TRUE(benchmark.loadCorpus(DEFAULT_CORPUS, error)) << error;
+
+    const CorpusResult result = benchmark.run(STRATEGIES.front(), 1, 1);
+    EXPECT_EQ(result.falsePositives, 0U);
+    EXPECT_EQ(result.falseNegatives, result.inappropriate);
+    EXPECT_GT(result.acceptable, 0U);
+    EXPECT_GT(result.inappropriate, 0U);
+}
+
+TEST(ModeratorCorpusBenchmarkHarness, CountsHeapFootprint)
+{
+    const U64 before = CorpusBenchmark::getHeapBytes();
+    {
+        std::unique_ptr<ModerationStrategy> strategy = STRATEGIES.back().create();
+        EXPECT_GE(CorpusBenchmark::getHeapBytes() - before, sizeof(ChainModerationStrategy));
+    }
+    EXPECT_EQ(CorpusBenchmark::getHeapBytes(), before);
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    if (!CorpusBenchmark::loadBlocklist(getEnvironment("MODERATOR_BLOCKLIST", DEFAULT_BLOCKLIST), BLOCKLIST))
+    {
+        std::printf("[ BENCHMARK ] cannot read the blocklist\n");
+        return 1;
+    }
+    return RUN_ALL_TESTS();
+}
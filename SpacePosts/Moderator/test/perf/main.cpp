@@ -0,0 +1,513 @@
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "SpacePosts/Moderator/AhoCorasickModerationStrategy.hpp"
+#include "SpacePosts/Moderator/ByteClassModerationStrategy.hpp"
+#include "SpacePosts/Moderator/CompositeModerationStrategy.hpp"
+#include "SpacePosts/Moderator/FuzzyModerationStrategy.hpp"
+#include "SpacePosts/Moderator/ReloadableBlocklist.hpp"
+#include "SpacePosts/Moderator/RepetitionModerationStrategy.hpp"
+#include "SpacePosts/Moderator/StrategyModerator.hpp"
+#include "SpacePosts/Moderator/Utf8Validator.hpp"
+#include "SpacePosts/MessageTypes/FppConstantsAc.hpp"
+#include "../ut/model/Utf8Text.hpp"
+
+using namespace SpacePosts;
+
+// Number of timed passes over all posts per benchmark
+constexpr const U32 ITERATIONS = 2000;
+
+// Number of timed byte class screenings per benchmark
+constexpr const U32 SCREEN_ITERATIONS = 1000000;
+
+constexpr const U32 MAX_MSGTEXT_LENGTH = SpacePosts::FppConstant_SpacePost_MaxTextLength::SpacePost_MaxTextLength;
+
+// Number of timed passes over all posts per dispatch benchmark
+constexpr const U32 DISPATCH_ITERATIONS = 2500000;
+
+// Blocklists larger than this are not checked with the naive scan because it takes too long
+constexpr const U32 MAX_NAIVE_BLOCKLIST_SIZE = 1000;
+
+const std::vector<std::string> POSTS{
+    "Hello everyone from W1AW! Greetings to all students listening today, 73",
+    "CQ CQ DE DL5ABC DL5ABC QTH JO62qm RST 599 TNX QSO 73 K",
+    "Greetings from the science class of Lincoln Middle School. We built our own antenna for this pass!",
+    "the satellite station sends best wishes to every ham radio operator around the globe, clear skies",
+};
+
+/**
+ * @brief Generates a reproducible blocklist of lowercase terms with 5 to 10 characters
+ */
+std::vector<std::string> generateBlocklist(const U32 size)
+{
+    std::mt19937 random{size};
+    std::uniform_int_distribution<U32> length{5, 10};
+    std::uniform_int_distribution<int> letter{'a', 'z'};
+
+    std::vector<std::string> blocklist{};
+    for (U32 i = 0; i < size; i++)
+    {
+        std::string term(length(random), ' ');
+        for (char &character : term)
+        {
+            character = static_cast<char>(letter(random));
+        }
+        blocklist.push_back(term);
+    }
+    return blocklist;
+}
+
+/**
+ * @brief Checks a post against every term separately, as a strategy without an automaton would
+ */
+bool naiveContainsPattern(const std::vector<std::string> &blocklist, const std::string &post)
+{
+    std::string folded{post};
+    for (char &character : folded)
+    {
+        character = static_cast<char>(std::tolower(static_cast<unsigned char>(character)));
+    }
+    for (const std::string &term : blocklist)
+    {
+        if (folded.find(term) != std::string::npos)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Prints the time per post of the timed checks
+ */
+void printResult(const char *const name, const U32 blocklistSize, const double totalNs)
+{
+    std::printf("[ BENCHMARK ] %-13s %6u terms %10.1f ns/post\n", name, blocklistSize,
+                totalNs / (ITERATIONS * POSTS.size()));
+}
+
+/**
+ * @brief Times the checks of all posts against a blocklist of the given size with the automaton and the naive scan
+ */
+void benchmarkBlocklist(const U32 blocklistSize)
+{
+    const std::vector<std::string> blocklist = generateBlocklist(blocklistSize);
+
+    AhoCorasickModerationStrategy strategy{true};
+    const auto build_start = std::chrono::steady_clock::now();
+    for (const std::string &term : blocklist)
+    {
+        ASSERT_TRUE(strategy.addPattern(term.c_str(), term.length()));
+    }
+    strategy.build();
+    const auto build_end = std::chrono::steady_clock::now();
+    std::printf("[ BENCHMARK ] build         %6u terms %10.1f us, %u states x %u classes = %u bytes\n", blocklistSize,
+                std::chrono::duration<double, std::micro>(build_end - build_start).count(), strategy.getNumStates(),
+                strategy.getNumClasses(), strategy.getTableSize());
+
+    U32 matches{0};
+    const auto start = std::chrono::steady_clock::now();
+    for (U32 i = 0; i < ITERATIONS; i++)
+    {
+        for (const std::string &post : POSTS)
+        {
+            matches += strategy.containsPattern(reinterpret_cast<const U8 *>(post.c_str()), post.length());
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+    printResult("aho-corasick", blocklistSize, std::chrono::duration<double, std::nano>(end - start).count());
+
+    if (blocklistSize > MAX_NAIVE_BLOCKLIST_SIZE)
+    {
+        return;
+    }
+
+    U32 naive_matches{0};
+    const auto naive_start = std::chrono::steady_clock::now();
+    for (U32 i = 0; i < ITERATIONS; i++)
+    {
+        for (const std::string &post : POSTS)
+        {
+            naive_matches += naiveContainsPattern(blocklist, post);
+        }
+    }
+    const auto naive_end = std::chrono::steady_clock::now();
+    printResult("naive scan", blocklistSize,
+                std::chrono::duration<double, std::nano>(naive_end - naive_start).count());
+
+    // Both must decide the same
+    EXPECT_EQ(matches, naive_matches);
+}
+
+TEST(ModeratorBenchmark, AhoCorasickBlocklist10)
+{
+    benchmarkBlocklist(10);
+}
+
+TEST(ModeratorBenchmark, AhoCorasickBlocklist100)
+{
+    benchmarkBlocklist(100);
+}
+
+TEST(ModeratorBenchmark, AhoCorasickBlocklist1000)
+{
+    benchmarkBlocklist(1000);
+}
+
+TEST(ModeratorBenchmark, AhoCorasickBlocklist10000)
+{
+    benchmarkBlocklist(10000);
+}
+
+/**
+ * @brief Times the byte class screening of the given text and checks that it counts as the scalar variant
+ */
+void benchmarkScreen(const char *const name, const std::string &text)
+{
+    const U8 *const raw_text = reinterpret_cast<const U8 *>(text.c_str());
+    const U32 length = text.length();
+    using Counts = ByteClassModerationStrategy::ByteCounts;
+
+    U32 vector_sum{0};
+    const auto start = std::chrono::steady_clock::now();
+    for (U32 i = 0; i < SCREEN_ITERATIONS; i++)
+    {
+        const Counts counts = ByteClassModerationStrategy::countByteClasses(raw_text, length);
+        vector_sum += counts.control + counts.highBit;
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    U32 scalar_sum{0};
+    const auto scalar_start = std::chrono::steady_clock::now();
+    for (U32 i = 0; i < SCREEN_ITERATIONS; i++)
+    {
+        const Counts counts = ByteClassModerationStrategy::countByteClassesScalar(raw_text, length);
+        scalar_sum += counts.control + counts.highBit;
+    }
+    const auto scalar_end = std::chrono::steady_clock::now();
+
+    std::printf("[ BENCHMARK ] screen %-10s %4u bytes %8.1f ns/post (scalar %8.1f ns/post)\n", name, length,
+                std::chrono::duration<double, std::nano>(end - start).count() / SCREEN_ITERATIONS,
+                std::chrono::duration<double, std::nano>(scalar_end - scalar_start).count() / SCREEN_ITERATIONS);
+    EXPECT_EQ(vector_sum, scalar_sum);
+}
+
+TEST(ModeratorBenchmark, ByteClassScreenMaxText)
+{
+    std::string text{};
+    while (text.length() < MAX_MSGTEXT_LENGTH)
+    {
+        text += "the satellite station sends best wishes to every ham radio operator ";
+    }
+    text.resize(MAX_MSGTEXT_LENGTH);
+    benchmarkScreen("max text", text);
+}
+
+TEST(ModeratorBenchmark, ByteClassScreenBinary)
+{
+    std::mt19937 random{MAX_MSGTEXT_LENGTH};
+    std::uniform_int_distribution<int> byte{1, 255};
+    std::string text(MAX_MSGTEXT_LENGTH, ' ');
+    for (char &character : text)
+    {
+        character = static_cast<char>(byte(random));
+    }
+    benchmarkScreen("binary", text);
+}
+
+TEST(ModeratorBenchmark, CompositeRunsCheapSelectiveFirst)
+{
+    // Expensive blocklist check which accepts all posts, cheap byte class check which rejects the binary ones
+    const std::vector<std::string> blocklist = generateBlocklist(10000);
+    AhoCorasickModerationStrategy blocklist_strategy{true};
+    for (const std::string &term : blocklist)
+    {
+        ASSERT_TRUE(blocklist_strategy.addPattern(term.c_str(), term.length()));
+    }
+    blocklist_strategy.build();
+    ByteClassModerationStrategy byte_class_strategy{0, 0};
+
+    // Half of the posts are binary noise
+    std::vector<SpacePost> posts{};
+    std::mt19937 random{0};
+    std::uniform_int_distribution<int> byte{1, 255};
+    for (const std::string &post : POSTS)
+    {
+        posts.emplace_back(post.c_str());
+        std::string noise(MAX_MSGTEXT_LENGTH, ' ');
+        for (char &character : noise)
+        {
+            character = static_cast<char>(byte(random));
+        }
+        posts.emplace_back(noise.c_str());
+    }
+
+    // Start with the worst order
+    CompositeModerationStrategy chain{};
+    ASSERT_TRUE(chain.addStrategy(blocklist_strategy));
+    ASSERT_TRUE(chain.addStrategy(byte_class_strategy));
+
+    U32 static_accepted{0};
+    const auto static_start = std::chrono::steady_clock::now();
+    for (U32 i = 0; i < ITERATIONS; i++)
+    {
+        for (const SpacePost &post : posts)
+        {
+            static_accepted += blocklist_strategy.checkMessage(post) && byte_class_strategy.checkMessage(post);
+        }
+    }
+    const auto static_end = std::chrono::steady_clock::now();
+
+    U32 chain_accepted{0};
+    const auto chain_start = std::chrono::steady_clock::now();
+    for (U32 i = 0; i < ITERATIONS; i++)
+    {
+        for (const SpacePost &post : posts)
+        {
+            chain_accepted += chain.checkMessage(post);
+        }
+    }
+    const auto chain_end = std::chrono::steady_clock::now();
+
+    const double num_checks = static_cast<double>(ITERATIONS) * posts.size();
+    std::printf("[ BENCHMARK ] chain static  %10.1f ns/post\n",
+                std::chrono::duration<double, std::nano>(static_end - static_start).count() / num_checks);
+    std::printf("[ BENCHMARK ] chain adaptive %9.1f ns/post\n",
+                std::chrono::duration<double, std::nano>(chain_end - chain_start).count() / num_checks);
+
+    // The order must not change which posts are accepted
+    EXPECT_EQ(chain_accepted, static_accepted);
+
+    ModerationStrategyStats_Array stats{};
+    ASSERT_EQ(chain.getStatistics(stats), 2);
+    EXPECT_EQ(stats[0].getposition(), 1);
+    EXPECT_EQ(stats[1].getposition(), 0);
+    EXPECT_EQ(stats[1].getchecks(), ITERATIONS * posts.size());
+}
+
+/**
+ * @brief Strategy whose check is about as cheap as the call itself, so the benchmark measures the call overhead
+ */
+class MaxLengthModerationStrategy final : public ModerationStrategy
+{
+    public:
+        bool checkMessage(const SpacePosts::SpacePost &message) override
+        {
+            return message.getmessage_content().length() <= 200;
+        }
+};
+
+TEST(ModeratorBenchmark, StaticDispatchOverhead)
+{
+    std::vector<SpacePost> posts{};
+    for (const std::string &post : POSTS)
+    {
+        posts.emplace_back(post.c_str());
+    }
+
+    MaxLengthModerationStrategy strategy{};
+    // Hide the actual type from the compiler, as for the strategy injected into the Moderator
+    ModerationStrategy *volatile opaque_strategy = &strategy;
+    ModerationStrategy &interface_strategy = *opaque_strategy;
+
+    U32 virtual_accepted{0};
+    const auto virtual_start = std::chrono::steady_clock::now();
+    for (U32 i = 0; i < DISPATCH_ITERATIONS; i++)
+    {
+        for (const SpacePost &post : posts)
+        {
+            virtual_accepted += StrategyDispatch<ModerationStrategy>::checkMessage(interface_strategy, post);
+        }
+    }
+    const auto virtual_end = std::chrono::steady_clock::now();
+
+    U32 static_accepted{0};
+    const auto static_start = std::chrono::steady_clock::now();
+    for (U32 i = 0; i < DISPATCH_ITERATIONS; i++)
+    {
+        for (const SpacePost &post : posts)
+        {
+            static_accepted += StrategyDispatch<MaxLengthModerationStrategy>::checkMessage(strategy, post);
+        }
+    }
+    const auto static_end = std::chrono::steady_clock::now();
+
+    const double num_checks = static_cast<double>(DISPATCH_ITERATIONS) * posts.size();
+    std::printf("[ BENCHMARK ] dispatch virtual %7.2f ns/post\n",
+                std::chrono::duration<double, std::nano>(virtual_end - virtual_start).count() / num_checks);
+    std::printf("[ BENCHMARK ] dispatch static  %7.2f ns/post\n",
+                std::chrono::duration<double, std::nano>(static_end - static_start).count() / num_checks);
+    EXPECT_EQ(virtual_accepted, static_accepted);
+}
+
+TEST(ModeratorBenchmark, RepetitionCheck)
+{
+    RepetitionModerationStrategy strategy{600, 3};
+    std::vector<SpacePost> posts{};
+    for (const std::string &post : POSTS)
+    {
+        posts.emplace_back(post.c_str());
+    }
+
+    U32 accepted{0};
+    const auto start = std::chrono::steady_clock::now();
+    for (U32 i = 0; i < ITERATIONS; i++)
+    {
+        for (const SpacePost &post : posts)
+        {
+            accepted += strategy.checkMessage(post);
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    // The number of accepted posts keeps the checks from being optimized away. The decisions are checked by the
+    // unit tests
+    std::printf("[ BENCHMARK ] repetition    %10.1f ns/post, %u accepted\n",
+                std::chrono::duration<double, std::nano>(end - start).count() / (ITERATIONS * posts.size()),
+                accepted);
+}
+
+TEST(ModeratorBenchmark, ReloadableBlocklistDuringReloads)
+{
+    const std::vector<std::string> blocklist = generateBlocklist(1000);
+    AhoCorasickModerationStrategy strategy{true};
+    for (const std::string &term : blocklist)
+    {
+        ASSERT_TRUE(strategy.addPattern(term.c_str(), term.length()));
+    }
+    ASSERT_TRUE(strategy.addPattern("antenna", 7));
+    strategy.build();
+
+    std::vector<U8> file(strategy.getSerializedSize());
+    ASSERT_EQ(strategy.serialize(file.data(), file.size()), file.size());
+    const char *const path = "/tmp/Moderator_perf_blocklist.bin";
+    std::FILE *const stream = std::fopen(path, "wb");
+    ASSERT_NE(stream, nullptr);
+    ASSERT_EQ(std::fwrite(file.data(), 1, file.size(), stream), file.size());
+    ASSERT_EQ(std::fclose(stream), 0);
+
+    ReloadableBlocklist reloadable{};
+    BlocklistFileError stage{};
+    I32 error_code{0};
+    ASSERT_TRUE(reloadable.reload(path, stage, error_code));
+
+    // Times the checks of all posts and returns the slowest pass. The decisions during reloads are checked by the
+    // unit tests. The matches only keep the checks from being optimized away
+    U32 matches{0};
+    const auto check_all = [&reloadable, &matches](double &totalNs)
+    {
+        double max_pass_ns{0};
+        const auto start = std::chrono::steady_clock::now();
+        for (U32 i = 0; i < ITERATIONS; i++)
+        {
+            const auto pass_start = std::chrono::steady_clock::now();
+            for (const std::string &post : POSTS)
+            {
+                matches += reloadable.containsPattern(reinterpret_cast<const U8 *>(post.c_str()), post.length());
+            }
+            const double pass_ns =
+                std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - pass_start).count();
+            max_pass_ns = (pass_ns > max_pass_ns) ? pass_ns : max_pass_ns;
+        }
+        totalNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        return max_pass_ns;
+    };
+
+    double idle_ns{0};
+    const double idle_max_ns = check_all(idle_ns);
+
+    std::atomic<bool> checking{true};
+    U32 reloads{0};
+    std::thread reloader{[&]()
+                         {
+                             BlocklistFileError reload_stage{};
+                             I32 reload_error_code{0};
+                             while (checking.load())
+                             {
+                                 reloads += reloadable.reload(path, reload_stage, reload_error_code) ? 1 : 0;
+                             }
+                         }};
+    double reloading_ns{0};
+    const double reloading_max_ns = check_all(reloading_ns);
+    checking.store(false);
+    reloader.join();
+
+    std::printf("[ BENCHMARK ] blocklist idle      %10.1f ns/post, slowest pass %10.1f ns\n",
+                idle_ns / (ITERATIONS * POSTS.size()), idle_max_ns);
+    std::printf("[ BENCHMARK ] blocklist reloading %10.1f ns/post, slowest pass %10.1f ns, %u reloads, %u matches\n",
+                reloading_ns / (ITERATIONS * POSTS.size()), reloading_max_ns, reloads, matches);
+    (void)std::remove(path);
+}
+
+TEST(ModeratorBenchmark, FuzzyBlocklist100)
+{
+    const std::vector<std::string> blocklist = generateBlocklist(100);
+    FuzzyModerationStrategy strategy{1};
+    for (const std::string &term : blocklist)
+    {
+        ASSERT_TRUE(strategy.addTerm(term.c_str(), term.length()));
+    }
+
+    U32 matches{0};
+    const auto start = std::chrono::steady_clock::now();
+    for (U32 i = 0; i < ITERATIONS; i++)
+    {
+        for (const std::string &post : POSTS)
+        {
+            matches += strategy.containsTerm(reinterpret_cast<const U8 *>(post.c_str()), post.length());
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+    printResult("fuzzy (k=1)", blocklist.size(), std::chrono::duration<double, std::nano>(end - start).count());
+    // Every pass matches the same posts
+    EXPECT_EQ(matches % ITERATIONS, 0U);
+}
+
+/**
+ * @brief Times the validation of the given text with the fastest and the scalar variant
+ */
+void benchmarkUtf8Validation(const char *const name, const std::string &text)
+{
+    const U8 *const bytes = reinterpret_cast<const U8 *>(text.c_str());
+    U32 valid{0};
+    const auto start = std::chrono::steady_clock::now();
+    for (U32 i = 0; i < SCREEN_ITERATIONS; i++)
+    {
+        valid += Utf8Validator::isValid(bytes, text.length());
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    U32 scalar_valid{0};
+    const auto scalar_start = std::chrono::steady_clock::now();
+    for (U32 i = 0; i < SCREEN_ITERATIONS; i++)
+    {
+        scalar_valid += Utf8Validator::isValidScalar(bytes, text.length());
+    }
+    const auto scalar_end = std::chrono::steady_clock::now();
+
+    std::printf("[ BENCHMARK ] utf-8 %-7s %3zu bytes %8.1f ns/post (scalar %8.1f ns/post)\n", name, text.length(),
+                std::chrono::duration<double, std::nano>(end - start).count() / SCREEN_ITERATIONS,
+                std::chrono::duration<double, std::nano>(scalar_end - scalar_start).count() / SCREEN_ITERATIONS);
+    EXPECT_EQ(valid, scalar_valid);
+}
+
+TEST(ModeratorBenchmark, Utf8ValidationMaxText)
+{
+    benchmarkUtf8Validation("ascii", std::string(MAX_MSGTEXT_LENGTH, 'a'));
+    benchmarkUtf8Validation("mixed", generateUtf8Text(MAX_MSGTEXT_LENGTH, 1));
+}
+
+// Execute benchmarks
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,507 @@
+// ======================================================================
+// \title  Moderator/test/ut/StrategyTester.cpp
+// \author Marius Baden
+// \brief  cpp file for the tests of the moderation strategies and their building blocks
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/stat.h>
+
+#include "gtest/gtest.h"
+
+#include "StrategyTester.hpp"
+#include "model/BlocklistFile.hpp"
+#include "model/KeywordModerationStrategy.hpp"
+#include "model/Utf8Text.hpp"
+#include "config/ModeratorCfg.hpp"
+#include "SpacePosts/Moderator/AhoCorasickModerationStrategy.hpp"
+#include "SpacePosts/Moderator/ByteClassModerationStrategy.hpp"
+#include "SpacePosts/Moderator/CompiledBlocklist.hpp"
+#include "SpacePosts/Moderator/CompositeModerationStrategy.hpp"
+#include "SpacePosts/Moderator/FuzzyModerationStrategy.hpp"
+#include "SpacePosts/Moderator/ReloadableBlocklist.hpp"
+#include "SpacePosts/Moderator/RepetitionModerationStrategy.hpp"
+#include "SpacePosts/Moderator/Utf8Validator.hpp"
+#include "SpacePosts/MessageTypes/FppConstantsAc.hpp"
+
+namespace SpacePosts
+{
+
+  namespace
+  {
+    constexpr U32 MAX_MSGTEXT_LENGTH = FppConstant_SpacePost_MaxTextLength::SpacePost_MaxTextLength;
+
+    // Number of random texts per randomized test
+    constexpr U32 NUM_RANDOM_ROUNDS = 2000;
+
+    // Offsets of the parts of a compiled blocklist file (see CompiledBlocklist.hpp)
+    constexpr size_t BYTE_CLASSES_OFFSET = CompiledBlocklist::HEADER_WORDS * sizeof(U32);
+    constexpr size_t TRANSITIONS_OFFSET = BYTE_CLASSES_OFFSET + 256;
+
+    /**
+     * @brief Reads the U32 at the given byte offset of a compiled blocklist file
+     */
+    U32 getWord(const std::vector<U8> &contents, const size_t offset)
+    {
+      U32 word{0};
+      (void)std::memcpy(&word, contents.data() + offset, sizeof(word));
+      return word;
+    }
+
+    /**
+     * @brief Returns a copy of a compiled blocklist file with the U32 at the given byte offset replaced
+     */
+    std::vector<U8> withWord(const std::vector<U8> &contents, const size_t offset, const U32 word)
+    {
+      std::vector<U8> changed{contents};
+      (void)std::memcpy(changed.data() + offset, &word, sizeof(word));
+      return changed;
+    }
+
+    /**
+     * @brief Checks whether a text contains a term within maxEdits edits with the edit distance matrix (Sellers)
+     */
+    bool dynamicProgrammingContainsTerm(const std::vector<U8> &term, const std::vector<U8> &text, const U32 maxEdits)
+    {
+      // Column of the edit distances between the term prefixes and the best substring ending at the current position
+      std::vector<U32> column(term.size() + 1);
+      for (U32 i = 0; i <= term.size(); i++)
+      {
+        column[i] = i;
+      }
+      for (const U8 character : text)
+      {
+        U32 diagonal{column[0]};
+        for (U32 i = 1; i <= term.size(); i++)
+        {
+          const U32 substituted = diagonal + (term[i - 1] == character ? 0 : 1);
+          diagonal = column[i];
+          const U32 inserted = column[i] + 1;
+          const U32 deleted = column[i - 1] + 1;
+          column[i] = std::min(substituted, std::min(inserted, deleted));
+        }
+        if (column[term.size()] <= maxEdits)
+        {
+          return true;
+        }
+      }
+      return false;
+    }
+  }
+
+  // ----------------------------------------------------------------------
+  // Blocklist Tests
+  // ----------------------------------------------------------------------
+
+  void StrategyTester::testAhoCorasickDetectsTerms()
+  {
+    AhoCorasickModerationStrategy strategy{true};
+    ASSERT_TRUE(strategy.addPattern("he", 2));
+    ASSERT_TRUE(strategy.addPattern("she", 3));
+    ASSERT_TRUE(strategy.addPattern("hers", 4));
+    ASSERT_TRUE(strategy.addPattern("spam", 4));
+    ASSERT_FALSE(strategy.addPattern("", 0));
+    strategy.build();
+    ASSERT_FALSE(strategy.addPattern("late", 4));
+
+    const auto contains = [&strategy](const std::string &text)
+    { return strategy.containsPattern(reinterpret_cast<const U8 *>(text.c_str()), text.length()); };
+    EXPECT_TRUE(contains("ushers"));
+    EXPECT_TRUE(contains("Buy SPAM now"));
+    EXPECT_TRUE(contains("spaspam"));
+    EXPECT_FALSE(contains("spa sp am"));
+    EXPECT_FALSE(contains(""));
+    EXPECT_FALSE(contains("late"));
+  }
+
+  void StrategyTester::testFuzzyDetectsObfuscatedTerms()
+  {
+    FuzzyModerationStrategy strategy{1};
+    ASSERT_TRUE(strategy.addTerm("hello", 5));
+    ASSERT_TRUE(strategy.addTerm("cheap antennas", 14));
+    // Would match every text
+    EXPECT_FALSE(strategy.addTerm("a", 1));
+    EXPECT_EQ(strategy.getNumTerms(), 2U);
+
+    const auto contains = [&strategy](const char *const text)
+    { return strategy.containsTerm(reinterpret_cast<const U8 *>(text), std::strlen(text)); };
+    EXPECT_TRUE(contains("say HELLO to everyone"));
+    EXPECT_TRUE(contains("say h3ll0 to everyone"));
+    EXPECT_TRUE(contains("say h.e.l.l.o to everyone"));
+    EXPECT_TRUE(contains("say heeeellllooooo to everyone"));
+    EXPECT_TRUE(contains("say hxllo to everyone"));
+    EXPECT_TRUE(contains("buy CHE4P  ant3nnnas now"));
+    EXPECT_FALSE(contains("say hi to everyone"));
+    EXPECT_FALSE(contains("Greetings from the science class of Lincoln Middle School"));
+  }
+
+  void StrategyTester::testFuzzyMatchesDynamicProgramming()
+  {
+    std::mt19937 random{42};
+    std::uniform_int_distribution<int> character{'a', 'f'};
+    std::uniform_int_distribution<U32> term_length{3, 64};
+    std::uniform_int_distribution<U32> text_length{0, 200};
+
+    for (U32 round = 0; round < NUM_RANDOM_ROUNDS; round++)
+    {
+      const U32 max_edits = round % 4;
+      FuzzyModerationStrategy strategy{max_edits};
+
+      // Repeated characters are collapsed, so generate texts which have none
+      const auto generate = [&](const U32 length)
+      {
+        std::string text{};
+        while (text.length() < length)
+        {
+          const char next = static_cast<char>(character(random));
+          if (text.empty() || text.back() != next)
+          {
+            text.push_back(next);
+          }
+        }
+        return text;
+      };
+      const std::string term = generate(term_length(random));
+      const std::string text = generate(text_length(random));
+      ASSERT_EQ(strategy.addTerm(term.c_str(), term.length()), term.length() > max_edits);
+
+      std::vector<U8> normalized_term(term.length());
+      normalized_term.resize(strategy.normalize(reinterpret_cast<const U8 *>(term.c_str()), term.length(),
+                                                normalized_term.data()));
+      std::vector<U8> normalized_text(text.length());
+      normalized_text.resize(strategy.normalize(reinterpret_cast<const U8 *>(text.c_str()), text.length(),
+                                                normalized_text.data()));
+
+      EXPECT_EQ(strategy.containsTerm(reinterpret_cast<const U8 *>(text.c_str()), text.length()),
+                strategy.getNumTerms() > 0 &&
+                    dynamicProgrammingContainsTerm(normalized_term, normalized_text, max_edits))
+          << term << " in " << text << " with " << max_edits << " edits";
+    }
+  }
+
+  // ----------------------------------------------------------------------
+  // Screening Tests
+  // ----------------------------------------------------------------------
+
+  void StrategyTester::testByteClassCountsMatchScalar()
+  {
+    std::mt19937 random{0};
+    std::uniform_int_distribution<int> byte{0, 255};
+    for (U32 length = 0; length <= MAX_MSGTEXT_LENGTH; length++)
+    {
+      std::vector<U8> text(length);
+      for (U8 &character : text)
+      {
+        character = static_cast<U8>(byte(random));
+      }
+      const ByteClassModerationStrategy::ByteCounts counts =
+          ByteClassModerationStrategy::countByteClasses(text.data(), length);
+      const ByteClassModerationStrategy::ByteCounts scalar_counts =
+          ByteClassModerationStrategy::countByteClassesScalar(text.data(), length);
+      EXPECT_EQ(counts.control, scalar_counts.control) << "length " << length;
+      EXPECT_EQ(counts.highBit, scalar_counts.highBit) << "length " << length;
+    }
+
+    const std::string text{"ok\tline\r\n\x01\x7F\x80\xFF"};
+    const ByteClassModerationStrategy::ByteCounts counts =
+        ByteClassModerationStrategy::countByteClasses(reinterpret_cast<const U8 *>(text.c_str()), text.length());
+    EXPECT_EQ(counts.control, 2U);
+    EXPECT_EQ(counts.highBit, 2U);
+  }
+
+  void StrategyTester::testUtf8ValidationMatchesScalar()
+  {
+    std::mt19937 random{7};
+    std::uniform_int_distribution<int> byte{0, 255};
+    std::uniform_int_distribution<U32> position{0, MAX_MSGTEXT_LENGTH - 1};
+    for (U32 i = 0; i < NUM_RANDOM_ROUNDS; i++)
+    {
+      std::string text = generateUtf8Text(MAX_MSGTEXT_LENGTH, i);
+      const U8 *const bytes = reinterpret_cast<const U8 *>(text.c_str());
+      ASSERT_TRUE(Utf8Validator::isValid(bytes, text.length()));
+
+      // Corrupt a byte, which may or may not break the encoding
+      text[position(random) % text.length()] = static_cast<char>(byte(random));
+      const bool valid = Utf8Validator::isValidScalar(bytes, text.length());
+      EXPECT_EQ(Utf8Validator::isValid(bytes, text.length()), valid);
+
+      std::string sanitized{text};
+      const U32 replaced = Utf8Validator::sanitize(reinterpret_cast<U8 *>(&sanitized[0]), sanitized.length());
+      EXPECT_EQ(replaced == 0, valid);
+      EXPECT_TRUE(Utf8Validator::isValid(reinterpret_cast<const U8 *>(sanitized.c_str()), sanitized.length()));
+    }
+
+    // Overlong encoding, surrogate, beyond U+10FFFF, truncated sequence
+    for (const char *const invalid : {"\xC0\xAF", "\xED\xA0\x80", "\xF4\x90\x80\x80", "abc\xE2\x82"})
+    {
+      EXPECT_FALSE(Utf8Validator::isValid(reinterpret_cast<const U8 *>(invalid), std::strlen(invalid))) << invalid;
+    }
+  }
+
+  // ----------------------------------------------------------------------
+  // Repetition Tests
+  // ----------------------------------------------------------------------
+
+  void StrategyTester::testRepetitionCountsNearIdenticalCopies()
+  {
+    RepetitionModerationStrategy strategy{60, 2};
+    const auto count = [&strategy](const std::string &text, const U64 nowMs)
+    { return strategy.countCopy(reinterpret_cast<const U8 *>(text.c_str()), text.length(), nowMs); };
+
+    EXPECT_EQ(count("Buy cheap antennas now!!!", 0), 1U);
+    EXPECT_EQ(count("buy CHEAP antennas now", 1000), 2U);
+    EXPECT_EQ(count("Buy cheap antennas, now.", 30000), 3U);
+    EXPECT_EQ(count("Greetings from Lincoln Middle School", 30000), 1U);
+
+    // The first two copies have left the window, the one at 30 s has not
+    EXPECT_EQ(count("Buy cheap antennas now", 75000), 2U);
+    // All copies have left the window
+    EXPECT_EQ(count("Buy cheap antennas now", 200000), 1U);
+
+    // Different texts in other scripts are no copies of each other
+    EXPECT_EQ(count("\xD0\x9F\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82!", 200000), 1U);
+    EXPECT_EQ(count("\xD0\x9F\xD0\xBE\xD0\xBA\xD0\xB0!", 200000), 1U);
+    EXPECT_EQ(count("\xD0\x9F\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82 ...", 200000), 2U);
+
+    // Texts which are empty after normalizing are not counted
+    EXPECT_EQ(count("", 200000), 0U);
+    EXPECT_EQ(count("!!! ...", 200000), 0U);
+    EXPECT_EQ(count("?!", 200000), 0U);
+
+    // A check accepts the first maxCopies copies within the window and rejects the following ones
+    RepetitionModerationStrategy limited{600, 3};
+    const SpacePost post{"CQ CQ DE DL5ABC QTH JO62qm"};
+    for (U32 i = 0; i < 10; i++)
+    {
+      EXPECT_EQ(limited.checkMessage(post), i < 3) << "Unexpected decision for copy " << i;
+    }
+  }
+
+  // ----------------------------------------------------------------------
+  // Composite Tests
+  // ----------------------------------------------------------------------
+
+  void StrategyTester::testCompositeKeepsPinnedStrategy(const bool pinned)
+  {
+    // The keywords of the strategies which never reject do not occur in any SpacePost
+    KeywordModerationStrategy first_accepting{"<none>"};
+    KeywordModerationStrategy spam_rejecting{"spam"};
+    KeywordModerationStrategy recording{"<none>"};
+    KeywordModerationStrategy second_accepting{"<none>"};
+    KeywordModerationStrategy late_rejecting{"late"};
+    CompositeModerationStrategy chain{};
+    ASSERT_TRUE(chain.addStrategy(first_accepting));
+    ASSERT_TRUE(chain.addStrategy(spam_rejecting));
+    ASSERT_TRUE(chain.addStrategy(recording, pinned));
+    ASSERT_TRUE(chain.addStrategy(second_accepting));
+    ASSERT_TRUE(chain.addStrategy(late_rejecting));
+
+    // Across several reorderings. Only "post" SpacePosts pass all strategies
+    const char *const kinds[] = {"post", "spam", "late"};
+    std::vector<std::string> reaching_recording{};
+    for (U32 i = 0; i < 3 * MODERATOR_COMPOSITE_REORDER_INTERVAL; i++)
+    {
+      const std::string text = std::string(kinds[i % 3]) + " " + std::to_string(i);
+      ASSERT_EQ(chain.checkMessage(SpacePost{text.c_str()}), i % 3 == 0) << text;
+      if (i % 3 != 1)
+      {
+        reaching_recording.push_back(text);
+      }
+    }
+
+    if (!pinned)
+    {
+      // The late SpacePosts are rejected before they reach the recording strategy once it has been moved
+      ASSERT_LT(recording.getCheckedTexts().size(), reaching_recording.size());
+      return;
+    }
+
+    // Every SpacePost which the strategies before it accept reaches the pinned strategy
+    ASSERT_EQ(recording.getCheckedTexts(), reaching_recording);
+
+    // The rejecting strategies run first within their segment
+    ModerationStrategyStats_Array stats{};
+    ASSERT_EQ(chain.getStatistics(stats), 5);
+    EXPECT_EQ(stats[0].getposition(), 1);
+    EXPECT_EQ(stats[1].getposition(), 0);
+    EXPECT_EQ(stats[2].getposition(), 2);
+    EXPECT_EQ(stats[3].getposition(), 4);
+    EXPECT_EQ(stats[4].getposition(), 3);
+  }
+
+  // ----------------------------------------------------------------------
+  // Blocklist File Tests
+  // ----------------------------------------------------------------------
+
+  void StrategyTester::testBlocklistReloadRejectsInvalidFiles()
+  {
+    U32 num_states{0};
+    const std::vector<U8> valid = compileBlocklist({"antenna", "rover"}, num_states);
+    ASSERT_GT(valid.size(), TRANSITIONS_OFFSET);
+    const U32 num_classes = getWord(valid, 2 * sizeof(U32));
+    ASSERT_GT(num_classes, 1U);
+    const char *const valid_path = "/tmp/Moderator_ut_blocklist.bin";
+    ASSERT_TRUE(writeBlocklistFile(valid_path, valid));
+
+    ReloadableBlocklist blocklist{};
+    BlocklistFileError stage{};
+    I32 error_code{0};
+    ASSERT_TRUE(blocklist.reload(valid_path, stage, error_code));
+    ASSERT_EQ(blocklist.getNumStates(), num_states);
+
+    const auto contains = [&blocklist](const std::string &text)
+    { return blocklist.containsPattern(reinterpret_cast<const U8 *>(text.c_str()), text.length()); };
+
+    // Reloads the file, checks that it fails at the expected stage and that the previous blocklist stays in use.
+    // Returns the error code
+    const auto reloadFails = [&](const char *const path, const BlocklistFileError::T expectedStage)
+    {
+      BlocklistFileError failed_stage{};
+      I32 failed_code{0};
+      EXPECT_FALSE(blocklist.reload(path, failed_stage, failed_code)) << path;
+      EXPECT_EQ(failed_stage.e, expectedStage) << path;
+      EXPECT_EQ(blocklist.getNumStates(), num_states);
+      EXPECT_TRUE(contains("The ROVER has landed"));
+      EXPECT_FALSE(contains("The lander has landed"));
+      return failed_code;
+    };
+
+    // The corrupt files are written to another path. Overwriting the loaded file would change its mapping
+    const char *const invalid_path = "/tmp/Moderator_ut_blocklist_invalid.bin";
+    const auto invalidFileFails = [&](const std::vector<U8> &contents, const BlocklistFileError::T expectedStage)
+    {
+      EXPECT_TRUE(writeBlocklistFile(invalid_path, contents));
+      return reloadFails(invalid_path, expectedStage);
+    };
+
+    const char *const missing_path = "/tmp/Moderator_ut_blocklist_missing.bin";
+    (void)std::remove(missing_path);
+    EXPECT_EQ(reloadFails(missing_path, BlocklistFileError::OPEN), ENOENT);
+
+    // A directory can be opened and its size read, but it cannot be mapped. Add entries until it is large enough
+    // for the header
+    const std::string directory = "/tmp/Moderator_ut_blocklist_dir";
+    (void)::mkdir(directory.c_str(), 0700);
+    struct stat directory_stat{};
+    for (U32 i = 0; i < 1000 && ::stat(directory.c_str(), &directory_stat) == 0 &&
+                    directory_stat.st_size < static_cast<off_t>(TRANSITIONS_OFFSET);
+         i++)
+    {
+      ASSERT_TRUE(writeBlocklistFile((directory + "/" + std::to_string(i)).c_str(), {}));
+    }
+    ASSERT_GE(directory_stat.st_size, static_cast<off_t>(TRANSITIONS_OFFSET));
+    EXPECT_NE(reloadFails(directory.c_str(), BlocklistFileError::MAP), 0);
+
+    // The size of a file too small for the header is reported
+    const std::vector<U8> too_small(valid.begin(), valid.begin() + TRANSITIONS_OFFSET - 1);
+    EXPECT_EQ(invalidFileFails(too_small, BlocklistFileError::SIZE), static_cast<I32>(TRANSITIONS_OFFSET - 1));
+    EXPECT_EQ(invalidFileFails({}, BlocklistFileError::SIZE), 0);
+
+    // The offset of the first invalid word is reported
+    EXPECT_EQ(invalidFileFails(withWord(valid, 0, ~getWord(valid, 0)), BlocklistFileError::CONTENT), 0);
+    EXPECT_EQ(invalidFileFails(withWord(valid, sizeof(U32), getWord(valid, sizeof(U32)) + 1),
+                               BlocklistFileError::CONTENT),
+              static_cast<I32>(sizeof(U32)));
+    EXPECT_EQ(invalidFileFails(withWord(valid, 2 * sizeof(U32), 0), BlocklistFileError::CONTENT),
+              static_cast<I32>(2 * sizeof(U32)));
+
+    const std::vector<U8> truncated(valid.begin(), valid.end() - sizeof(U32));
+    EXPECT_EQ(invalidFileFails(truncated, BlocklistFileError::CONTENT), static_cast<I32>(3 * sizeof(U32)));
+
+    std::vector<U8> byte_class_out_of_range{valid};
+    byte_class_out_of_range[BYTE_CLASSES_OFFSET + 'r'] = static_cast<U8>(num_classes);
+    EXPECT_EQ(invalidFileFails(byte_class_out_of_range, BlocklistFileError::CONTENT),
+              static_cast<I32>(BYTE_CLASSES_OFFSET + 'r'));
+
+    // Transitions must be the start of a row within the table, with or without the match flag
+    const size_t last_transition = valid.size() - sizeof(U32);
+    EXPECT_EQ(invalidFileFails(withWord(valid, last_transition, num_states * num_classes),
+                               BlocklistFileError::CONTENT),
+              static_cast<I32>(last_transition));
+    EXPECT_EQ(invalidFileFails(withWord(valid, TRANSITIONS_OFFSET, AhoCorasickModerationStrategy::MATCH_FLAG | 1),
+                               BlocklistFileError::CONTENT),
+              static_cast<I32>(TRANSITIONS_OFFSET));
+
+    // A valid file replaces the blocklist
+    U32 next_num_states{0};
+    const char *const next_path = "/tmp/Moderator_ut_blocklist_next.bin";
+    ASSERT_TRUE(writeBlocklistFile(next_path, compileBlocklist({"lander"}, next_num_states)));
+    ASSERT_TRUE(blocklist.reload(next_path, stage, error_code));
+    EXPECT_EQ(blocklist.getNumStates(), next_num_states);
+    EXPECT_TRUE(contains("The lander has landed"));
+    EXPECT_FALSE(contains("The ROVER has landed"));
+  }
+
+  void StrategyTester::testBlocklistChecksDuringReloads()
+  {
+    U32 num_states{0};
+    const std::vector<U8> contents = compileBlocklist({"antenna", "rover"}, num_states);
+    // Reloading alternates between two files, so that every reload switches the slot and unloads the previous one
+    const char *const paths[] = {"/tmp/Moderator_ut_reload_0.bin", "/tmp/Moderator_ut_reload_1.bin"};
+    for (const char *const path : paths)
+    {
+      ASSERT_TRUE(writeBlocklistFile(path, contents));
+    }
+
+    ReloadableBlocklist blocklist{};
+    BlocklistFileError stage{};
+    I32 error_code{0};
+    ASSERT_TRUE(blocklist.reload(paths[0], stage, error_code));
+
+    const std::vector<std::string> texts{"We built our own antenna for this pass!", "CQ CQ DE DL5ABC QTH JO62qm",
+                                         "The ROVER has landed", ""};
+    const std::vector<bool> expected_matches{true, false, true, false};
+
+    std::atomic<bool> checking{true};
+    std::atomic<U32> num_reloads{0};
+    std::atomic<U32> num_failed_reloads{0};
+    std::thread reloader{[&]()
+                         {
+                           BlocklistFileError reload_stage{};
+                           I32 reload_error_code{0};
+                           for (U32 i = 1; checking.load(); i++)
+                           {
+                             if (!blocklist.reload(paths[i % 2], reload_stage, reload_error_code))
+                             {
+                               ++num_failed_reloads;
+                             }
+                             ++num_reloads;
+                           }
+                         }};
+
+    // Keep checking until the reloads have switched the slot many times
+    constexpr U32 MIN_RELOADS = 100;
+    U32 num_wrong_checks{0};
+    for (U32 round = 0; round < NUM_RANDOM_ROUNDS || num_reloads.load() < MIN_RELOADS; round++)
+    {
+      for (U32 i = 0; i < texts.size(); i++)
+      {
+        const bool matches =
+            blocklist.containsPattern(reinterpret_cast<const U8 *>(texts[i].c_str()), texts[i].length());
+        num_wrong_checks += (matches != expected_matches[i]) ? 1 : 0;
+      }
+    }
+    checking.store(false);
+    reloader.join();
+
+    EXPECT_EQ(num_wrong_checks, 0U);
+    EXPECT_EQ(num_failed_reloads.load(), 0U);
+    EXPECT_EQ(blocklist.getNumStates(), num_states);
+  }
+
+} // end namespace SpacePosts
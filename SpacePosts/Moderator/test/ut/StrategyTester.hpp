@@ -0,0 +1,147 @@
+// ======================================================================
+// \title  Moderator/test/ut/StrategyTester.hpp
+// \author Marius Baden
+// \brief  hpp file for the tests of the moderation strategies and their building blocks
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#ifndef STRATEGY_TESTER_HPP
+#define STRATEGY_TESTER_HPP
+
+#include "Fw/Types/BasicTypes.hpp"
+
+namespace SpacePosts
+{
+
+  /**
+   * @brief Tests the moderation strategies and their building blocks without a Moderator component.
+   *
+   * Their timing is measured by the Moderator_perf benchmark build. These tests only check their decisions.
+   */
+  class StrategyTester
+  {
+
+  public:
+    // ----------------------------------------------------------------------
+    // Tests
+    // ----------------------------------------------------------------------
+
+    /*
+        UT-MOD-070
+        Test detecting blocklisted terms with the Aho-Corasick automaton
+    */
+
+    /**
+     * @brief Builds an automaton of overlapping terms and checks which texts contain one of them.
+     *
+     * Terms are found regardless of the case of letters, within other words, and after a partial match. Empty terms
+     * and terms added after building are refused.
+     */
+    void testAhoCorasickDetectsTerms();
+
+    /*
+        UT-MOD-080
+        Test counting byte classes with the vectorized screening
+    */
+
+    /**
+     * @brief Counts the control and high-bit bytes of random texts of every length up to SpacePost_MaxTextLength and
+     * checks that the vectorized variant counts as the scalar one.
+     */
+    void testByteClassCountsMatchScalar();
+
+    /*
+        UT-MOD-090
+        Test counting copies of a SpacePost within the time window of the repetition strategy
+    */
+
+    /**
+     * @brief Counts texts which differ in case and punctuation only and checks that they are counted as copies
+     * until they have left the time window.
+     *
+     * Also checks that different Cyrillic texts are no copies of each other, that texts which are empty after
+     * normalizing are not counted, and that checking a SpacePost repeatedly accepts only its first maxCopies copies.
+     */
+    void testRepetitionCountsNearIdenticalCopies();
+
+    /*
+        UT-MOD-100
+        Test detecting obfuscated terms with the fuzzy strategy
+    */
+
+    /**
+     * @brief Checks that leetspeak, inserted punctuation, repeated letters, and single edits of a term are detected.
+     */
+    void testFuzzyDetectsObfuscatedTerms();
+
+    /**
+     * @brief Matches random terms in random texts with up to 3 edits and checks that the bit-parallel matching
+     * decides as the edit distance matrix does.
+     */
+    void testFuzzyMatchesDynamicProgramming();
+
+    /*
+        UT-MOD-110
+        Test validating and sanitizing UTF-8
+    */
+
+    /**
+     * @brief Corrupts random valid UTF-8 texts and checks that the vectorized validation decides as the scalar one
+     * and that sanitizing makes every text valid. Also checks well-known invalid sequences.
+     */
+    void testUtf8ValidationMatchesScalar();
+
+    /*
+        UT-MOD-120
+        Test that reordering a CompositeModerationStrategy does not move pinned strategies
+    */
+
+    /**
+     * @brief Chains two strategies, a recording strategy, and two more strategies, checks SpacePosts across several
+     * reorderings, and checks which SpacePosts reach the recording strategy.
+     *
+     * If the recording strategy is pinned, it keeps its position and sees exactly the SpacePosts which the strategies
+     * before it accept, while the strategies before and after it are reordered among each other. If it is not
+     * pinned, reordering moves the rejecting strategies in front of it, so it misses SpacePosts it saw before.
+     *
+     * @param pinned Whether the recording strategy is added pinned
+     */
+    void testCompositeKeepsPinnedStrategy(const bool pinned);
+
+    /*
+        UT-MOD-130
+        Test rejecting invalid compiled blocklist files and keeping the previous blocklist
+    */
+
+    /**
+     * @brief Loads a valid compiled blocklist file, reloads files which cannot be opened, mapped, or which are
+     * corrupt, and checks the reported stage and error code of each. Finally reloads another valid file.
+     *
+     * Every failed reload keeps the previously loaded blocklist: its number of states is unchanged and it still
+     * matches its terms. The error code is the errno of a failed system call, the size of a too small file, or the
+     * byte offset of the first invalid word.
+     */
+    void testBlocklistReloadRejectsInvalidFiles();
+
+    /*
+        UT-MOD-150
+        Test checking texts against a blocklist while it is reloaded
+    */
+
+    /**
+     * @brief Checks texts against a blocklist while another thread keeps reloading it, alternating between two files
+     * of the same blocklist, and checks that every check decides as without the reloads.
+     *
+     * Every reload succeeds, and the checks continue until many reloads have switched the slot in use.
+     */
+    void testBlocklistChecksDuringReloads();
+  };
+
+} // end namespace SpacePosts
+
+#endif
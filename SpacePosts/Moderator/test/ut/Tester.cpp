@@ -0,0 +1,585 @@
+// ======================================================================
+// \title  Moderator/test/ut/Tester.cpp
+// \author Marius Baden
+// \brief  cpp file for Moderator test harness implementation class
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Tester.hpp"
+#include "model/BlocklistFile.hpp"
+#include "config/ModeratorCfg.hpp"
+#include "SpacePosts/MessageTypes/FppConstantsAc.hpp"
+
+#define INSTANCE 0
+#define CMD_SEQ 42
+// Large enough for one MESSAGE_REJECTED event per SpacePost of more than a full quarantine batch
+#define MAX_HISTORY_SIZE 256
+
+namespace SpacePosts
+{
+
+  namespace
+  {
+    constexpr U8 MAX_MSGBATCH_SIZE = FppConstant_SpacePost_Batch_Size::SpacePost_Batch_Size;
+
+    // Time at which every test starts, so that the tests can go back in time
+    constexpr U64 START_US = 1000ULL * 1000000;
+
+    constexpr U64 TELEMETRY_INTERVAL_US = static_cast<U64>(MODERATOR_TELEMETRY_INTERVAL_MS) * 1000;
+  }
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  Tester ::
+      Tester() :
+#if FW_OBJECT_NAMES == 1
+                 ModeratorGTestBase("Tester", MAX_HISTORY_SIZE),
+#else
+                 ModeratorGTestBase(MAX_HISTORY_SIZE),
+#endif
+                 m_strategy("reject"),
+                 component("Moderator", m_strategy),
+                 m_acceptedTexts(),
+                 m_numAcceptedBatches(0),
+                 m_quarantinedTexts(),
+                 m_numQuarantineBatches(0),
+                 m_quarantineCapacity(MAX_MSGBATCH_SIZE)
+  {
+    this->connectPorts();
+  }
+
+  Tester ::
+      ~Tester()
+  {
+  }
+
+  // ----------------------------------------------------------------------
+  // Rate Limit and Encoding Tests
+  // ----------------------------------------------------------------------
+
+  void Tester::testRateLimitShedsExcess(const U32 limit)
+  {
+    this->initComponents();
+    const U32 window_seconds{60};
+    this->paramSet_UPLINK_RATE_LIMIT(limit, Fw::ParamValid::VALID);
+    this->paramSet_UPLINK_RATE_WINDOW(window_seconds, Fw::ParamValid::VALID);
+    this->component.loadParameters();
+    this->setTimeUs(START_US);
+
+    // Shed SpacePosts are reported as OK like rejected ones
+    const U32 num_messages = limit + 3;
+    for (U32 i = 0; i < num_messages; i++)
+    {
+      ASSERT_EQ(this->moderate("post " + std::to_string(i)), MessageStorageStatus::OK);
+    }
+
+    // Shed SpacePosts are neither checked nor counted as rejected nor quarantined
+    const U32 num_admitted = (limit == 0) ? num_messages : limit;
+    ASSERT_EQ(this->m_acceptedTexts.size(), num_admitted);
+    ASSERT_EQ(this->m_strategy.getCheckedTexts(), this->m_acceptedTexts);
+    ASSERT_EVENTS_MESSAGE_REJECTED_SIZE(0);
+    this->invoke_to_quarantineSchedIn(0, 0);
+    ASSERT_EQ(this->m_numQuarantineBatches, 0U);
+
+    // The next telemetry reports the counts of the window
+    this->clearHistory();
+    this->setTimeUs(START_US + TELEMETRY_INTERVAL_US);
+    (void)this->moderate("post after the burst");
+    const U32 num_admitted_in_window = (limit == 0) ? num_messages + 1 : limit;
+    ASSERT_TLM_UPLINK_ADMIT_RATE_SIZE(1);
+    ASSERT_TLM_UPLINK_ADMIT_RATE(0, num_admitted_in_window);
+    ASSERT_TLM_UPLINK_SHED_RATE_SIZE(1);
+    ASSERT_TLM_UPLINK_SHED_RATE(0, num_messages + 1 - num_admitted_in_window);
+    ASSERT_TLM_REJECT_COUNT(0, 0);
+
+    // Once the window has slid past the burst, SpacePosts are admitted again
+    this->setTimeUs(START_US + (window_seconds + 1) * 1000000ULL);
+    ASSERT_EQ(this->moderate("post after the window"), MessageStorageStatus::OK);
+    ASSERT_EQ(this->m_acceptedTexts.back(), "post after the window");
+  }
+
+  void Tester::testUtf8Policy(const Utf8Policy::T policy)
+  {
+    this->initComponents();
+    this->paramSet_UTF8_POLICY(policy, Fw::ParamValid::VALID);
+    this->component.loadParameters();
+    this->clearHistory();
+
+    // Valid UTF-8 passes unchanged with every policy
+    const std::string valid{"caf\xC3\xA9 au lait"};
+    ASSERT_EQ(this->moderate(valid), MessageStorageStatus::OK);
+    ASSERT_EQ(this->m_acceptedTexts, std::vector<std::string>{valid});
+    ASSERT_EVENTS_MESSAGE_SANITIZED_SIZE(0);
+
+    // A Latin-1 encoded character, which is not valid UTF-8
+    const std::string invalid{"caf\xE9 au lait"};
+    ASSERT_EQ(this->moderate(invalid), MessageStorageStatus::OK);
+    this->invoke_to_quarantineSchedIn(0, 0);
+    switch (policy)
+    {
+    case Utf8Policy::ACCEPT:
+      ASSERT_EQ(this->m_acceptedTexts, (std::vector<std::string>{valid, invalid}));
+      ASSERT_EQ(this->m_strategy.getCheckedTexts(), this->m_acceptedTexts);
+      ASSERT_EVENTS_MESSAGE_SANITIZED_SIZE(0);
+      ASSERT_TRUE(this->m_quarantinedTexts.empty());
+      break;
+    case Utf8Policy::REJECT:
+      // Rejected before the strategy is called
+      ASSERT_EQ(this->m_acceptedTexts, std::vector<std::string>{valid});
+      ASSERT_EQ(this->m_strategy.getCheckedTexts(), std::vector<std::string>{valid});
+      ASSERT_EVENTS_MESSAGE_REJECTED_SIZE(1);
+      ASSERT_EQ(this->m_quarantinedTexts, std::vector<std::string>{invalid});
+      break;
+    case Utf8Policy::SANITIZE:
+    {
+      // The strategy and the downstream component see the sanitized content
+      const std::string sanitized{"caf? au lait"};
+      ASSERT_EQ(this->m_acceptedTexts, (std::vector<std::string>{valid, sanitized}));
+      ASSERT_EQ(this->m_strategy.getCheckedTexts(), this->m_acceptedTexts);
+      ASSERT_EVENTS_MESSAGE_SANITIZED_SIZE(1);
+      ASSERT_EVENTS_MESSAGE_SANITIZED(0, 1);
+      ASSERT_TRUE(this->m_quarantinedTexts.empty());
+
+      // A rejected SpacePost is quarantined as it was received
+      const std::string invalid_rejected{"reject \xFF\xFE"};
+      ASSERT_EQ(this->moderate(invalid_rejected), MessageStorageStatus::OK);
+      ASSERT_EQ(this->m_strategy.getCheckedTexts().back(), "reject ??");
+      this->invoke_to_quarantineSchedIn(0, 0);
+      ASSERT_EQ(this->m_quarantinedTexts, std::vector<std::string>{invalid_rejected});
+      break;
+    }
+    default:
+      FAIL() << "Unknown UTF8_POLICY " << policy;
+    }
+  }
+
+  void Tester::testDefaultsPassEverySpacePost()
+  {
+    this->initComponents();
+    this->setTimeUs(START_US);
+    this->clearHistory();
+
+    // More SpacePosts within a minute than a typical rate limit admits, each with invalid UTF-8
+    const U32 num_messages{150};
+    std::vector<std::string> texts{};
+    for (U32 i = 0; i < num_messages; i++)
+    {
+      texts.push_back("caf\xE9 " + std::to_string(i));
+      ASSERT_EQ(this->moderate(texts.back()), MessageStorageStatus::OK);
+    }
+
+    ASSERT_EQ(this->m_acceptedTexts, texts);
+    ASSERT_EVENTS_MESSAGE_SANITIZED_SIZE(0);
+    ASSERT_EVENTS_MESSAGE_REJECTED_SIZE(0);
+  }
+
+  // ----------------------------------------------------------------------
+  // Quarantine and Telemetry Tests
+  // ----------------------------------------------------------------------
+
+  void Tester::testQuarantine(const U32 numRejected, const U8 storeCapacity)
+  {
+    this->initComponents();
+    this->m_quarantineCapacity = storeCapacity;
+    this->setTimeUs(START_US);
+    this->clearHistory();
+
+    std::vector<std::string> rejected_texts{};
+    ASSERT_EQ(this->moderate("post"), MessageStorageStatus::OK);
+    for (U32 i = 0; i < numRejected; i++)
+    {
+      rejected_texts.push_back("reject " + std::to_string(i));
+      ASSERT_EQ(this->moderate(rejected_texts.back()), MessageStorageStatus::OK);
+    }
+    ASSERT_EVENTS_MESSAGE_REJECTED_SIZE(numRejected);
+
+    // Nothing is passed on before the scheduled call
+    ASSERT_EQ(this->m_numQuarantineBatches, 0U);
+
+    // The first rejected SpacePosts are passed on in one batch
+    this->clearHistory();
+    this->invoke_to_quarantineSchedIn(0, 0);
+    const U32 num_collected = std::min<U32>(numRejected, MAX_MSGBATCH_SIZE);
+    const U32 num_stored = std::min<U32>(num_collected, storeCapacity);
+    ASSERT_EQ(this->m_numQuarantineBatches, (num_collected > 0) ? 1U : 0U);
+    ASSERT_EQ(this->m_quarantinedTexts,
+              std::vector<std::string>(rejected_texts.begin(), rejected_texts.begin() + num_stored));
+    if (num_collected > 0)
+    {
+      ASSERT_TLM_QUARANTINE_COUNT_SIZE(1);
+      ASSERT_TLM_QUARANTINE_COUNT(0, num_stored);
+    }
+    else
+    {
+      ASSERT_TLM_SIZE(0);
+    }
+
+    // The call has taken all collected SpacePosts
+    this->invoke_to_quarantineSchedIn(0, 0);
+    ASSERT_EQ(this->m_numQuarantineBatches, (num_collected > 0) ? 1U : 0U);
+
+    // The next telemetry reports the SpacePosts which were not quarantined
+    this->clearHistory();
+    this->setTimeUs(START_US + TELEMETRY_INTERVAL_US);
+    (void)this->moderate("post");
+    ASSERT_TLM_QUARANTINE_DROPS_SIZE(1);
+    ASSERT_TLM_QUARANTINE_DROPS(0, numRejected - num_stored);
+  }
+
+  void Tester::testTelemetryInterval()
+  {
+    this->initComponents();
+    this->setTimeUs(START_US);
+    this->clearHistory();
+
+    // The first SpacePost writes the telemetry
+    (void)this->moderate("post 0");
+    ASSERT_TLM_ACCEPT_COUNT_SIZE(1);
+    ASSERT_TLM_ACCEPT_COUNT(0, 1);
+
+    // Nothing is written within the interval
+    this->clearHistory();
+    this->setTimeUs(START_US + TELEMETRY_INTERVAL_US - 1);
+    (void)this->moderate("post 1");
+    (void)this->moderate("reject 2");
+    ASSERT_TLM_SIZE(0);
+
+    // The first SpacePost after the interval writes the counts since startup
+    this->setTimeUs(START_US + TELEMETRY_INTERVAL_US);
+    (void)this->moderate("post 3");
+    ASSERT_TLM_ACCEPT_COUNT_SIZE(1);
+    ASSERT_TLM_ACCEPT_COUNT(0, 3);
+    ASSERT_TLM_REJECT_COUNT_SIZE(1);
+    ASSERT_TLM_REJECT_COUNT(0, 1);
+    ASSERT_TLM_CHECK_LATENCY_SIZE(1);
+    ASSERT_EQ(sumCounts(this->tlmHistory_CHECK_LATENCY->at(0).arg), 4U);
+    ASSERT_TLM_DOWNSTREAM_LATENCY_SIZE(1);
+    ASSERT_EQ(sumCounts(this->tlmHistory_DOWNSTREAM_LATENCY->at(0).arg), 3U);
+    ASSERT_TLM_CHECK_LATENCY_MAX_SIZE(1);
+    ASSERT_TLM_DOWNSTREAM_LATENCY_MAX_SIZE(1);
+    ASSERT_TLM_UPLINK_ADMIT_RATE_SIZE(1);
+    ASSERT_TLM_UPLINK_SHED_RATE_SIZE(1);
+    ASSERT_TLM_QUARANTINE_DROPS_SIZE(1);
+
+    // A time which went backwards writes the telemetry right away
+    this->clearHistory();
+    this->setTimeUs(START_US);
+    (void)this->moderate("post 4");
+    ASSERT_TLM_ACCEPT_COUNT_SIZE(1);
+    ASSERT_TLM_ACCEPT_COUNT(0, 4);
+  }
+
+  // ----------------------------------------------------------------------
+  // Batch Tests
+  // ----------------------------------------------------------------------
+
+  void Tester::testBatchStatusMapping(const U8 numValidMessages)
+  {
+    this->initComponents();
+
+    // Every entry holds a SpacePost, so that entries beyond numValidMessages would be noticed if they were checked
+    const char *const kinds[] = {"post", "reject", "fail"};
+    SpacePost_Array messages{};
+    std::vector<std::string> texts{};
+    for (U8 i = 0; i < MAX_MSGBATCH_SIZE; i++)
+    {
+      texts.push_back(std::string(kinds[i % 3]) + " " + std::to_string(i));
+      messages[i] = SpacePost{texts.back().c_str()};
+    }
+    const SpacePost_Batch batch{numValidMessages, messages};
+    MessageStorageStatus_Batch statuses{};
+    const U8 num_stored = this->invoke_to_moderateMessages(0, batch, statuses);
+
+    const U8 num_checked = std::min(numValidMessages, MAX_MSGBATCH_SIZE);
+    std::vector<std::string> expected_accepted{};
+    U8 expected_stored{0};
+    for (U8 i = 0; i < MAX_MSGBATCH_SIZE; i++)
+    {
+      MessageStorageStatus expected_status{MessageStorageStatus::ERROR};
+      if (i < num_checked)
+      {
+        const bool rejected = (i % 3 == 1);
+        if (!rejected)
+        {
+          expected_accepted.push_back(texts[i]);
+        }
+        if (rejected || storesText(texts[i]))
+        {
+          expected_status = MessageStorageStatus::OK;
+          ++expected_stored;
+        }
+      }
+      ASSERT_EQ(statuses[i], expected_status) << "Unexpected status at position " << static_cast<U32>(i);
+    }
+    ASSERT_EQ(num_stored, expected_stored);
+
+    // Accepted SpacePosts are passed on together, in the order of the batch
+    ASSERT_EQ(this->m_strategy.getCheckedTexts(),
+              std::vector<std::string>(texts.begin(), texts.begin() + num_checked));
+    ASSERT_EQ(this->m_acceptedTexts, expected_accepted);
+    ASSERT_EQ(this->m_numAcceptedBatches, expected_accepted.empty() ? 0U : 1U);
+  }
+
+  // ----------------------------------------------------------------------
+  // Blocklist Command Tests
+  // ----------------------------------------------------------------------
+
+  void Tester::testReloadBlocklistCommand()
+  {
+    this->initComponents();
+    U32 num_states{0};
+    const std::vector<U8> valid = compileBlocklist({"antenna"}, num_states);
+    const char *const valid_path = "/tmp/Moderator_ut_cmd_blocklist.bin";
+    ASSERT_TRUE(writeBlocklistFile(valid_path, valid));
+
+    this->sendCmd_RELOAD_BLOCKLIST(INSTANCE, CMD_SEQ, Fw::CmdStringArg(valid_path));
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, Moderator::OPCODE_RELOAD_BLOCKLIST, CMD_SEQ, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_BLOCKLIST_RELOADED_SIZE(1);
+    ASSERT_EVENTS_BLOCKLIST_RELOADED(0, valid_path, num_states);
+    ASSERT_EVENTS_BLOCKLIST_FILE_ERROR_SIZE(0);
+
+    // SpacePosts containing a term are rejected without reaching the strategy
+    const auto checkBlocklistInUse = [this]()
+    {
+      const size_t num_accepted = this->m_acceptedTexts.size();
+      const size_t num_checked = this->m_strategy.getCheckedTexts().size();
+      ASSERT_EQ(this->moderate("Antenna deployed"), MessageStorageStatus::OK);
+      ASSERT_EQ(this->moderate("Solar panels deployed"), MessageStorageStatus::OK);
+      ASSERT_EQ(this->m_acceptedTexts.size(), num_accepted + 1);
+      ASSERT_EQ(this->m_acceptedTexts.back(), "Solar panels deployed");
+      ASSERT_EQ(this->m_strategy.getCheckedTexts().size(), num_checked + 1);
+      ASSERT_EQ(this->m_strategy.getCheckedTexts().back(), "Solar panels deployed");
+    };
+    checkBlocklistInUse();
+
+    // A corrupt file is reported with the offset of its first invalid word
+    std::vector<U8> corrupt{valid};
+    corrupt[0] ^= 0xFF;
+    const char *const corrupt_path = "/tmp/Moderator_ut_cmd_blocklist_corrupt.bin";
+    ASSERT_TRUE(writeBlocklistFile(corrupt_path, corrupt));
+    this->clearHistory();
+    this->sendCmd_RELOAD_BLOCKLIST(INSTANCE, CMD_SEQ, Fw::CmdStringArg(corrupt_path));
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, Moderator::OPCODE_RELOAD_BLOCKLIST, CMD_SEQ, Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_EVENTS_BLOCKLIST_FILE_ERROR_SIZE(1);
+    ASSERT_EVENTS_BLOCKLIST_FILE_ERROR(0, BlocklistFileError::CONTENT, 0);
+    ASSERT_EVENTS_BLOCKLIST_RELOADED_SIZE(0);
+    checkBlocklistInUse();
+
+    // A missing file is reported with the errno of opening it
+    const char *const missing_path = "/tmp/Moderator_ut_cmd_blocklist_missing.bin";
+    (void)std::remove(missing_path);
+    this->clearHistory();
+    this->sendCmd_RELOAD_BLOCKLIST(INSTANCE, CMD_SEQ, Fw::CmdStringArg(missing_path));
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, Moderator::OPCODE_RELOAD_BLOCKLIST, CMD_SEQ, Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_EVENTS_BLOCKLIST_FILE_ERROR_SIZE(1);
+    ASSERT_EVENTS_BLOCKLIST_FILE_ERROR(0, BlocklistFileError::OPEN, ENOENT);
+    ASSERT_EVENTS_BLOCKLIST_RELOADED_SIZE(0);
+    checkBlocklistInUse();
+  }
+
+  // ----------------------------------------------------------------------
+  // Handlers for typed from ports
+  // ----------------------------------------------------------------------
+
+  SpacePosts::MessageStorageStatus Tester ::
+      from_acceptedMessage_handler(
+          const NATIVE_INT_TYPE portNum,
+          const SpacePosts::SpacePost &data)
+  {
+    this->m_acceptedTexts.push_back(data.getmessage_content().toChar());
+    return storesText(this->m_acceptedTexts.back()) ? MessageStorageStatus::OK : MessageStorageStatus::ERROR;
+  }
+
+  U8 Tester ::
+      from_acceptedMessages_handler(
+          const NATIVE_INT_TYPE portNum,
+          const SpacePosts::SpacePost_Batch &data,
+          SpacePosts::MessageStorageStatus_Batch &statuses)
+  {
+    ++this->m_numAcceptedBatches;
+    U8 num_stored{0};
+    for (U8 i = 0; i < MAX_MSGBATCH_SIZE; i++)
+    {
+      statuses[i] = MessageStorageStatus::ERROR;
+      if (i >= data.getnumValidMessages())
+      {
+        continue;
+      }
+      this->m_acceptedTexts.push_back(data.getmessages()[i].getmessage_content().toChar());
+      if (storesText(this->m_acceptedTexts.back()))
+      {
+        statuses[i] = MessageStorageStatus::OK;
+        ++num_stored;
+      }
+    }
+    return num_stored;
+  }
+
+  U8 Tester ::
+      from_quarantineMessages_handler(
+          const NATIVE_INT_TYPE portNum,
+          const SpacePosts::SpacePost_Batch &data,
+          SpacePosts::MessageStorageStatus_Batch &statuses)
+  {
+    ++this->m_numQuarantineBatches;
+    U8 num_stored{0};
+    for (U8 i = 0; i < MAX_MSGBATCH_SIZE; i++)
+    {
+      statuses[i] = MessageStorageStatus::ERROR;
+      if (i >= data.getnumValidMessages() || num_stored >= this->m_quarantineCapacity)
+      {
+        continue;
+      }
+      this->m_quarantinedTexts.push_back(data.getmessages()[i].getmessage_content().toChar());
+      statuses[i] = MessageStorageStatus::OK;
+      ++num_stored;
+    }
+    return num_stored;
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper Methods
+  // ----------------------------------------------------------------------
+
+  SpacePosts::MessageStorageStatus Tester ::
+      moderate(const std::string &text)
+  {
+    return this->invoke_to_moderateMessage(0, SpacePost{text.c_str()});
+  }
+
+  void Tester ::
+      setTimeUs(const U64 timeUs)
+  {
+    this->setTestTime(Fw::Time(TB_NONE, static_cast<U32>(timeUs / 1000000), static_cast<U32>(timeUs % 1000000)));
+  }
+
+  bool Tester ::
+      storesText(const std::string &text)
+  {
+    return text.find("fail") == std::string::npos;
+  }
+
+  U32 Tester ::
+      sumCounts(const SpacePosts::LatencyHistogram_Array &counts)
+  {
+    U32 sum{0};
+    for (U32 i = 0; i < SpacePosts::LatencyHistogram_Array::SIZE; i++)
+    {
+      sum += counts[i];
+    }
+    return sum;
+  }
+
+  void Tester ::
+      initComponents()
+  {
+    this->clearHistory();
+    this->init();
+    this->component.init(
+        INSTANCE);
+
+    // Parameters which are not set by a test take their defaults
+    this->component.loadParameters();
+  }
+
+  // ----------------------------------------------------------------------
+  // F' Tester Implementations
+  // ----------------------------------------------------------------------
+
+  void Tester ::
+      connectPorts()
+  {
+
+    // moderateMessage
+    this->connect_to_moderateMessage(
+        0,
+        this->component.get_moderateMessage_InputPort(0));
+
+    // moderateMessages
+    this->connect_to_moderateMessages(
+        0,
+        this->component.get_moderateMessages_InputPort(0));
+
+    // quarantineSchedIn
+    this->connect_to_quarantineSchedIn(
+        0,
+        this->component.get_quarantineSchedIn_InputPort(0));
+
+    // cmdIn
+    this->connect_to_cmdIn(
+        0,
+        this->component.get_cmdIn_InputPort(0));
+
+    // acceptedMessage
+    this->component.set_acceptedMessage_OutputPort(
+        0,
+        this->get_from_acceptedMessage(0));
+
+    // acceptedMessages
+    this->component.set_acceptedMessages_OutputPort(
+        0,
+        this->get_from_acceptedMessages(0));
+
+    // quarantineMessages
+    this->component.set_quarantineMessages_OutputPort(
+        0,
+        this->get_from_quarantineMessages(0));
+
+    // cmdRegOut
+    this->component.set_cmdRegOut_OutputPort(
+        0,
+        this->get_from_cmdRegOut(0));
+
+    // cmdResponseOut
+    this->component.set_cmdResponseOut_OutputPort(
+        0,
+        this->get_from_cmdResponseOut(0));
+
+    // eventOut
+    this->component.set_eventOut_OutputPort(
+        0,
+        this->get_from_eventOut(0));
+
+    // tlmOut
+    this->component.set_tlmOut_OutputPort(
+        0,
+        this->get_from_tlmOut(0));
+
+    // prmGetOut
+    this->component.set_prmGetOut_OutputPort(
+        0,
+        this->get_from_prmGetOut(0));
+
+    // prmSetOut
+    this->component.set_prmSetOut_OutputPort(
+        0,
+        this->get_from_prmSetOut(0));
+
+    // textEventOut
+    this->component.set_textEventOut_OutputPort(
+        0,
+        this->get_from_textEventOut(0));
+
+    // timeGetOut
+    this->component.set_timeGetOut_OutputPort(
+        0,
+        this->get_from_timeGetOut(0));
+  }
+
+} // end namespace SpacePosts
@@ -0,0 +1,269 @@
+// ======================================================================
+// \title  Moderator/test/ut/Tester.hpp
+// \author Marius Baden
+// \brief  hpp file for Moderator test harness implementation class
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#ifndef TESTER_HPP
+#define TESTER_HPP
+
+#include <string>
+#include <vector>
+
+#include "GTestBase.hpp"
+#include "SpacePosts/Moderator/Moderator.hpp"
+#include "model/KeywordModerationStrategy.hpp"
+
+namespace SpacePosts
+{
+
+  class Tester : public ModeratorGTestBase
+  {
+
+  private:
+    /**
+     * The moderation strategy injected into the component under test. Rejects SpacePosts containing "reject".
+     */
+    KeywordModerationStrategy m_strategy;
+
+    /**
+     * The component under test.
+     */
+    Moderator component;
+
+    /**
+     * The message content of the SpacePosts received from acceptedMessage and acceptedMessages, in the order they
+     * were passed on.
+     *
+     * The downstream storage fails to store SpacePosts containing "fail".
+     */
+    std::vector<std::string> m_acceptedTexts;
+
+    /**
+     * The number of calls of the acceptedMessages port.
+     */
+    U32 m_numAcceptedBatches;
+
+    /**
+     * The message content of the SpacePosts the quarantine store has stored, in the order they were stored.
+     */
+    std::vector<std::string> m_quarantinedTexts;
+
+    /**
+     * The number of calls of the quarantineMessages port.
+     */
+    U32 m_numQuarantineBatches;
+
+    /**
+     * The number of SpacePosts the quarantine store stores per call of quarantineMessages. It fails to store the
+     * following ones.
+     */
+    U8 m_quarantineCapacity;
+
+  public:
+    // ----------------------------------------------------------------------
+    // Construction and destruction
+    // ----------------------------------------------------------------------
+
+    /**
+     * @brief Construct a new Tester object whose quarantine store stores every SpacePost.
+     */
+    Tester();
+
+    /**
+     * @brief Destroy the Tester object.
+     */
+    ~Tester();
+
+  public:
+    // ----------------------------------------------------------------------
+    // Tests
+    // ----------------------------------------------------------------------
+
+    /*
+        UT-MOD-010
+        Test shedding SpacePosts beyond the UPLINK_RATE_LIMIT
+    */
+
+    /**
+     * @brief Sends limit + 3 SpacePosts within one rate window and checks that only the first limit SpacePosts are
+     * checked and passed on.
+     *
+     * Shed SpacePosts are reported as OK to the caller, are neither checked by the strategy nor counted as rejected,
+     * and are not quarantined. The UPLINK_ADMIT_RATE and UPLINK_SHED_RATE telemetry report the counts of the window.
+     * Once the window has slid past the burst, SpacePosts are admitted again.
+     *
+     * @param limit The UPLINK_RATE_LIMIT parameter. 0 admits every SpacePost
+     */
+    void testRateLimitShedsExcess(const U32 limit);
+
+    /*
+        UT-MOD-020
+        Test the treatment of SpacePosts which are not valid UTF-8 according to the UTF8_POLICY
+    */
+
+    /**
+     * @brief Sends a SpacePost with valid and one with invalid UTF-8 and checks how they are passed on.
+     *
+     * Valid UTF-8 passes unchanged with every policy. Invalid UTF-8 passes unchanged with ACCEPT, is rejected before
+     * the strategy and quarantined with REJECT, and reaches the strategy and the downstream component sanitized with
+     * SANITIZE. A sanitized SpacePost which the strategy rejects is quarantined as it was received.
+     *
+     * @param policy The UTF8_POLICY parameter
+     */
+    void testUtf8Policy(const Utf8Policy::T policy);
+
+    /*
+        UT-MOD-030
+        Test collecting rejected SpacePosts for the quarantine and counting the ones which are not quarantined
+    */
+
+    /**
+     * @brief Rejects numRejected SpacePosts, calls quarantineSchedIn, and checks which SpacePosts are passed to the
+     * quarantine store.
+     *
+     * Nothing is passed on before quarantineSchedIn is called. Then, the first SpacePost_Batch_Size rejected
+     * SpacePosts are passed on in one batch and the QUARANTINE_COUNT telemetry reports the stored ones. Rejected
+     * SpacePosts which do not fit into the batch or which the store fails to store are reported by the next
+     * QUARANTINE_DROPS telemetry.
+     *
+     * @param numRejected The number of rejected SpacePosts
+     * @param storeCapacity The number of SpacePosts the quarantine store stores per call
+     */
+    void testQuarantine(const U32 numRejected, const U8 storeCapacity);
+
+    /*
+        UT-MOD-040
+        Test writing the telemetry at most once per MODERATOR_TELEMETRY_INTERVAL_MS
+    */
+
+    /**
+     * @brief Sends SpacePosts at times around the telemetry interval and checks when the telemetry is written.
+     *
+     * The first SpacePost writes the telemetry. SpacePosts within the interval do not. The first SpacePost after the
+     * interval writes the counts and histograms of all SpacePosts since startup. A time which went backwards writes
+     * the telemetry right away.
+     */
+    void testTelemetryInterval();
+
+    /*
+        UT-MOD-050
+        Test mapping the statuses of a moderated batch back to the positions of its SpacePosts
+    */
+
+    /**
+     * @brief Sends a batch whose SpacePosts are in turn accepted, rejected, and accepted but not stored downstream,
+     * and checks the statuses and the returned number of stored SpacePosts.
+     *
+     * The accepted SpacePosts are passed on in one call of acceptedMessages, in the order of the batch. Each
+     * accepted SpacePost gets the status the downstream component reported for it. Rejected SpacePosts are OK and
+     * count as stored. Entries beyond numValidMessages are ERROR and are not checked.
+     *
+     * @param numValidMessages The numValidMessages of the batch. May exceed SpacePost_Batch_Size
+     */
+    void testBatchStatusMapping(const U8 numValidMessages);
+
+    /*
+        UT-MOD-060
+        Test that the rate limit and the UTF-8 check let every SpacePost pass by default
+    */
+
+    /**
+     * @brief Sends more SpacePosts with invalid UTF-8 within one minute than a rate limit would usually admit,
+     * without setting any parameter, and checks that all of them are passed on unchanged.
+     */
+    void testDefaultsPassEverySpacePost();
+
+    /*
+        UT-MOD-140
+        Test loading a compiled blocklist with the RELOAD_BLOCKLIST command
+    */
+
+    /**
+     * @brief Reloads a valid compiled blocklist file, a corrupt one, and a missing one with the RELOAD_BLOCKLIST
+     * command and checks the command responses, the events, and which SpacePosts are rejected afterwards.
+     *
+     * The valid file is reported by BLOCKLIST_RELOADED and its terms are rejected before the strategy checks the
+     * SpacePost. The other files fail the command with BLOCKLIST_FILE_ERROR and the previous blocklist stays in use.
+     */
+    void testReloadBlocklistCommand();
+
+  private:
+    // ----------------------------------------------------------------------
+    // Handlers for typed from ports
+    // ----------------------------------------------------------------------
+
+    //! Handler for from_acceptedMessage
+    //!
+    SpacePosts::MessageStorageStatus from_acceptedMessage_handler(
+        const NATIVE_INT_TYPE portNum, /*!< The port number*/
+        const SpacePosts::SpacePost &data /*!< the SpacePost to store*/
+        ) override;
+
+    //! Handler for from_acceptedMessages
+    //!
+    U8 from_acceptedMessages_handler(
+        const NATIVE_INT_TYPE portNum, /*!< The port number*/
+        const SpacePosts::SpacePost_Batch &data, /*!< the SpacePosts to store*/
+        SpacePosts::MessageStorageStatus_Batch &statuses /*!< whether each SpacePost was stored*/
+        ) override;
+
+    //! Handler for from_quarantineMessages
+    //!
+    U8 from_quarantineMessages_handler(
+        const NATIVE_INT_TYPE portNum, /*!< The port number*/
+        const SpacePosts::SpacePost_Batch &data, /*!< the SpacePosts to store*/
+        SpacePosts::MessageStorageStatus_Batch &statuses /*!< whether each SpacePost was stored*/
+        ) override;
+
+  private:
+    // ----------------------------------------------------------------------
+    // Helper Methods
+    // ----------------------------------------------------------------------
+
+    /**
+     * @brief Sends a SpacePost with the given message content to the moderateMessage port
+     *
+     * @return SpacePosts::MessageStorageStatus The status returned by the port
+     */
+    SpacePosts::MessageStorageStatus moderate(const std::string &text);
+
+    /**
+     * @brief Sets the time the component reads from its timeGetOut port
+     *
+     * @param timeUs The time in microseconds
+     */
+    void setTimeUs(const U64 timeUs);
+
+    /**
+     * @brief Whether the downstream storage model stores a SpacePost with the given message content
+     */
+    static bool storesText(const std::string &text);
+
+    /**
+     * @brief The sum of all buckets of a latency histogram
+     */
+    static U32 sumCounts(const SpacePosts::LatencyHistogram_Array &counts);
+
+    /**
+     * @brief F' generated method for connecting the Tester to the component's ports.
+     */
+    void connectPorts();
+
+    /**
+     * @brief Initialize the Moderator component under test
+     *
+     * All parameters take their defaults until a test sets them and loads them again.
+     */
+    void initComponents();
+  };
+
+} // end namespace SpacePosts
+
+#endif
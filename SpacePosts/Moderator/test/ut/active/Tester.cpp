@@ -0,0 +1,270 @@
+// ======================================================================
+// \title  Moderator/test/ut/active/Tester.cpp
+// \author Marius Baden
+// \brief  cpp file for ActiveModerator test harness implementation class
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "Tester.hpp"
+#include "config/ModeratorCfg.hpp"
+
+#define INSTANCE 0
+#define MAX_HISTORY_SIZE 64
+
+namespace SpacePosts
+{
+
+  namespace
+  {
+    // The number of SpacePosts the queue of the component under test holds
+    constexpr U32 QUEUE_DEPTH = 4;
+
+    // Time at which every test starts, so that the tests can go back in time
+    constexpr U64 START_US = 1000ULL * 1000000;
+
+    constexpr U64 TELEMETRY_INTERVAL_US = static_cast<U64>(MODERATOR_TELEMETRY_INTERVAL_MS) * 1000;
+  }
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  Tester ::
+      Tester() :
+#if FW_OBJECT_NAMES == 1
+                 ActiveModeratorGTestBase("Tester", MAX_HISTORY_SIZE),
+#else
+                 ActiveModeratorGTestBase(MAX_HISTORY_SIZE),
+#endif
+                 m_keywordStrategy("reject"),
+                 m_strategy(),
+                 component("ActiveModerator", m_strategy),
+                 m_acceptedTexts()
+  {
+    (void)this->m_strategy.addStrategy(this->m_keywordStrategy);
+    this->connectPorts();
+  }
+
+  Tester ::
+      ~Tester()
+  {
+  }
+
+  // ----------------------------------------------------------------------
+  // Queue Tests
+  // ----------------------------------------------------------------------
+
+  void Tester::testForwardsAcceptedMessages()
+  {
+    this->initComponents();
+    const std::vector<std::string> texts{"post 0", "reject 1", "post 2", "reject 3"};
+    for (const std::string &text : texts)
+    {
+      ASSERT_EQ(this->moderate(text), MessageStorageStatus::OK);
+    }
+
+    // The SpacePosts are only checked on the component's thread
+    ASSERT_TRUE(this->m_keywordStrategy.getCheckedTexts().empty());
+    ASSERT_TRUE(this->m_acceptedTexts.empty());
+
+    this->dispatch(static_cast<U32>(texts.size()));
+    ASSERT_EQ(this->m_keywordStrategy.getCheckedTexts(), texts);
+    ASSERT_EQ(this->m_acceptedTexts, (std::vector<std::string>{"post 0", "post 2"}));
+    ASSERT_EVENTS_MESSAGE_REJECTED_SIZE(2);
+    ASSERT_EVENTS_MESSAGE_DROPPED_SIZE(0);
+    ASSERT_TLM_QUEUE_DROPS_SIZE(0);
+  }
+
+  void Tester::testQueueFullDrops(const U32 numDropped)
+  {
+    this->initComponents();
+
+    // The queue fills up
+    for (U32 i = 0; i < QUEUE_DEPTH; i++)
+    {
+      ASSERT_EQ(this->moderate("post " + std::to_string(i)), MessageStorageStatus::OK);
+    }
+    ASSERT_TLM_QUEUE_HIGH_WATER_SIZE(QUEUE_DEPTH);
+    for (U32 i = 0; i < QUEUE_DEPTH; i++)
+    {
+      ASSERT_TLM_QUEUE_HIGH_WATER(i, i + 1);
+    }
+    ASSERT_EVENTS_MESSAGE_DROPPED_SIZE(0);
+
+    // Drops are reported as OK as well. The event is throttled, the telemetry counts every drop
+    for (U32 i = 0; i < numDropped; i++)
+    {
+      ASSERT_EQ(this->moderate("dropped " + std::to_string(i)), MessageStorageStatus::OK);
+    }
+    ASSERT_TLM_QUEUE_DROPS_SIZE(numDropped);
+    for (U32 i = 0; i < numDropped; i++)
+    {
+      ASSERT_TLM_QUEUE_DROPS(i, i + 1);
+    }
+    const U32 num_events = std::min(numDropped, static_cast<U32>(ActiveModerator::EVENTID_MESSAGE_DROPPED_THROTTLE));
+    ASSERT_EVENTS_MESSAGE_DROPPED_SIZE(num_events);
+    for (U32 i = 0; i < num_events; i++)
+    {
+      ASSERT_EVENTS_MESSAGE_DROPPED(i, QUEUE_DEPTH);
+    }
+
+    // A SpacePost which fits clears the throttle, so the next drop is reported again
+    this->dispatch(1);
+    this->clearHistory();
+    ASSERT_EQ(this->moderate("post late"), MessageStorageStatus::OK);
+    ASSERT_TLM_QUEUE_HIGH_WATER_SIZE(1);
+    ASSERT_TLM_QUEUE_HIGH_WATER(0, QUEUE_DEPTH);
+    ASSERT_EVENTS_MESSAGE_DROPPED_SIZE(0);
+    ASSERT_EQ(this->moderate("dropped late"), MessageStorageStatus::OK);
+    ASSERT_TLM_QUEUE_DROPS_SIZE(1);
+    ASSERT_TLM_QUEUE_DROPS(0, numDropped + 1);
+    ASSERT_EVENTS_MESSAGE_DROPPED_SIZE(1);
+    ASSERT_EVENTS_MESSAGE_DROPPED(0, QUEUE_DEPTH);
+
+    // Only the queued SpacePosts are checked and passed on
+    this->dispatch(QUEUE_DEPTH);
+    std::vector<std::string> expected_accepted{};
+    for (U32 i = 0; i < QUEUE_DEPTH; i++)
+    {
+      expected_accepted.push_back("post " + std::to_string(i));
+    }
+    expected_accepted.push_back("post late");
+    ASSERT_EQ(this->m_keywordStrategy.getCheckedTexts(), expected_accepted);
+    ASSERT_EQ(this->m_acceptedTexts, expected_accepted);
+  }
+
+  // ----------------------------------------------------------------------
+  // Telemetry Tests
+  // ----------------------------------------------------------------------
+
+  void Tester::testStrategyStatsInterval()
+  {
+    this->initComponents();
+    this->setTimeUs(START_US);
+
+    // The first check writes the statistics
+    (void)this->moderate("post 0");
+    this->dispatch(1);
+    ASSERT_TLM_STRATEGY_STATS_SIZE(1);
+    ASSERT_EQ(this->tlmHistory_STRATEGY_STATS->at(0).arg[0].getchecks(), 1U);
+
+    // Nothing is written within the interval
+    this->clearHistory();
+    this->setTimeUs(START_US + TELEMETRY_INTERVAL_US - 1);
+    (void)this->moderate("post 1");
+    (void)this->moderate("reject 2");
+    this->dispatch(2);
+    ASSERT_TLM_STRATEGY_STATS_SIZE(0);
+
+    // The first check after the interval writes the checks since startup
+    this->setTimeUs(START_US + TELEMETRY_INTERVAL_US);
+    (void)this->moderate("post 3");
+    this->dispatch(1);
+    ASSERT_TLM_STRATEGY_STATS_SIZE(1);
+    ASSERT_EQ(this->tlmHistory_STRATEGY_STATS->at(0).arg[0].getchecks(), 4U);
+
+    // A time which went backwards writes the statistics right away
+    this->clearHistory();
+    this->setTimeUs(START_US);
+    (void)this->moderate("post 4");
+    this->dispatch(1);
+    ASSERT_TLM_STRATEGY_STATS_SIZE(1);
+    ASSERT_EQ(this->tlmHistory_STRATEGY_STATS->at(0).arg[0].getchecks(), 5U);
+  }
+
+  // ----------------------------------------------------------------------
+  // Handlers for typed from ports
+  // ----------------------------------------------------------------------
+
+  SpacePosts::MessageStorageStatus Tester ::
+      from_acceptedMessage_handler(
+          const NATIVE_INT_TYPE portNum,
+          const SpacePosts::SpacePost &data)
+  {
+    this->m_acceptedTexts.push_back(data.getmessage_content().toChar());
+    return MessageStorageStatus::OK;
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper Methods
+  // ----------------------------------------------------------------------
+
+  SpacePosts::MessageStorageStatus Tester ::
+      moderate(const std::string &text)
+  {
+    return this->invoke_to_moderateMessage(0, SpacePost{text.c_str()});
+  }
+
+  void Tester ::
+      dispatch(const U32 numMessages)
+  {
+    for (U32 i = 0; i < numMessages; i++)
+    {
+      ASSERT_EQ(this->component.doDispatch(), Fw::QueuedComponentBase::MSG_DISPATCH_OK);
+    }
+  }
+
+  void Tester ::
+      setTimeUs(const U64 timeUs)
+  {
+    this->setTestTime(Fw::Time(TB_NONE, static_cast<U32>(timeUs / 1000000), static_cast<U32>(timeUs % 1000000)));
+  }
+
+  void Tester ::
+      initComponents()
+  {
+    this->clearHistory();
+    this->init();
+    this->component.init(
+        QUEUE_DEPTH, INSTANCE);
+  }
+
+  // ----------------------------------------------------------------------
+  // F' Tester Implementations
+  // ----------------------------------------------------------------------
+
+  void Tester ::
+      connectPorts()
+  {
+
+    // moderateMessage
+    this->connect_to_moderateMessage(
+        0,
+        this->component.get_moderateMessage_InputPort(0));
+
+    // acceptedMessage
+    this->component.set_acceptedMessage_OutputPort(
+        0,
+        this->get_from_acceptedMessage(0));
+
+    // eventOut
+    this->component.set_eventOut_OutputPort(
+        0,
+        this->get_from_eventOut(0));
+
+    // tlmOut
+    this->component.set_tlmOut_OutputPort(
+        0,
+        this->get_from_tlmOut(0));
+
+    // textEventOut
+    this->component.set_textEventOut_OutputPort(
+        0,
+        this->get_from_textEventOut(0));
+
+    // timeGetOut
+    this->component.set_timeGetOut_OutputPort(
+        0,
+        this->get_from_timeGetOut(0));
+  }
+
+} // end namespace SpacePosts
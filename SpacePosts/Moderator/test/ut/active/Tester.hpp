@@ -0,0 +1,167 @@
+// ======================================================================
+// \title  Moderator/test/ut/active/Tester.hpp
+// \author Marius Baden
+// \brief  hpp file for ActiveModerator test harness implementation class
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#ifndef ACTIVE_MODERATOR_TESTER_HPP
+#define ACTIVE_MODERATOR_TESTER_HPP
+
+#include <string>
+#include <vector>
+
+#include "GTestBase.hpp"
+#include "SpacePosts/Moderator/ActiveModerator.hpp"
+#include "SpacePosts/Moderator/CompositeModerationStrategy.hpp"
+#include "../model/KeywordModerationStrategy.hpp"
+
+namespace SpacePosts
+{
+
+  class Tester : public ActiveModeratorGTestBase
+  {
+
+  private:
+    /**
+     * The only strategy of m_strategy. Rejects SpacePosts containing "reject".
+     */
+    KeywordModerationStrategy m_keywordStrategy;
+
+    /**
+     * The moderation strategy injected into the component under test. A chain, so that it reports statistics.
+     */
+    CompositeModerationStrategy m_strategy;
+
+    /**
+     * The component under test.
+     */
+    ActiveModerator component;
+
+    /**
+     * The message content of the SpacePosts received from acceptedMessage, in the order they were passed on.
+     */
+    std::vector<std::string> m_acceptedTexts;
+
+  public:
+    // ----------------------------------------------------------------------
+    // Construction and destruction
+    // ----------------------------------------------------------------------
+
+    /**
+     * @brief Construct a new Tester object.
+     */
+    Tester();
+
+    /**
+     * @brief Destroy the Tester object.
+     */
+    ~Tester();
+
+  public:
+    // ----------------------------------------------------------------------
+    // Tests
+    // ----------------------------------------------------------------------
+
+    /*
+        UT-ACT-010
+        Test checking queued SpacePosts on the component's thread and passing on the accepted ones
+    */
+
+    /**
+     * @brief Queues SpacePosts which are in turn accepted and rejected, dispatches them, and checks which are
+     * passed on.
+     *
+     * Nothing is checked or passed on before the queued SpacePosts are dispatched. Then, the accepted SpacePosts
+     * are passed on in the order they were queued and each rejected one is reported by MESSAGE_REJECTED.
+     */
+    void testForwardsAcceptedMessages();
+
+    /*
+        UT-ACT-020
+        Test dropping SpacePosts while the queue is full
+    */
+
+    /**
+     * @brief Fills the queue, sends numDropped more SpacePosts, dispatches one, and sends SpacePosts until the queue
+     * is full again.
+     *
+     * While the queue fills, QUEUE_HIGH_WATER reports the number of queued SpacePosts. Every SpacePost which does
+     * not fit is counted by QUEUE_DROPS and reported by MESSAGE_DROPPED until the event is throttled. Once a
+     * SpacePost fits into the queue again, the throttle is cleared, so the next drop is reported again. Dropped
+     * SpacePosts are never checked.
+     *
+     * @param numDropped The number of SpacePosts sent while the queue is full
+     */
+    void testQueueFullDrops(const U32 numDropped);
+
+    /*
+        UT-ACT-030
+        Test writing the STRATEGY_STATS telemetry at most once per MODERATOR_TELEMETRY_INTERVAL_MS
+    */
+
+    /**
+     * @brief Checks SpacePosts at times around the telemetry interval and checks when STRATEGY_STATS is written.
+     *
+     * The first check writes it. Checks within the interval do not. The first check after the interval writes the
+     * number of checks since startup. A time which went backwards writes it right away.
+     */
+    void testStrategyStatsInterval();
+
+  private:
+    // ----------------------------------------------------------------------
+    // Handlers for typed from ports
+    // ----------------------------------------------------------------------
+
+    //! Handler for from_acceptedMessage
+    //!
+    SpacePosts::MessageStorageStatus from_acceptedMessage_handler(
+        const NATIVE_INT_TYPE portNum, /*!< The port number*/
+        const SpacePosts::SpacePost &data /*!< the SpacePost to store*/
+        ) override;
+
+  private:
+    // ----------------------------------------------------------------------
+    // Helper Methods
+    // ----------------------------------------------------------------------
+
+    /**
+     * @brief Sends a SpacePost with the given message content to the moderateMessage port
+     *
+     * @return SpacePosts::MessageStorageStatus The status returned by the port
+     */
+    SpacePosts::MessageStorageStatus moderate(const std::string &text);
+
+    /**
+     * @brief Checks the SpacePosts in the queue on the test's thread, in the order they were queued
+     *
+     * @param numMessages The number of queued SpacePosts to check
+     */
+    void dispatch(const U32 numMessages);
+
+    /**
+     * @brief Sets the time the component reads from its timeGetOut port
+     *
+     * @param timeUs The time in microseconds
+     */
+    void setTimeUs(const U64 timeUs);
+
+    /**
+     * @brief F' generated method for connecting the Tester to the component's ports.
+     */
+    void connectPorts();
+
+    /**
+     * @brief Initialize the ActiveModerator component under test with a queue of QUEUE_DEPTH SpacePosts
+     */
+    void initComponents();
+  };
+
+} // end namespace SpacePosts
+
+#endif
@@ -0,0 +1,49 @@
+#include "Tester.hpp"
+#include "gtest/gtest.h"
+
+using namespace SpacePosts;
+
+/*
+    UT-ACT-010
+    Test checking queued SpacePosts on the component's thread and passing on the accepted ones
+*/
+
+TEST(ActiveModeratorTest, TestQueueNominalForwardsAcceptedMessages)
+{
+    Tester tester{};
+    tester.testForwardsAcceptedMessages();
+}
+
+/*
+    UT-ACT-020
+    Test dropping SpacePosts while the queue is full
+*/
+
+TEST(ActiveModeratorTest, TestQueueErrorOneDropped)
+{
+    Tester tester{};
+    tester.testQueueFullDrops(1);
+}
+TEST(ActiveModeratorTest, TestQueueErrorDropsBeyondThrottle)
+{
+    Tester tester{};
+    tester.testQueueFullDrops(ActiveModerator::EVENTID_MESSAGE_DROPPED_THROTTLE + 2);
+}
+
+/*
+    UT-ACT-030
+    Test writing the STRATEGY_STATS telemetry at most once per MODERATOR_TELEMETRY_INTERVAL_MS
+*/
+
+TEST(ActiveModeratorTest, TestTelemetryNominalStrategyStatsInterval)
+{
+    Tester tester{};
+    tester.testStrategyStatsInterval();
+}
+
+// Execute tests
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,251 @@
+#include "Tester.hpp"
+#include "StrategyTester.hpp"
+#include "gtest/gtest.h"
+
+#include "SpacePosts/MessageTypes/FppConstantsAc.hpp"
+
+using namespace SpacePosts;
+
+constexpr const U8 MAX_MSGBATCH_SIZE = SpacePosts::FppConstant_SpacePost_Batch_Size::SpacePost_Batch_Size;
+
+/*
+    UT-MOD-010
+    Test shedding SpacePosts beyond the UPLINK_RATE_LIMIT
+*/
+
+TEST(ModeratorTest, TestRateLimitNominalOff)
+{
+    Tester tester{};
+    tester.testRateLimitShedsExcess(0);
+}
+TEST(ModeratorTest, TestRateLimitNominalOnePerWindow)
+{
+    Tester tester{};
+    tester.testRateLimitShedsExcess(1);
+}
+TEST(ModeratorTest, TestRateLimitNominalSeveralPerWindow)
+{
+    Tester tester{};
+    tester.testRateLimitShedsExcess(5);
+}
+
+/*
+    UT-MOD-020
+    Test the treatment of SpacePosts which are not valid UTF-8 according to the UTF8_POLICY
+*/
+
+TEST(ModeratorTest, TestUtf8PolicyNominalAccept)
+{
+    Tester tester{};
+    tester.testUtf8Policy(Utf8Policy::ACCEPT);
+}
+TEST(ModeratorTest, TestUtf8PolicyNominalReject)
+{
+    Tester tester{};
+    tester.testUtf8Policy(Utf8Policy::REJECT);
+}
+TEST(ModeratorTest, TestUtf8PolicyNominalSanitize)
+{
+    Tester tester{};
+    tester.testUtf8Policy(Utf8Policy::SANITIZE);
+}
+
+/*
+    UT-MOD-030
+    Test collecting rejected SpacePosts for the quarantine and counting the ones which are not quarantined
+*/
+
+TEST(ModeratorTest, TestQuarantineNominalNothingRejected)
+{
+    Tester tester{};
+    tester.testQuarantine(0, MAX_MSGBATCH_SIZE);
+}
+TEST(ModeratorTest, TestQuarantineNominalSomeRejected)
+{
+    Tester tester{};
+    tester.testQuarantine(3, MAX_MSGBATCH_SIZE);
+}
+TEST(ModeratorTest, TestQuarantineNominalFullBatch)
+{
+    Tester tester{};
+    tester.testQuarantine(MAX_MSGBATCH_SIZE, MAX_MSGBATCH_SIZE);
+}
+TEST(ModeratorTest, TestQuarantineErrorBatchOverflows)
+{
+    Tester tester{};
+    tester.testQuarantine(MAX_MSGBATCH_SIZE + 2, MAX_MSGBATCH_SIZE);
+}
+TEST(ModeratorTest, TestQuarantineErrorStoreFails)
+{
+    Tester tester{};
+    tester.testQuarantine(5, 2);
+}
+
+/*
+    UT-MOD-040
+    Test writing the telemetry at most once per MODERATOR_TELEMETRY_INTERVAL_MS
+*/
+
+TEST(ModeratorTest, TestTelemetryIntervalNominal)
+{
+    Tester tester{};
+    tester.testTelemetryInterval();
+}
+
+/*
+    UT-MOD-050
+    Test mapping the statuses of a moderated batch back to the positions of its SpacePosts
+*/
+
+TEST(ModeratorTest, TestBatchStatusesNominalEmpty)
+{
+    Tester tester{};
+    tester.testBatchStatusMapping(0);
+}
+TEST(ModeratorTest, TestBatchStatusesNominalOnlyAccepted)
+{
+    Tester tester{};
+    tester.testBatchStatusMapping(1);
+}
+TEST(ModeratorTest, TestBatchStatusesNominalMixed)
+{
+    Tester tester{};
+    tester.testBatchStatusMapping(7);
+}
+TEST(ModeratorTest, TestBatchStatusesNominalFullBatch)
+{
+    Tester tester{};
+    tester.testBatchStatusMapping(MAX_MSGBATCH_SIZE);
+}
+TEST(ModeratorTest, TestBatchStatusesErrorTooManyValidMessages)
+{
+    Tester tester{};
+    tester.testBatchStatusMapping(MAX_MSGBATCH_SIZE + 1);
+}
+
+/*
+    UT-MOD-060
+    Test that the rate limit and the UTF-8 check let every SpacePost pass by default
+*/
+
+TEST(ModeratorTest, TestDefaultsNominalPassEverySpacePost)
+{
+    Tester tester{};
+    tester.testDefaultsPassEverySpacePost();
+}
+
+/*
+    UT-MOD-070
+    Test detecting blocklisted terms with the Aho-Corasick automaton
+*/
+
+TEST(ModerationStrategyTest, TestAhoCorasickNominalDetectsTerms)
+{
+    StrategyTester tester{};
+    tester.testAhoCorasickDetectsTerms();
+}
+
+/*
+    UT-MOD-080
+    Test counting byte classes with the vectorized screening
+*/
+
+TEST(ModerationStrategyTest, TestByteClassNominalCountsMatchScalar)
+{
+    StrategyTester tester{};
+    tester.testByteClassCountsMatchScalar();
+}
+
+/*
+    UT-MOD-090
+    Test counting copies of a SpacePost within the time window of the repetition strategy
+*/
+
+TEST(ModerationStrategyTest, TestRepetitionNominalNearIdenticalCopies)
+{
+    StrategyTester tester{};
+    tester.testRepetitionCountsNearIdenticalCopies();
+}
+
+/*
+    UT-MOD-100
+    Test detecting obfuscated terms with the fuzzy strategy
+*/
+
+TEST(ModerationStrategyTest, TestFuzzyNominalDetectsObfuscatedTerms)
+{
+    StrategyTester tester{};
+    tester.testFuzzyDetectsObfuscatedTerms();
+}
+TEST(ModerationStrategyTest, TestFuzzyNominalMatchesDynamicProgramming)
+{
+    StrategyTester tester{};
+    tester.testFuzzyMatchesDynamicProgramming();
+}
+
+/*
+    UT-MOD-110
+    Test validating and sanitizing UTF-8
+*/
+
+TEST(ModerationStrategyTest, TestUtf8ValidationNominalMatchesScalar)
+{
+    StrategyTester tester{};
+    tester.testUtf8ValidationMatchesScalar();
+}
+
+/*
+    UT-MOD-120
+    Test that reordering a CompositeModerationStrategy does not move pinned strategies
+*/
+
+TEST(ModerationStrategyTest, TestCompositeNominalPinnedStrategyKeepsPosition)
+{
+    StrategyTester tester{};
+    tester.testCompositeKeepsPinnedStrategy(true);
+}
+TEST(ModerationStrategyTest, TestCompositeNominalUnpinnedStrategyMoves)
+{
+    StrategyTester tester{};
+    tester.testCompositeKeepsPinnedStrategy(false);
+}
+
+/*
+    UT-MOD-130
+    Test rejecting invalid compiled blocklist files and keeping the previous blocklist
+*/
+
+TEST(ModerationStrategyTest, TestBlocklistReloadErrorInvalidFiles)
+{
+    StrategyTester tester{};
+    tester.testBlocklistReloadRejectsInvalidFiles();
+}
+
+/*
+    UT-MOD-140
+    Test loading a compiled blocklist with the RELOAD_BLOCKLIST command
+*/
+
+TEST(ModeratorTest, TestReloadBlocklistNominalCommand)
+{
+    Tester tester{};
+    tester.testReloadBlocklistCommand();
+}
+
+/*
+    UT-MOD-150
+    Test checking texts against a blocklist while it is reloaded
+*/
+
+TEST(ModerationStrategyTest, TestBlocklistReloadNominalChecksDuringReloads)
+{
+    StrategyTester tester{};
+    tester.testBlocklistChecksDuringReloads();
+}
+
+// Execute tests
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,30 @@
+#include <cstdio>
+
+#include "BlocklistFile.hpp"
+#include "SpacePosts/Moderator/AhoCorasickModerationStrategy.hpp"
+
+std::vector<U8> SpacePosts::compileBlocklist(const std::vector<std::string> &terms, U32 &numStates)
+{
+    AhoCorasickModerationStrategy strategy{true};
+    for (const std::string &term : terms)
+    {
+        (void)strategy.addPattern(term.c_str(), static_cast<U32>(term.length()));
+    }
+    strategy.build();
+
+    std::vector<U8> contents(strategy.getSerializedSize());
+    contents.resize(strategy.serialize(contents.data(), static_cast<U32>(contents.size())));
+    numStates = strategy.getNumStates();
+    return contents;
+}
+
+bool SpacePosts::writeBlocklistFile(const char *const path, const std::vector<U8> &contents)
+{
+    std::FILE *const stream = std::fopen(path, "wb");
+    if (stream == nullptr)
+    {
+        return false;
+    }
+    const bool written = std::fwrite(contents.data(), 1, contents.size(), stream) == contents.size();
+    return (std::fclose(stream) == 0) && written;
+}
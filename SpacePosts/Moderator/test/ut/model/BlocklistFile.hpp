@@ -0,0 +1,32 @@
+#ifndef REF_MODERATOR_TEST_UT_BLOCKLISTFILE_HPP
+#define REF_MODERATOR_TEST_UT_BLOCKLISTFILE_HPP
+
+#include <string>
+#include <vector>
+
+#include <Fw/Types/BasicTypes.hpp>
+
+namespace SpacePosts
+{
+    /**
+     * @brief Compiles terms into the contents of a compiled blocklist file, as the ground does
+     *
+     * Used by the unit tests to write valid and corrupted files for RELOAD_BLOCKLIST.
+     *
+     * @param terms The terms of the blocklist. Matched regardless of the case of ASCII letters
+     * @param numStates Set to the number of states of the compiled automaton
+     * @return std::vector<U8> The contents of the file
+     */
+    std::vector<U8> compileBlocklist(const std::vector<std::string> &terms, U32 &numStates);
+
+    /**
+     * @brief Writes the given contents to a file, replacing any file at path
+     *
+     * @param path The path of the file
+     * @param contents The bytes to write
+     * @return true iff the whole file has been written
+     */
+    bool writeBlocklistFile(const char *const path, const std::vector<U8> &contents);
+}
+
+#endif
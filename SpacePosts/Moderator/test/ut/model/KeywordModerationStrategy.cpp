@@ -0,0 +1,19 @@
+#include "KeywordModerationStrategy.hpp"
+
+SpacePosts::KeywordModerationStrategy::KeywordModerationStrategy(const std::string &keyword)
+    : m_keyword(keyword),
+      m_checkedTexts()
+{
+}
+
+bool SpacePosts::KeywordModerationStrategy::checkMessage(const SpacePosts::SpacePost &message)
+{
+    const std::string text{message.getmessage_content().toChar()};
+    m_checkedTexts.push_back(text);
+    return text.find(m_keyword) == std::string::npos;
+}
+
+const std::vector<std::string> &SpacePosts::KeywordModerationStrategy::getCheckedTexts() const
+{
+    return m_checkedTexts;
+}
@@ -0,0 +1,44 @@
+#ifndef REF_MODERATOR_TEST_UT_KEYWORDMODERATIONSTRATEGY_HPP
+#define REF_MODERATOR_TEST_UT_KEYWORDMODERATIONSTRATEGY_HPP
+
+#include <string>
+#include <vector>
+
+#include "SpacePosts/MessageTypes/SpacePostSerializableAc.hpp"
+#include "SpacePosts/Moderator/ModerationStrategy.hpp"
+
+namespace SpacePosts
+{
+    /**
+     * @brief Moderation strategy which rejects every SpacePost whose message content contains a keyword
+     *
+     * Records the message content of every SpacePost it checks, so that tests can tell which SpacePosts reached the
+     * strategy and in which form, e.g., after sanitizing or without the ones shed by the rate limit.
+     */
+    class KeywordModerationStrategy : public ModerationStrategy
+    {
+    private:
+        std::string m_keyword;
+        std::vector<std::string> m_checkedTexts;
+
+    public:
+        /**
+         * @brief Construct a new KeywordModerationStrategy object
+         *
+         * @param keyword The SpacePosts whose message content contains it are rejected
+         */
+        explicit KeywordModerationStrategy(const std::string &keyword);
+
+        /**
+         * @brief Records the message content and rejects the SpacePost iff it contains the keyword
+         */
+        bool checkMessage(const SpacePosts::SpacePost &message) override;
+
+        /**
+         * @brief The message content of every checked SpacePost, in the order they were checked
+         */
+        const std::vector<std::string> &getCheckedTexts() const;
+    };
+}
+
+#endif
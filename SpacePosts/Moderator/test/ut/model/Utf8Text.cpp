@@ -0,0 +1,23 @@
+#include <random>
+#include <vector>
+
+#include "Utf8Text.hpp"
+
+std::string SpacePosts::generateUtf8Text(const U32 length, const U32 seed)
+{
+    const std::vector<std::string> characters{"a", "Z", " ", "7", "\xC3\xBC", "\xCE\xB1", "\xE2\x82\xAC",
+                                              "\xE3\x81\x82", "\xF0\x9F\x9B\xB0"};
+    std::mt19937 random{seed};
+    std::uniform_int_distribution<size_t> pick{0, characters.size() - 1};
+    std::string text{};
+    while (true)
+    {
+        const std::string &next = characters[pick(random)];
+        if (text.length() + next.length() > length)
+        {
+            break;
+        }
+        text += next;
+    }
+    return text;
+}
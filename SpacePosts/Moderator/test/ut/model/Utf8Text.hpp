@@ -0,0 +1,22 @@
+#ifndef REF_MODERATOR_TEST_UT_UTF8TEXT_HPP
+#define REF_MODERATOR_TEST_UT_UTF8TEXT_HPP
+
+#include <string>
+
+#include <Fw/Types/BasicTypes.hpp>
+
+namespace SpacePosts
+{
+    /**
+     * @brief Generates a reproducible text mixing ASCII with 2, 3, and 4 byte UTF-8 sequences
+     *
+     * Used by the unit tests to check the UTF-8 validation and by the benchmark to time it.
+     *
+     * @param length The maximum number of bytes of the text. Shorter by the bytes of a sequence which does not fit
+     * @param seed The seed of the random choice of characters
+     * @return std::string The valid UTF-8 text
+     */
+    std::string generateUtf8Text(const U32 length, const U32 seed);
+}
+
+#endif
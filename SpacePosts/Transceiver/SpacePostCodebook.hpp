@@ -0,0 +1,67 @@
+// ======================================================================
+// \title  SpacePostCodebook.hpp
+// \author Marius Baden
+// \brief  Static Huffman codebook for compressing downlinked SpacePosts
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#ifndef SPACEPOSTCODEBOOK_HPP
+#define SPACEPOSTCODEBOOK_HPP
+
+#include "Fw/Types/BasicTypes.hpp"
+
+namespace SpacePosts
+{
+  // Anonymous namespace for the codebook. Must be identical on the satellite and in the ground decoder.
+  namespace
+  {
+    enum
+    {
+      // Version of the codebook below. Increment whenever SPACEPOST_CODEBOOK_CODE_LENGTHS changes so that the
+      // ground decoder can be updated accordingly.
+      SPACEPOST_CODEBOOK_VERSION = 1,
+
+      // Longest code in SPACEPOST_CODEBOOK_CODE_LENGTHS in bits
+      SPACEPOST_CODEBOOK_MAX_CODE_LENGTH = 15,
+
+      // Number of symbols in the codebook: one per byte value
+      SPACEPOST_CODEBOOK_NUM_SYMBOLS = 256,
+    };
+
+    // Code length in bits of every byte value in a canonical Huffman code.
+    //
+    // Only the code lengths are stored. The codes themselves follow from the lengths by the canonical Huffman
+    // construction (see SpacePostCodec), which the ground decoder performs in the same way.
+    //
+    // Derived from the byte frequencies of a sample of representative amateur radio traffic (call signs, grid
+    // locators, Q-codes, signal reports, and short English chatter) with a length limit of
+    // SPACEPOST_CODEBOOK_MAX_CODE_LENGTH bits. Every byte value has a code so that any SpacePost can be encoded.
+    // Printable ASCII takes 3 to 9 bits for common characters; bytes outside of it take up to 15 bits.
+    const U8 SPACEPOST_CODEBOOK_CODE_LENGTHS[SPACEPOST_CODEBOOK_NUM_SYMBOLS] = {
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, // 0x00
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, // 0x10
+     3,  8, 15, 15, 15, 15, 15,  8, 15,  9, 15, 15,  7, 15,  9, 15, // 0x20
+     8,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7, 15, 15, 15, 15,  9, // 0x30
+    15,  6,  7,  8,  7,  6,  7,  7,  7,  8,  8,  6,  7,  7,  6,  7, // 0x40
+     7,  6,  6,  7,  7,  8,  8,  8,  8,  8,  8, 15, 15, 15, 15, 14, // 0x50
+    14,  5,  8,  6,  6,  4,  6,  6,  5,  5,  7,  7,  5,  6,  5,  5, // 0x60
+     8,  8,  5,  5,  4,  6,  7,  6,  7,  6,  7, 14, 14, 14, 14, 15, // 0x70
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, // 0x80
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, // 0x90
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, // 0xA0
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, // 0xB0
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, // 0xC0
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, // 0xD0
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, // 0xE0
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, // 0xF0
+    };
+  }
+
+} // end namespace SpacePosts
+
+#endif
@@ -0,0 +1,146 @@
+// ======================================================================
+// \title  SpacePostCodec.cpp
+// \author Marius Baden
+// \brief  cpp file for the text codec of downlinked SpacePosts
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#include <SpacePosts/Transceiver/SpacePostCodec.hpp>
+#include "Fw/Types/Assert.hpp"
+
+namespace SpacePosts
+{
+
+  // ----------------------------------------------------------------------
+  // Construction
+  // ----------------------------------------------------------------------
+
+  SpacePostCodec ::
+      SpacePostCodec() : m_codes(), m_lengths(), m_lengthCounts(), m_sortedSymbols()
+  {
+    for (U32 symbol = 0; symbol < SPACEPOST_CODEBOOK_NUM_SYMBOLS; symbol++)
+    {
+      const U8 length = SPACEPOST_CODEBOOK_CODE_LENGTHS[symbol];
+      FW_ASSERT(length >= 1 && length <= SPACEPOST_CODEBOOK_MAX_CODE_LENGTH, symbol, length);
+      this->m_lengths[symbol] = length;
+      this->m_lengthCounts[length]++;
+    }
+
+    // Canonical Huffman construction: the first code of each length follows the last code of the previous length
+    U32 next_code[SPACEPOST_CODEBOOK_MAX_CODE_LENGTH + 1] = {};
+    U32 next_sorted[SPACEPOST_CODEBOOK_MAX_CODE_LENGTH + 1] = {};
+    U32 code{0};
+    U32 sorted{0};
+    for (U32 length = 1; length <= SPACEPOST_CODEBOOK_MAX_CODE_LENGTH; length++)
+    {
+      next_code[length] = code;
+      next_sorted[length] = sorted;
+      code = (code + this->m_lengthCounts[length]) << 1;
+      sorted += this->m_lengthCounts[length];
+
+      // Codebook must be a prefix code (Kraft inequality)
+      FW_ASSERT(next_code[length] + this->m_lengthCounts[length] <= (1U << length), length);
+    }
+
+    for (U32 symbol = 0; symbol < SPACEPOST_CODEBOOK_NUM_SYMBOLS; symbol++)
+    {
+      const U8 length = this->m_lengths[symbol];
+      this->m_codes[symbol] = static_cast<U16>(next_code[length]++);
+      this->m_sortedSymbols[next_sorted[length]++] = static_cast<U8>(symbol);
+    }
+  }
+
+  // ----------------------------------------------------------------------
+  // Encoding and decoding
+  // ----------------------------------------------------------------------
+
+  bool SpacePostCodec::encode(const U8 *const text, const U32 length, U8 *const out, const U32 capacity,
+                              U32 &encodedSize) const
+  {
+    // Holds at most 7 pending bits + one code of at most 15 bits
+    U32 pending_bits{0};
+    U32 num_pending_bits{0};
+    U32 written{0};
+
+    for (U32 i = 0; i < length; i++)
+    {
+      const U8 symbol = text[i];
+      pending_bits = (pending_bits << this->m_lengths[symbol]) | this->m_codes[symbol];
+      num_pending_bits += this->m_lengths[symbol];
+
+      while (num_pending_bits >= 8)
+      {
+        if (written >= capacity)
+        {
+          return false;
+        }
+        num_pending_bits -= 8;
+        out[written++] = static_cast<U8>(pending_bits >> num_pending_bits);
+      }
+      pending_bits &= (1U << num_pending_bits) - 1;
+    }
+
+    // Pad last byte with zero bits
+    if (num_pending_bits > 0)
+    {
+      if (written >= capacity)
+      {
+        return false;
+      }
+      out[written++] = static_cast<U8>(pending_bits << (8 - num_pending_bits));
+    }
+
+    encodedSize = written;
+    return true;
+  }
+
+  bool SpacePostCodec::decode(const U8 *const in, const U32 inSize, const U32 textLength, U8 *const text,
+                              U32 &consumed) const
+  {
+    const U32 num_bits = inSize * 8;
+    U32 bit_position{0};
+
+    for (U32 i = 0; i < textLength; i++)
+    {
+      // Canonical decoding: codes of the same length are consecutive, starting at first
+      U32 code{0};
+      U32 first{0};
+      U32 index{0};
+      bool found{false};
+      for (U32 length = 1; length <= SPACEPOST_CODEBOOK_MAX_CODE_LENGTH; length++)
+      {
+        if (bit_position >= num_bits)
+        {
+          return false;
+        }
+        code |= (in[bit_position >> 3] >> (7 - (bit_position & 7))) & 1U;
+        bit_position++;
+
+        const U32 count = this->m_lengthCounts[length];
+        if (code - first < count)
+        {
+          text[i] = this->m_sortedSymbols[index + code - first];
+          found = true;
+          break;
+        }
+        index += count;
+        first = (first + count) << 1;
+        code <<= 1;
+      }
+
+      if (!found)
+      {
+        return false;
+      }
+    }
+
+    consumed = (bit_position + 7) / 8;
+    return true;
+  }
+
+} // end namespace SpacePosts
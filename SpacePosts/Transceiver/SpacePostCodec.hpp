@@ -0,0 +1,81 @@
+// ======================================================================
+// \title  SpacePostCodec.hpp
+// \author Marius Baden
+// \brief  hpp file for the text codec of downlinked SpacePosts
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#ifndef SPACEPOSTCODEC_HPP
+#define SPACEPOSTCODEC_HPP
+
+#include "Fw/Types/BasicTypes.hpp"
+#include "SpacePosts/Transceiver/SpacePostCodebook.hpp"
+
+namespace SpacePosts
+{
+    //! Compresses the text of SpacePosts with the static canonical Huffman code of SpacePostCodebook.hpp
+    //!
+    //! Codes are written most significant bit first. The last byte of an encoded text is padded with zero bits.
+    //! The encoded text does not store its own length: the decoder needs the number of characters to decode.
+    //!
+    //! Builds its code tables once upon construction. Afterwards, encoding and decoding do not allocate memory and
+    //! do not modify the codec. Thus, a codec can be shared by multiple threads.
+    class SpacePostCodec
+    {
+    public:
+        //! Construct object SpacePostCodec from the codebook in SpacePostCodebook.hpp
+        //!
+        SpacePostCodec();
+
+        //! Encodes the given text into the given output buffer.
+        //!
+        //! Returns true iff the encoded text fit into capacity bytes. In this case, encodedSize is set to the number
+        //! of bytes written. Otherwise, the content of the output buffer is undefined.
+        //!
+        //! Stops early as soon as capacity is exceeded. Thus, callers can pass the size they need to beat as
+        //! capacity to only compress if it saves space.
+        bool encode(
+            const U8 *const text, /*!< The text to encode */
+            const U32 length,     /*!< The number of characters of text */
+            U8 *const out,        /*!< The buffer to write the encoded text to */
+            const U32 capacity,   /*!< The size of out in bytes */
+            U32 &encodedSize      /*!< The number of bytes written to out */
+        ) const;
+
+        //! Decodes the given number of characters from the given encoded text.
+        //!
+        //! Returns true iff textLength characters were decoded from at most inSize bytes. In this case, consumed is
+        //! set to the number of bytes of the encoded text (incl. the padded last byte). Returns false for an
+        //! encoded text which is truncated or contains a bit sequence which is not a code.
+        //!
+        //! Used by the ground decoder and in tests. Not called on the satellite.
+        bool decode(
+            const U8 *const in,     /*!< The encoded text */
+            const U32 inSize,       /*!< The number of bytes available in in */
+            const U32 textLength,   /*!< The number of characters to decode */
+            U8 *const text,         /*!< The buffer of at least textLength bytes to write the decoded text to */
+            U32 &consumed           /*!< The number of bytes of in used by the encoded text */
+        ) const;
+
+    private:
+        //! The canonical code of every byte value. Only the lowest m_lengths[symbol] bits are used
+        U16 m_codes[SPACEPOST_CODEBOOK_NUM_SYMBOLS];
+
+        //! The code length in bits of every byte value
+        U8 m_lengths[SPACEPOST_CODEBOOK_NUM_SYMBOLS];
+
+        //! The number of codes of each code length. Index 0 is unused
+        U16 m_lengthCounts[SPACEPOST_CODEBOOK_MAX_CODE_LENGTH + 1];
+
+        //! The byte values ordered by code length and then by value, i.e., in the order of their canonical codes
+        U8 m_sortedSymbols[SPACEPOST_CODEBOOK_NUM_SYMBOLS];
+    };
+
+} // end namespace SpacePosts
+
+#endif
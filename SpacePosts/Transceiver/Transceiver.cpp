@@ -10,6 +10,11 @@
 //
 // ======================================================================
 
+#include <cstring>
+#include <limits>
+
+#include <Os/File.hpp>
+
 #include <SpacePosts/Transceiver/Transceiver.hpp>
 #include <config/TransceiverCfg.hpp>
 #include "Fw/Types/BasicTypes.hpp"
@@ -17,6 +22,12 @@
 
 namespace SpacePosts
 {
+  namespace
+  {
+    // Cursor file layout: delimiter | per DownlinkSource: U8 valid + U32 index
+    constexpr NATIVE_INT_TYPE CURSOR_FILE_SIZE =
+        sizeof(U8) + DownlinkSource::NUM_CONSTANTS * (sizeof(U8) + sizeof(U32));
+  }
 
   // ----------------------------------------------------------------------
   // Construction, initialization, and destruction
@@ -33,6 +44,7 @@ namespace SpacePosts
           const NATIVE_INT_TYPE instance)
   {
     TransceiverComponentBase::init(instance);
+    this->restoreDownlinkCursors();
   }
 
   Transceiver ::
@@ -49,7 +61,50 @@ namespace SpacePosts
           const NATIVE_INT_TYPE portNum,
           NATIVE_UINT_TYPE context)
   {
-    this->sendMessages();
+    this->sendMessages(DownlinkSource::SCHEDULE);
+  }
+
+  void Transceiver ::
+      pacingTick_handler(
+          const NATIVE_INT_TYPE portNum,
+          NATIVE_UINT_TYPE context)
+  {
+    Fw::ParamValid valid;
+    const U32 bytes_per_tick = paramGet_DOWNLINK_PACING_BYTES_PER_TICK(valid);
+    FW_ASSERT(valid.e == Fw::ParamValid::VALID || valid.e == Fw::ParamValid::DEFAULT, valid.e);
+    const U32 frames_per_tick = paramGet_DOWNLINK_PACING_FRAMES_PER_TICK(valid);
+    FW_ASSERT(valid.e == Fw::ParamValid::VALID || valid.e == Fw::ParamValid::DEFAULT, valid.e);
+
+    // Refill the token bucket. It holds at most one tick's budget, so an idle downlink does not save up a burst.
+    // A frame larger than the remaining tokens is still sent and its excess is paid off on the following ticks
+    if (bytes_per_tick > 0)
+    {
+      const I64 refilled = this->m_pacingTokens + bytes_per_tick;
+      this->m_pacingTokens = (refilled > bytes_per_tick) ? bytes_per_tick : refilled;
+    }
+
+    if (!this->m_session.active)
+    {
+      return;
+    }
+
+    U32 frames_sent{0};
+    while (this->m_session.active &&
+           (bytes_per_tick == 0 || this->m_pacingTokens > 0) &&
+           (frames_per_tick == 0 || frames_sent < frames_per_tick))
+    {
+      const U32 frame_size = this->sendNextFrame();
+      frames_sent++;
+      if (bytes_per_tick > 0)
+      {
+        this->m_pacingTokens -= frame_size;
+      }
+    }
+
+    if (this->m_session.active)
+    {
+      this->tlmWrite_DOWNLINK_QUEUE_DEPTH(this->numPendingMessages());
+    }
   }
 
   // ----------------------------------------------------------------------
@@ -69,14 +124,38 @@ namespace SpacePosts
     this->cmdResponse_out(opCode, cmdSeq, response);
   }
 
+  void Transceiver ::
+      STORE_MESSAGES_cmdHandler(
+          const FwOpcodeType opCode,
+          const U32 cmdSeq,
+          SpacePosts::SpacePost_Batch msgs)
+  {
+    // The batch was deserialized from the command without checking that it is consistent
+    const U8 num_messages = msgs.getnumValidMessages();
+    if (num_messages > SpacePost_Batch_Size)
+    {
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::VALIDATION_ERROR);
+      return;
+    }
+
+    SpacePosts::MessageStorageStatus_Batch statuses{};
+    const U8 num_stored = this->storeMessages_out(0, msgs, statuses);
+
+    if (num_stored < num_messages)
+    {
+      this->log_WARNING_LO_STORE_MESSAGES_INCOMPLETE(num_stored, num_messages);
+    }
+    const Fw::CmdResponse response = (num_stored == num_messages) ? Fw::CmdResponse::OK
+                                                                  : Fw::CmdResponse::EXECUTION_ERROR;
+    this->cmdResponse_out(opCode, cmdSeq, response);
+  }
+
   void Transceiver ::
       DOWNLINK_LAST_MESSAGES_GDS_cmdHandler(
           const FwOpcodeType opCode,
           const U32 cmdSeq)
   {
-    const bool success = this->sendMessages();
-    const Fw::CmdResponse response = success ? Fw::CmdResponse::OK : Fw::CmdResponse::EXECUTION_ERROR;
-    this->cmdResponse_out(opCode, cmdSeq, response);
+    this->downlinkCmd(opCode, cmdSeq, DownlinkSource::GDS);
   }
 
   void Transceiver::DOWNLINK_LAST_MESSAGES_HAMUSER_cmdHandler(
@@ -107,7 +186,18 @@ namespace SpacePosts
     }
 
     // After enabled check, handle just as GDS request
-    this->DOWNLINK_LAST_MESSAGES_GDS_cmdHandler(opCode, cmdSeq);
+    this->downlinkCmd(opCode, cmdSeq, DownlinkSource::HAM);
+  }
+
+  void Transceiver ::
+      DOWNLINK_QUARANTINE_cmdHandler(
+          const FwOpcodeType opCode,
+          const U32 cmdSeq,
+          U32 count)
+  {
+    const bool success = this->sendQuarantine(count);
+    const Fw::CmdResponse response = success ? Fw::CmdResponse::OK : Fw::CmdResponse::EXECUTION_ERROR;
+    this->cmdResponse_out(opCode, cmdSeq, response);
   }
 
   // ----------------------------------------------------------------------
@@ -115,29 +205,301 @@ namespace SpacePosts
   // ----------------------------------------------------------------------
 
   bool Transceiver::
-      sendMessages()
+      sendMessages(const DownlinkSource source)
   {
-    SpacePost_Batch messages{};
-    this->loadMessages_out(0, TRANSCEIVER_NUM_MESSAGES_TO_DOWNLINK, messages);
-    const SpacePost_Array &message_array = messages.getmessages();
+    Fw::ParamValid valid;
+    const bool pacing = paramGet_DOWNLINK_PACING_ENABLED(valid);
+    FW_ASSERT(valid.e == Fw::ParamValid::VALID || valid.e == Fw::ParamValid::DEFAULT, valid.e);
 
-    if (messages.getnumValidMessages() <= 0)
+    if (!this->finishActiveDownlinkSession(pacing))
+    {
+      return false;
+    }
+
+    const U32 num_messages = paramGet_DOWNLINK_MESSAGE_COUNT(valid);
+    FW_ASSERT(valid.e == Fw::ParamValid::VALID || valid.e == Fw::ParamValid::DEFAULT, valid.e);
+    const bool delta_mode = paramGet_DOWNLINK_DELTA_MODE(valid);
+    FW_ASSERT(valid.e == Fw::ParamValid::VALID || valid.e == Fw::ParamValid::DEFAULT, valid.e);
+
+    bool include_all{true};
+    U32 after_index{0};
+    if (delta_mode)
+    {
+      const bool force_full_resend = paramGet_DOWNLINK_FORCE_FULL_RESEND(valid);
+      FW_ASSERT(valid.e == Fw::ParamValid::VALID || valid.e == Fw::ParamValid::DEFAULT, valid.e);
+
+      const DownlinkCursor &cursor = this->m_downlinkCursors[source.e];
+      include_all = force_full_resend || !cursor.valid;
+      after_index = cursor.index;
+    }
+
+    // Frames of delta downlinks depend on the cursor, so only the default mode is cached
+    const bool frame_cache = paramGet_DOWNLINK_FRAME_CACHE(valid);
+    FW_ASSERT(valid.e == Fw::ParamValid::VALID || valid.e == Fw::ParamValid::DEFAULT, valid.e);
+    const bool use_cache{frame_cache && !delta_mode && this->isConnected_getStoreGeneration_OutputPort(0)};
+
+    if (!this->startDownlinkSession(num_messages, include_all, after_index, use_cache, false))
     {
       // No error event in this case.
       // Message storage will have triggered error events already if messages existed but loading failed.
+      // In delta mode, this is also the case if no new messages have been stored since the last downlink.
       return false;
     }
 
-    for (U32 i = 0; i < messages.getnumValidMessages(); i++)
+    // The cursor only advances once all frames have been sent, so a paced downlink which is cut short by a reboot is
+    // repeated instead of skipped
+    this->m_session.advanceCursor = delta_mode;
+    this->m_session.source = source;
+
+    // Without pacing, send all frames right away. Otherwise, pacingTick sends them
+    if (!pacing)
     {
-      const SpacePost &message = message_array[i];
+      while (this->m_session.active)
+      {
+        (void)this->sendNextFrame();
+      }
+    }
 
-      Fw::ComBuffer comBuffer{}; // ComBuffer is autoamtically allocated on the stack on intialization => no alloc call
+    this->m_lastDownlinkTime = this->getTime();
+    return true;
+  }
 
-      // Serialize message into comBuffer
-      comBuffer.resetSer();
-      Fw::SerializeStatus status = comBuffer.serialize(message);
-      FW_ASSERT(Fw::FW_SERIALIZE_OK == status, static_cast<NATIVE_INT_TYPE>(status));
+  bool Transceiver::sendQuarantine(const U32 numMessages)
+  {
+    if (!this->isConnected_loadQuarantine_OutputPort(0))
+    {
+      return false;
+    }
+
+    Fw::ParamValid valid;
+    const bool pacing = paramGet_DOWNLINK_PACING_ENABLED(valid);
+    FW_ASSERT(valid.e == Fw::ParamValid::VALID || valid.e == Fw::ParamValid::DEFAULT, valid.e);
+
+    if (!this->finishActiveDownlinkSession(pacing))
+    {
+      return false;
+    }
+
+    // Quarantined SpacePosts are only downlinked on demand, so neither cursors nor the frame cache apply
+    if (!this->startDownlinkSession(numMessages, true, 0, false, true))
+    {
+      return false;
+    }
+
+    if (!pacing)
+    {
+      while (this->m_session.active)
+      {
+        (void)this->sendNextFrame();
+      }
+    }
+
+    this->m_lastDownlinkTime = this->getTime();
+    return true;
+  }
+
+  bool Transceiver::finishActiveDownlinkSession(const bool pacing)
+  {
+    if (!this->m_session.active)
+    {
+      return true;
+    }
+
+    if (pacing)
+    {
+      // The previous downlink has not finished within its slot. Do not interrupt it
+      this->tlmWrite_DOWNLINK_SLOT_OVERRUNS(++this->m_slotOverruns);
+      return false;
+    }
+
+    // Pacing was disabled while a paced downlink was in progress. Finish it before starting the next one
+    while (this->m_session.active)
+    {
+      (void)this->sendNextFrame();
+    }
+    return true;
+  }
+
+  bool Transceiver::startDownlinkSession(const U32 numMessages, const bool includeAll, const U32 afterIndex,
+                                         const bool useCache, const bool fromQuarantine)
+  {
+    FW_ASSERT(!this->m_session.active);
+    FW_ASSERT(!(useCache && fromQuarantine));
+    DownlinkSession &session = this->m_session;
+    FrameCache &cache = this->m_frameCache;
+    if (numMessages == 0)
+    {
+      return false;
+    }
+
+    // Frame settings are fixed for the whole session so that a paced downlink is consistent
+    Fw::ParamValid valid;
+    session.packedMode = paramGet_DOWNLINK_PACKED_MODE(valid);
+    FW_ASSERT(valid.e == Fw::ParamValid::VALID || valid.e == Fw::ParamValid::DEFAULT, valid.e);
+    session.mtu = paramGet_DOWNLINK_PACKED_MTU(valid);
+    FW_ASSERT(valid.e == Fw::ParamValid::VALID || valid.e == Fw::ParamValid::DEFAULT, valid.e);
+    session.compress = paramGet_DOWNLINK_COMPRESSION(valid);
+    FW_ASSERT(valid.e == Fw::ParamValid::VALID || valid.e == Fw::ParamValid::DEFAULT, valid.e);
+    session.pooledBuffers = paramGet_DOWNLINK_POOLED_BUFFERS(valid);
+    FW_ASSERT(valid.e == Fw::ParamValid::VALID || valid.e == Fw::ParamValid::DEFAULT, valid.e);
+
+    session.fromQuarantine = fromQuarantine;
+    session.advanceCursor = false;
+    session.nextMessage = 0;
+    session.nextFrame = 0;
+    session.numMessagesSent = 0;
+    session.numFrames = 0;
+    session.numFrameBytes = 0;
+    session.numBufferBytesAllocated = 0;
+    session.numBufferBytesUsed = 0;
+
+    // Nothing has been stored since the cached frames were loaded, by whichever component, and they have the same
+    // format: re-send them. Read before loading, so that a SpacePost stored while loading outdates the new frames
+    const U32 store_generation = useCache ? this->getStoreGeneration_out(0) : 0;
+    session.fromCache = useCache && cache.valid && cache.storeGeneration == store_generation &&
+                        cache.numMessages == numMessages && cache.packedMode == session.packedMode &&
+                        cache.mtu == session.mtu && cache.compress == session.compress;
+    if (session.fromCache)
+    {
+      session.numMessagesToLoad = 0;
+      session.active = true;
+      this->tlmWrite_DOWNLINK_CACHE_HITS(++this->m_frameCacheHits);
+      this->tlmWrite_DOWNLINK_QUEUE_DEPTH(this->numPendingMessages());
+      return true;
+    }
+
+    // Load the first page straight into the session's batch. Later pages reuse it
+    session.includeAll = includeAll;
+    session.afterIndex = afterIndex;
+    const U8 page_size = static_cast<U8>((numMessages < TRANSCEIVER_DOWNLINK_PAGE_SIZE) ? numMessages
+                                                                                       : TRANSCEIVER_DOWNLINK_PAGE_SIZE);
+    const U8 num_loaded = includeAll ? this->loadSessionPage(page_size, 0, true, session.newestIndex)
+                                     : this->loadOldestSessionPage(numMessages, page_size);
+    if (num_loaded == 0 || session.messages.getnumValidMessages() <= 0)
+    {
+      return false;
+    }
+
+    // A short page means that the storage holds no further SpacePosts in range
+    session.numMessagesToLoad = (num_loaded < page_size) ? 0 : numMessages - num_loaded;
+    session.active = true;
+
+    // Capture the frames of this session to replace the cached ones
+    if (useCache)
+    {
+      cache.valid = false;
+      cache.capturing = true;
+      cache.storeGeneration = store_generation;
+      cache.numMessages = numMessages;
+      cache.packedMode = session.packedMode;
+      cache.mtu = session.mtu;
+      cache.compress = session.compress;
+      cache.numFrames = 0;
+      cache.numBytes = 0;
+      cache.numPosts = 0;
+      cache.bytesSaved = this->m_bytesSavedByCompression; // Turned into the difference when capturing is complete
+    }
+
+    this->tlmWrite_DOWNLINK_QUEUE_DEPTH(this->numPendingMessages());
+    return true;
+  }
+
+  U8 Transceiver::loadOldestSessionPage(const U32 numMessages, const U8 pageSize)
+  {
+    DownlinkSession &session = this->m_session;
+    if (session.afterIndex == std::numeric_limits<U32>::max())
+    {
+      // Nothing can be stored at a higher index
+      return 0;
+    }
+
+    // Without an upper bound, i.e., if the window wraps around MAX_U32, the last stored SpacePosts are loaded
+    U32 before_index{0};
+    bool from_newest = !pageBeforeIndex(session.afterIndex + 1, numMessages, before_index);
+    const U8 num_loaded = this->loadSessionPage(pageSize, before_index, from_newest, session.newestIndex);
+    if (num_loaded > 0 || from_newest)
+    {
+      return num_loaded;
+    }
+
+    // Nothing is stored within the window. Find the oldest SpacePost after afterIndex, which is in the last page
+    U32 oldest_index{0};
+    bool found{false};
+    U8 num_walked{pageSize};
+    from_newest = true;
+    while (num_walked == pageSize)
+    {
+      num_walked = this->loadSessionPage(pageSize, before_index, from_newest, session.newestIndex);
+      if (num_walked > 0)
+      {
+        found = true;
+        oldest_index = session.oldestIndex;
+        before_index = oldest_index;
+        from_newest = false;
+      }
+    }
+    if (!found)
+    {
+      return 0;
+    }
+
+    from_newest = !pageBeforeIndex(oldest_index, numMessages, before_index);
+    return this->loadSessionPage(pageSize, before_index, from_newest, session.newestIndex);
+  }
+
+  bool Transceiver::pageBeforeIndex(const U32 firstIndex, const U32 numMessages, U32 &beforeIndex)
+  {
+    if (numMessages > std::numeric_limits<U32>::max() - firstIndex)
+    {
+      return false;
+    }
+    beforeIndex = firstIndex + numMessages;
+    return true;
+  }
+
+  bool Transceiver::loadNextPage()
+  {
+    FW_ASSERT(this->m_session.active);
+    DownlinkSession &session = this->m_session;
+    if (session.numMessagesToLoad == 0)
+    {
+      return false;
+    }
+
+    const U8 page_size = static_cast<U8>((session.numMessagesToLoad < TRANSCEIVER_DOWNLINK_PAGE_SIZE)
+                                             ? session.numMessagesToLoad
+                                             : TRANSCEIVER_DOWNLINK_PAGE_SIZE);
+    U32 newest_index{0}; // Only needed for the first page
+    const U8 num_loaded = this->loadSessionPage(page_size, session.oldestIndex, false, newest_index);
+
+    session.numMessagesToLoad = (num_loaded < page_size) ? 0 : session.numMessagesToLoad - num_loaded;
+    session.nextMessage = 0;
+    return num_loaded > 0 && session.messages.getnumValidMessages() > 0;
+  }
+
+  U8 Transceiver::loadSessionPage(const U8 pageSize, const U32 beforeIndex, const bool fromNewest, U32 &newestIndex)
+  {
+    DownlinkSession &session = this->m_session;
+    if (session.fromQuarantine)
+    {
+      return this->loadQuarantine_out(0, pageSize, session.afterIndex, session.includeAll, beforeIndex, fromNewest,
+                                      session.messages, newestIndex, session.oldestIndex);
+    }
+    return this->loadMessages_out(0, pageSize, session.afterIndex, session.includeAll, beforeIndex, fromNewest,
+                                  session.messages, newestIndex, session.oldestIndex);
+  }
+
+  U32 Transceiver::sendNextFrame()
+  {
+    FW_ASSERT(this->m_session.active);
+    DownlinkSession &session = this->m_session;
+
+    U32 frame_size{0};
+    if (!session.pooledBuffers || !this->sendNextFrameInPooledBuffer(frame_size))
+    {
+      Fw::ComBuffer comBuffer{}; // ComBuffer is autoamtically allocated on the stack on intialization => no alloc call
+      this->serializeNextFrame(comBuffer);
+      frame_size = comBuffer.getBuffLength();
 
       if (this->isConnected_downlinkMessage_OutputPort(0))
       {
@@ -146,10 +508,417 @@ namespace SpacePosts
       }
     }
 
-    this->m_lastDownlinkTime = this->getTime();
+    session.numFrames++;
+    session.numFrameBytes += frame_size;
+
+    if (session.fromCache)
+    {
+      if (session.nextFrame >= this->m_frameCache.numFrames)
+      {
+        this->finishDownlinkSession();
+      }
+    }
+    else if (session.nextMessage >= session.messages.getnumValidMessages() && !this->loadNextPage())
+    {
+      this->finishDownlinkSession();
+    }
+
+    return frame_size;
+  }
+
+  bool Transceiver::sendNextFrameInPooledBuffer(U32 &frameSize)
+  {
+    DownlinkSession &session = this->m_session;
+    if (!this->isConnected_allocateBuffer_OutputPort(0) || !this->isConnected_sendBuffer_OutputPort(0))
+    {
+      return false;
+    }
+
+    // Large enough for any frame of the session's format
+    const U32 max_single_frame_size = sizeof(U8) + SpacePost::SERIALIZED_SIZE;
+    const U32 max_packed_frame_size = TRANSCEIVER_PACKED_FRAME_HEADER_SIZE + SpacePost::SERIALIZED_SIZE;
+    const U32 requested_size = !session.packedMode                     ? max_single_frame_size
+                               : (session.mtu > max_packed_frame_size) ? session.mtu
+                                                                       : max_packed_frame_size;
+
+    Fw::Buffer buffer = this->allocateBuffer_out(0, requested_size);
+    if (buffer.getData() == nullptr || buffer.getSize() < requested_size)
+    {
+      if (buffer.getData() != nullptr && this->isConnected_deallocateBuffer_OutputPort(0))
+      {
+        this->deallocateBuffer_out(0, buffer);
+      }
+      this->log_WARNING_LO_DOWNLINK_BUFFER_ALLOCATION_FAILED(requested_size, buffer.getSize());
+      this->tlmWrite_DOWNLINK_BUFFER_ALLOC_FAILURES(++this->m_bufferAllocationFailures);
+      return false;
+    }
+    this->tlmWrite_DOWNLINK_BUFFERS_ALLOCATED(++this->m_buffersAllocated);
+
+    // Serialize the frame once, straight into the pooled buffer
+    Fw::SerializeBufferBase &frame = buffer.getSerializeRepr();
+    this->serializeNextFrame(frame);
+    frameSize = frame.getBuffLength();
+
+    session.numBufferBytesAllocated += buffer.getSize();
+    session.numBufferBytesUsed += frameSize;
+    buffer.setSize(frameSize);
+
+    // Ownership passes to the receiver
+    this->sendBuffer_out(0, buffer);
     return true;
   }
 
+  void Transceiver::serializeNextFrame(Fw::SerializeBufferBase &frame)
+  {
+    DownlinkSession &session = this->m_session;
+    FrameCache &cache = this->m_frameCache;
+
+    if (session.fromCache)
+    {
+      // Copy the cached frame. No storage access and no serialization needed
+      const U32 offset = cache.frameOffsets[session.nextFrame];
+      const U32 size = cache.frameOffsets[session.nextFrame + 1] - offset;
+      frame.resetSer();
+      const Fw::SerializeStatus status = frame.serialize(&cache.data[offset], size, true);
+      FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+      session.numMessagesSent += cache.framePosts[session.nextFrame];
+      session.nextFrame++;
+      return;
+    }
+
+    const U32 first_message = session.nextMessage;
+    const SpacePost_Array &message_array = session.messages.getmessages();
+    if (session.packedMode)
+    {
+      session.nextMessage += this->serializePackedFrame(session.messages, session.nextMessage, session.mtu,
+                                                        session.compress, frame);
+    }
+    else
+    {
+      this->serializeSingleFrame(message_array[session.nextMessage], session.compress, frame);
+      session.nextMessage++;
+    }
+    const U32 num_posts = session.nextMessage - first_message;
+    session.numMessagesSent += num_posts;
+
+    if (cache.capturing)
+    {
+      this->captureFrame(frame.getBuffAddr(), frame.getBuffLength(), num_posts);
+    }
+  }
+
+  void Transceiver::captureFrame(const U8 *const frame, const U32 size, const U32 numPosts)
+  {
+    FrameCache &cache = this->m_frameCache;
+    if (cache.numFrames >= TRANSCEIVER_FRAME_CACHE_MAX_FRAMES ||
+        size > TRANSCEIVER_FRAME_CACHE_SIZE - cache.numBytes)
+    {
+      // The downlink does not fit into the cache
+      cache.capturing = false;
+      return;
+    }
+
+    (void)std::memcpy(&cache.data[cache.numBytes], frame, size);
+    cache.frameOffsets[cache.numFrames] = cache.numBytes;
+    cache.framePosts[cache.numFrames] = static_cast<U8>(numPosts);
+    cache.numFrames++;
+    cache.numBytes += size;
+    cache.frameOffsets[cache.numFrames] = cache.numBytes;
+    cache.numPosts += numPosts;
+  }
+
+  U32 Transceiver::numPendingMessages() const
+  {
+    const DownlinkSession &session = this->m_session;
+    if (session.fromCache)
+    {
+      return this->m_frameCache.numPosts - session.numMessagesSent;
+    }
+    return session.messages.getnumValidMessages() - session.nextMessage + session.numMessagesToLoad;
+  }
+
+  void Transceiver::finishDownlinkSession()
+  {
+    DownlinkSession &session = this->m_session;
+    FW_ASSERT(session.numFrames > 0);
+
+    // Packing efficiency of this downlink
+    const F32 posts_per_frame = static_cast<F32>(session.numMessagesSent) / static_cast<F32>(session.numFrames);
+    this->tlmWrite_DOWNLINK_POSTS_PER_FRAME(posts_per_frame);
+
+    // The MTU only applies to packed frames
+    if (session.packedMode)
+    {
+      const F32 frame_fill = (session.mtu == 0) ? 100.0f
+                                                : 100.0f * static_cast<F32>(session.numFrameBytes) /
+                                                      (static_cast<F32>(session.numFrames) *
+                                                       static_cast<F32>(session.mtu));
+      this->tlmWrite_DOWNLINK_FRAME_FILL(frame_fill);
+    }
+    if (session.numBufferBytesAllocated > 0)
+    {
+      this->tlmWrite_DOWNLINK_BUFFER_UTILIZATION(100.0f * static_cast<F32>(session.numBufferBytesUsed) /
+                                                 static_cast<F32>(session.numBufferBytesAllocated));
+    }
+
+    FrameCache &cache = this->m_frameCache;
+    if (session.fromCache)
+    {
+      // The cached frames save as many bytes as when they were compressed
+      this->m_bytesSavedByCompression += cache.bytesSaved;
+    }
+    else if (cache.capturing)
+    {
+      // All frames of the session were captured
+      cache.capturing = false;
+      cache.valid = true;
+      cache.bytesSaved = this->m_bytesSavedByCompression - cache.bytesSaved;
+    }
+
+    if (session.compress)
+    {
+      this->tlmWrite_DOWNLINK_BYTES_SAVED(this->m_bytesSavedByCompression);
+    }
+
+    session.active = false;
+    this->tlmWrite_DOWNLINK_QUEUE_DEPTH(0);
+
+    // The newest SpacePost of the session is the highest index sent
+    if (session.advanceCursor)
+    {
+      this->advanceDownlinkCursor(session.source, session.newestIndex);
+    }
+  }
+
+  void Transceiver::downlinkCmd(const FwOpcodeType opCode, const U32 cmdSeq, const DownlinkSource source)
+  {
+    const bool success = this->sendMessages(source);
+    const Fw::CmdResponse response = success ? Fw::CmdResponse::OK : Fw::CmdResponse::EXECUTION_ERROR;
+    this->cmdResponse_out(opCode, cmdSeq, response);
+  }
+
+  void Transceiver::advanceDownlinkCursor(const DownlinkSource source, const U32 newestIndex)
+  {
+    DownlinkCursor &cursor = this->m_downlinkCursors[source.e];
+    cursor.valid = true;
+    cursor.index = newestIndex;
+    this->persistDownlinkCursors();
+  }
+
+  void Transceiver::restoreDownlinkCursors()
+  {
+    for (DownlinkCursor &cursor : this->m_downlinkCursors)
+    {
+      cursor = DownlinkCursor{false, 0};
+    }
+
+    Os::File file{};
+    const Os::File::Status open_status = file.open(TRANSCEIVER_CURSOR_FILE.c_str(), Os::File::OPEN_READ);
+    if (open_status == Os::File::DOESNT_EXIST)
+    {
+      // Nothing has been downlinked in delta mode yet
+      return;
+    }
+    if (open_status != Os::File::OP_OK)
+    {
+      this->log_WARNING_LO_DOWNLINK_CURSOR_FILE_ERROR(CursorFileError::OPEN_READ, open_status);
+      return;
+    }
+
+    U8 data[CURSOR_FILE_SIZE];
+    NATIVE_INT_TYPE read_size{CURSOR_FILE_SIZE}; // Will be overwritten by file.read()
+    const Os::File::Status read_status = file.read(data, read_size, true);
+    if (read_status != Os::File::OP_OK || read_size != CURSOR_FILE_SIZE)
+    {
+      this->log_WARNING_LO_DOWNLINK_CURSOR_FILE_ERROR(CursorFileError::READ,
+                                                      read_status != Os::File::OP_OK ? read_status : read_size);
+      return;
+    }
+
+    Fw::ExternalSerializeBuffer buffer{data, sizeof(data)};
+    Fw::SerializeStatus status = buffer.setBuffLen(sizeof(data));
+    U8 delimiter{0};
+    if (status == Fw::FW_SERIALIZE_OK)
+    {
+      status = buffer.deserialize(delimiter);
+    }
+    if (status != Fw::FW_SERIALIZE_OK || delimiter != TRANSCEIVER_CURSOR_FILE_DELIMITER)
+    {
+      this->log_WARNING_LO_DOWNLINK_CURSOR_FILE_ERROR(CursorFileError::CONTENT, delimiter);
+      return;
+    }
+
+    DownlinkCursor restored_cursors[DownlinkSource::NUM_CONSTANTS]{};
+    for (DownlinkCursor &cursor : restored_cursors)
+    {
+      U8 cursor_valid{0};
+      status = buffer.deserialize(cursor_valid);
+      if (status == Fw::FW_SERIALIZE_OK)
+      {
+        status = buffer.deserialize(cursor.index);
+      }
+      if (status != Fw::FW_SERIALIZE_OK)
+      {
+        this->log_WARNING_LO_DOWNLINK_CURSOR_FILE_ERROR(CursorFileError::CONTENT, status);
+        return;
+      }
+      cursor.valid = cursor_valid != 0;
+    }
+
+    // Only take over the cursors once the complete file has been parsed
+    for (U32 i = 0; i < DownlinkSource::NUM_CONSTANTS; i++)
+    {
+      this->m_downlinkCursors[i] = restored_cursors[i];
+    }
+  }
+
+  void Transceiver::persistDownlinkCursors()
+  {
+    U8 data[CURSOR_FILE_SIZE];
+    Fw::ExternalSerializeBuffer buffer{data, sizeof(data)};
+    Fw::SerializeStatus status = buffer.serialize(static_cast<U8>(TRANSCEIVER_CURSOR_FILE_DELIMITER));
+    FW_ASSERT(Fw::FW_SERIALIZE_OK == status, static_cast<NATIVE_INT_TYPE>(status));
+    for (const DownlinkCursor &cursor : this->m_downlinkCursors)
+    {
+      status = buffer.serialize(static_cast<U8>(cursor.valid ? 1 : 0));
+      FW_ASSERT(Fw::FW_SERIALIZE_OK == status, static_cast<NATIVE_INT_TYPE>(status));
+      status = buffer.serialize(cursor.index);
+      FW_ASSERT(Fw::FW_SERIALIZE_OK == status, static_cast<NATIVE_INT_TYPE>(status));
+    }
+
+    // File is automatically created (or truncated) when opening for write
+    Os::File file{};
+    const Os::File::Status open_status = file.open(TRANSCEIVER_CURSOR_FILE.c_str(), Os::File::OPEN_SYNC_WRITE);
+    if (open_status != Os::File::OP_OK)
+    {
+      this->log_WARNING_LO_DOWNLINK_CURSOR_FILE_ERROR(CursorFileError::OPEN_WRITE, open_status);
+      return;
+    }
+
+    NATIVE_INT_TYPE write_size = buffer.getBuffLength(); // Will be overwritten by file.write()
+    const Os::File::Status write_status = file.write(data, write_size, true);
+    if (write_status != Os::File::OP_OK || write_size != CURSOR_FILE_SIZE)
+    {
+      this->log_WARNING_LO_DOWNLINK_CURSOR_FILE_ERROR(CursorFileError::WRITE,
+                                                      write_status != Os::File::OP_OK ? write_status : write_size);
+    }
+  }
+
+  void Transceiver::serializeSingleFrame(const SpacePost &message, const bool compress,
+                                         Fw::SerializeBufferBase &frame)
+  {
+    Fw::SerializeStatus status{Fw::FW_SERIALIZE_OK};
+    if (compress)
+    {
+      frame.resetSer();
+      status = frame.serialize(static_cast<U8>(TRANSCEIVER_FRAME_MARKER_COMPRESSED));
+      FW_ASSERT(Fw::FW_SERIALIZE_OK == status, static_cast<NATIVE_INT_TYPE>(status));
+
+      U32 bytes_saved{0};
+      status = this->serializeCompressedRecord(message, frame, bytes_saved);
+      FW_ASSERT(Fw::FW_SERIALIZE_OK == status, static_cast<NATIVE_INT_TYPE>(status));
+
+      // The marker costs one byte. Only send the compressed frame if it is still smaller
+      if (bytes_saved > 1)
+      {
+        this->m_bytesSavedByCompression += bytes_saved - 1;
+        return;
+      }
+    }
+
+    frame.resetSer();
+    status = frame.serialize(message);
+    FW_ASSERT(Fw::FW_SERIALIZE_OK == status, static_cast<NATIVE_INT_TYPE>(status));
+  }
+
+  U32 Transceiver::serializePackedFrame(const SpacePost_Batch &messages, const U32 firstMessage, const U32 mtu,
+                                        const bool compress, Fw::SerializeBufferBase &frame)
+  {
+    FW_ASSERT(firstMessage < messages.getnumValidMessages(), firstMessage, messages.getnumValidMessages());
+    const SpacePost_Array &message_array = messages.getmessages();
+    const U32 frame_capacity = (mtu < frame.getBuffCapacity()) ? mtu : frame.getBuffCapacity();
+
+    // Header. The number of posts is only known after packing, so patch it in afterwards
+    const U8 marker = compress ? TRANSCEIVER_FRAME_MARKER_PACKED_COMPRESSED : TRANSCEIVER_FRAME_MARKER_PACKED;
+    frame.resetSer();
+    Fw::SerializeStatus status = frame.serialize(marker);
+    FW_ASSERT(Fw::FW_SERIALIZE_OK == status, static_cast<NATIVE_INT_TYPE>(status));
+    status = frame.serialize(static_cast<U8>(0));
+    FW_ASSERT(Fw::FW_SERIALIZE_OK == status, static_cast<NATIVE_INT_TYPE>(status));
+
+    U32 num_packed = 0;
+    U32 bytes_saved = 0;
+    for (U32 i = firstMessage; i < messages.getnumValidMessages() && num_packed < 0xFF; i++)
+    {
+      const NATIVE_UINT_TYPE length_before = frame.getBuffLength();
+      U32 record_bytes_saved{0};
+      status = compress ? this->serializeCompressedRecord(message_array[i], frame, record_bytes_saved)
+                        : frame.serialize(message_array[i]);
+
+      const bool fits = (Fw::FW_SERIALIZE_OK == status) && (frame.getBuffLength() <= frame_capacity);
+      if (!fits && num_packed > 0)
+      {
+        // Roll back the partially or fully written post. It goes into the next frame
+        status = frame.setBuffLen(length_before);
+        FW_ASSERT(Fw::FW_SERIALIZE_OK == status, static_cast<NATIVE_INT_TYPE>(status));
+        break;
+      }
+
+      // The first post of a frame is always packed, even if it exceeds the MTU.
+      // It must still fit into the frame buffer which is always the case for a ComBuffer.
+      FW_ASSERT(Fw::FW_SERIALIZE_OK == status, static_cast<NATIVE_INT_TYPE>(status));
+      num_packed++;
+      bytes_saved += record_bytes_saved;
+    }
+
+    frame.getBuffAddr()[1] = static_cast<U8>(num_packed);
+    this->m_bytesSavedByCompression += bytes_saved;
+    return num_packed;
+  }
+
+  Fw::SerializeStatus Transceiver::serializeCompressedRecord(const SpacePost &message, Fw::SerializeBufferBase &frame,
+                                                             U32 &bytesSaved)
+  {
+    const Fw::StringBase &text = message.getmessage_content();
+    const U32 text_length = text.length();
+    FW_ASSERT(text_length <= 0xFF, text_length); // Guaranteed by SpacePost_MaxTextLength
+
+    const NATIVE_UINT_TYPE record_start = frame.getBuffLength();
+    const NATIVE_UINT_TYPE remaining = frame.getBuffCapacity() - record_start;
+    if (remaining < TRANSCEIVER_COMPRESSED_RECORD_HEADER_SIZE)
+    {
+      return Fw::FW_SERIALIZE_NO_ROOM_LEFT;
+    }
+
+    // Encode straight into the frame behind the record header
+    U8 *const record = frame.getBuffAddr() + record_start;
+    U8 *const payload = record + TRANSCEIVER_COMPRESSED_RECORD_HEADER_SIZE;
+    const U32 payload_capacity = remaining - TRANSCEIVER_COMPRESSED_RECORD_HEADER_SIZE;
+    const U8 *const raw_text = reinterpret_cast<const U8 *>(text.toChar());
+
+    // Only keep the encoded text if it is shorter than the raw text. Otherwise, store the raw text
+    U32 payload_length{0};
+    const bool compressed = (text_length > 0) &&
+                            this->m_codec.encode(raw_text, text_length, payload,
+                                                 (payload_capacity < text_length - 1) ? payload_capacity
+                                                                                      : text_length - 1,
+                                                 payload_length);
+    if (!compressed)
+    {
+      if (payload_capacity < text_length)
+      {
+        return Fw::FW_SERIALIZE_NO_ROOM_LEFT;
+      }
+      (void)std::memcpy(payload, raw_text, text_length);
+      payload_length = text_length;
+    }
+
+    record[0] = static_cast<U8>(text_length);
+    record[1] = static_cast<U8>(payload_length);
+    bytesSaved = text_length - payload_length;
+    return frame.setBuffLen(record_start + TRANSCEIVER_COMPRESSED_RECORD_HEADER_SIZE + payload_length);
+  }
+
   void Transceiver::rejectHamUserDownlinkCmd(const FwOpcodeType opCode, const U32 cmdSeq)
   {
     // Give a response for now. This behavior might change in the future, thus it is its own function.
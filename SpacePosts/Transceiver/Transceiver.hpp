@@ -14,9 +14,14 @@
 #define TRANSCEIVER_HPP
 
 #include "SpacePosts/Transceiver/TransceiverComponentAc.hpp"
+#include "SpacePosts/Transceiver/SpacePostCodec.hpp"
+#include <config/TransceiverCfg.hpp>
 
 namespace SpacePosts
 {
+    // Make component enums availble in this scope
+    typedef Transceiver_DownlinkSource DownlinkSource;
+    typedef Transceiver_CursorFileError CursorFileError;
 
     class Transceiver : public TransceiverComponentBase
     {
@@ -31,6 +36,100 @@ namespace SpacePosts
             //! No matter how the downlink was triggered (GDS command, HAM user command, schedule port)
             Fw::Time m_lastDownlinkTime{};
 
+            //! Position of a trigger source in the sequence of stored SpacePosts for the delta downlink mode
+            struct DownlinkCursor
+            {
+                bool valid;  //!< False iff this source has not downlinked anything in delta mode yet
+                U32 index;   //!< The highest storage index already downlinked for this source. Only valid if valid
+            };
+
+            //! The delta downlink cursors, one per DownlinkSource
+            //!
+            //! Restored from TRANSCEIVER_CURSOR_FILE upon initialization and persisted after every delta downlink.
+            DownlinkCursor m_downlinkCursors[DownlinkSource::NUM_CONSTANTS]{};
+
+            //! Compresses the text of downlinked SpacePosts if DOWNLINK_COMPRESSION is enabled
+            SpacePostCodec m_codec{};
+
+            //! The total number of downlinked bytes saved by compression since the component was started
+            U32 m_bytesSavedByCompression{0};
+
+            //! A downlink which has been triggered but whose frames have not all been sent yet
+            struct DownlinkSession
+            {
+                bool active;               //!< True iff frames of this session are still to be sent
+                bool fromCache;            //!< True iff the frames are copied from m_frameCache
+                bool fromQuarantine;       //!< True iff the pages are loaded through loadQuarantine
+                U32 nextFrame;             //!< Index in m_frameCache of the first frame not sent yet, if fromCache
+                SpacePost_Batch messages;  //!< The loaded page of SpacePosts to downlink. Reused for every page
+                U32 nextMessage;           //!< Index in messages of the first SpacePost not sent yet
+                U32 numMessagesToLoad;     //!< Number of SpacePosts still to load in further pages
+                bool includeAll;           //!< True iff the pages have no lower index bound
+                U32 afterIndex;            //!< Lower index bound of the pages, unless includeAll
+                U32 oldestIndex;           //!< Storage index of the oldest SpacePost of the current page
+                U32 newestIndex;           //!< Storage index of the newest SpacePost of the session, unless fromCache
+                bool advanceCursor;        //!< True iff the delta cursor of source advances when the session finishes
+                DownlinkSource source;     //!< The trigger of the session. Only used if advanceCursor
+                U32 numMessagesSent;       //!< Number of SpacePosts sent in all pages so far
+                bool packedMode;           //!< DOWNLINK_PACKED_MODE at the start of the session
+                U32 mtu;                   //!< DOWNLINK_PACKED_MTU at the start of the session
+                bool compress;             //!< DOWNLINK_COMPRESSION at the start of the session
+                bool pooledBuffers;        //!< DOWNLINK_POOLED_BUFFERS at the start of the session
+                U32 numFrames;             //!< Number of frames sent so far
+                U32 numFrameBytes;         //!< Number of bytes in the frames sent so far
+                U32 numBufferBytesAllocated; //!< Number of bytes of the pooled buffers allocated so far
+                U32 numBufferBytesUsed;    //!< Number of bytes of the pooled buffers filled with frames so far
+            };
+
+            //! The current downlink session
+            //!
+            //! Without pacing, a session is started and finished within the same call. With pacing, its frames are
+            //! sent by the pacingTick port.
+            DownlinkSession m_session{};
+
+            //! The serialized frames of the last downlink in the default (non-delta) mode
+            //!
+            //! Frames are captured while a session serializes them and become valid when the session has completely
+            //! been captured. They are only re-sent while the store generation of the storage is the one read before
+            //! the session loaded its first page.
+            struct FrameCache
+            {
+                bool valid;                //!< True iff the frames are complete
+                U32 storeGeneration;       //!< Store generation of the storage before the frames were loaded
+                bool capturing;            //!< True iff the frames of the active session are being captured
+                U32 numMessages;           //!< DOWNLINK_MESSAGE_COUNT of the cached downlink
+                bool packedMode;           //!< DOWNLINK_PACKED_MODE of the cached downlink
+                U32 mtu;                   //!< DOWNLINK_PACKED_MTU of the cached downlink
+                bool compress;             //!< DOWNLINK_COMPRESSION of the cached downlink
+                U32 numFrames;             //!< Number of cached frames
+                U32 numBytes;              //!< Number of bytes of all cached frames
+                U32 numPosts;              //!< Number of SpacePosts in all cached frames
+                U32 bytesSaved;            //!< Number of bytes saved by compressing the cached frames
+                U32 frameOffsets[TRANSCEIVER_FRAME_CACHE_MAX_FRAMES + 1]; //!< Start of each frame in data, and the end
+                U8 framePosts[TRANSCEIVER_FRAME_CACHE_MAX_FRAMES];        //!< Number of SpacePosts in each frame
+                U8 data[TRANSCEIVER_FRAME_CACHE_SIZE];                    //!< The frames, back to back
+            };
+
+            //! The cache of serialized downlink frames. Only used with DOWNLINK_FRAME_CACHE
+            FrameCache m_frameCache{};
+
+            //! The number of downlinks sent from m_frameCache since the component was started
+            U32 m_frameCacheHits{0};
+
+            //! The token bucket of the downlink pacing in bytes
+            //!
+            //! Negative if the last frame sent was larger than the remaining tokens.
+            I64 m_pacingTokens{0};
+
+            //! The number of downlink triggers which arrived while the previous downlink was still in progress
+            U32 m_slotOverruns{0};
+
+            //! The number of pooled buffers allocated for frames since the component was started
+            U32 m_buffersAllocated{0};
+
+            //! The number of frames for which no suitable pooled buffer could be allocated
+            U32 m_bufferAllocationFailures{0};
+
     public:
         // ----------------------------------------------------------------------
         // Construction, initialization, and destruction
@@ -66,6 +165,16 @@ namespace SpacePosts
                 NATIVE_UINT_TYPE context       /*!< The call order */
                 ) override;
 
+            //! Handler implementation for pacingTick
+            //!
+            //! Sends the frames of the current downlink session up to the budget configured by
+            //! DOWNLINK_PACING_BYTES_PER_TICK and DOWNLINK_PACING_FRAMES_PER_TICK.
+            void
+            pacingTick_handler(
+                const NATIVE_INT_TYPE portNum, /*!< The port number*/
+                NATIVE_UINT_TYPE context       /*!< The call order */
+                ) override;
+
         PRIVATE :
 
             // ----------------------------------------------------------------------
@@ -83,6 +192,15 @@ namespace SpacePosts
                        */
                 ) override;
 
+            //! Implementation for STORE_MESSAGES command handler
+            //! Store the given SpacePosts on the satellite at once
+            void
+            STORE_MESSAGES_cmdHandler(
+                const FwOpcodeType opCode, /*!< The opcode*/
+                const U32 cmdSeq,          /*!< The command sequence number*/
+                SpacePost_Batch msgs       /*!< The messages to store on the satellite */
+                ) override;
+
         //! Implementation for DOWNLINK_LAST_MESSAGES command handler
         //!
         void DOWNLINK_LAST_MESSAGES_GDS_cmdHandler(
@@ -97,6 +215,14 @@ namespace SpacePosts
             const U32 cmdSeq           /*!< The command sequence number*/
             ) override;
 
+        //! Implementation for DOWNLINK_QUARANTINE command handler
+        //! Initiate the downlink of the last SpacePosts in the quarantine store
+        void DOWNLINK_QUARANTINE_cmdHandler(
+            const FwOpcodeType opCode, /*!< The opcode*/
+            const U32 cmdSeq,          /*!< The command sequence number*/
+            U32 count                  /*!< The number of last quarantined SpacePosts to downlink */
+            ) override;
+
         PRIVATE :
 
             // ----------------------------------------------------------------------
@@ -108,11 +234,238 @@ namespace SpacePosts
              * downlink by
              * sending them to a Svc.Framer component
              *
+             * In delta downlink mode, only the oldest SpacePosts stored after the cursor of the given source are
+             * loaded. The cursor advances to the newest of them once all their frames have been sent.
+             *
+             * DOWNLINK_MESSAGE_COUNT SpacePosts are downlinked at most. If they do not fit into one SpacePost_Batch,
+             * they are loaded page by page as the frames of the session are sent.
+             *
+             * With DOWNLINK_PACING_ENABLED, this only starts a downlink session whose frames are sent by the
+             * pacingTick port. While a session is in progress, new downlinks are rejected and counted as slot overrun.
+             *
+             * @param source The trigger of the downlink
              * @return false iff no downlink was successfully initiated
-             * @return true iff at least one downlink was successfully initiated
+             * @return true iff at least one downlink was successfully initiated (or queued with pacing)
              */
             bool
-            sendMessages();
+            sendMessages(const DownlinkSource source);
+
+        /**
+         * @brief Load a certain number of last quarantined SpacePosts through the loadQuarantine port and initiate
+         * their downlink
+         *
+         * Behaves as sendMessages in the default (non-delta) mode without the frame cache.
+         *
+         * @param numMessages The number of last quarantined SpacePosts to downlink
+         * @return true iff a downlink was successfully initiated (or queued with pacing)
+         */
+        bool sendQuarantine(const U32 numMessages);
+
+        /**
+         * @brief Makes sure that no downlink session is active before a new one is started
+         *
+         * With pacing, an active session is not interrupted and the new downlink is counted as slot overrun.
+         * Without pacing (i.e., pacing was disabled during a paced downlink), the active session is finished first.
+         *
+         * @param pacing DOWNLINK_PACING_ENABLED
+         * @return true iff a new session may be started
+         */
+        bool finishActiveDownlinkSession(const bool pacing);
+
+        /**
+         * @brief Loads the first page of SpacePosts to downlink and starts a downlink session for them
+         *
+         * Reads the frame format parameters (DOWNLINK_PACKED_MODE, DOWNLINK_PACKED_MTU, DOWNLINK_COMPRESSION)
+         * for the whole session. No session must be active.
+         *
+         * @param numMessages The total number of SpacePosts to downlink across all pages
+         * @param includeAll Whether to load the last stored SpacePosts regardless of afterIndex. Otherwise, the
+         * oldest SpacePosts stored after afterIndex are loaded, so that none of them is skipped
+         * @param afterIndex Only load SpacePosts stored at a higher index, unless includeAll
+         * @param useCache Whether to re-send the cached frames if they are valid for this session, and to capture
+         * the frames of this session otherwise. No SpacePost is loaded for a session from the cache.
+         * @param fromQuarantine Whether to load the SpacePosts through loadQuarantine instead of loadMessages.
+         * Must not be combined with useCache
+         * @return true iff the session was started from the cache or at least one SpacePost was loaded
+         */
+        bool startDownlinkSession(const U32 numMessages, const bool includeAll, const U32 afterIndex,
+                                  const bool useCache, const bool fromQuarantine);
+
+        /**
+         * @brief Loads the first page of the active downlink session with the oldest SpacePosts stored after its
+         * afterIndex
+         *
+         * Storage indices are consecutive, so these are usually stored below afterIndex + numMessages + 1. If no
+         * SpacePost is stored there, e.g., because the stores failed or the storage deleted them, the pages are
+         * walked down from the newest SpacePost to find the oldest one first.
+         *
+         * @param numMessages The total number of SpacePosts to downlink across all pages
+         * @param pageSize The maximum number of SpacePosts to load
+         * @return U8 the number of SpacePosts loaded
+         */
+        U8 loadOldestSessionPage(const U32 numMessages, const U8 pageSize);
+
+        /**
+         * @brief The upper bound of a page which holds the numMessages consecutive storage indices from firstIndex
+         *
+         * @param firstIndex The lowest storage index of the page
+         * @param numMessages The number of storage indices of the page
+         * @param beforeIndex Set to the upper bound if there is one
+         * @return false iff the indices wrap around MAX_U32, i.e., the page has no upper bound
+         */
+        static bool pageBeforeIndex(const U32 firstIndex, const U32 numMessages, U32 &beforeIndex);
+
+        /**
+         * @brief Loads a page of SpacePosts of the active downlink session into its batch through loadMessages or,
+         * for a downlink of the quarantine, through loadQuarantine
+         *
+         * Takes the arguments of the SpacePostGetRange port.
+         *
+         * @return U8 the number of SpacePosts loaded
+         */
+        U8 loadSessionPage(const U8 pageSize, const U32 beforeIndex, const bool fromNewest, U32 &newestIndex);
+
+        /**
+         * @brief Loads the next page of SpacePosts of the active downlink session into its batch
+         *
+         * The page continues below the oldest SpacePost of the current page.
+         *
+         * @return true iff at least one SpacePost was loaded
+         */
+        bool loadNextPage();
+
+        /**
+         * @brief Serializes the next frame of the active downlink session and passes it to the downlinkMessage port
+         * or, with DOWNLINK_POOLED_BUFFERS, in a pooled buffer to the sendBuffer port
+         *
+         * Finishes the session after its last frame.
+         *
+         * @return U32 the number of bytes of the frame sent
+         */
+        U32 sendNextFrame();
+
+        /**
+         * @brief Serializes the next frame of the active downlink session into a buffer from allocateBuffer and
+         * passes it to sendBuffer
+         *
+         * The frame is serialized once, straight into the pooled buffer. Ownership of the buffer passes to the
+         * receiver of sendBuffer.
+         *
+         * @param frameSize Set to the number of bytes of the frame sent
+         * @return true iff the frame was sent. False if the ports are not connected or no suitable buffer could be
+         * allocated. Then, the session is unchanged and the frame must be sent another way.
+         */
+        bool sendNextFrameInPooledBuffer(U32 &frameSize);
+
+        /**
+         * @brief Serializes the next frame of the active downlink session into the given buffer and advances the
+         * session
+         *
+         * Copies the frame from m_frameCache if the session is sent from the cache. Otherwise, captures the frame
+         * into m_frameCache if the cache is capturing.
+         *
+         * @param frame The buffer to serialize the frame into. Is reset before serializing.
+         */
+        void serializeNextFrame(Fw::SerializeBufferBase &frame);
+
+        /**
+         * @brief Appends a frame to m_frameCache. Stops capturing if the frame does not fit
+         *
+         * @param frame The serialized frame
+         * @param size The number of bytes of the frame
+         * @param numPosts The number of SpacePosts in the frame
+         */
+        void captureFrame(const U8 *const frame, const U32 size, const U32 numPosts);
+
+        /**
+         * @brief The number of SpacePosts of the active downlink session which have not been sent yet
+         */
+        U32 numPendingMessages() const;
+
+        /**
+         * @brief Ends the active downlink session and reports its packing efficiency via telemetry
+         *
+         * All SpacePosts of the session have been sent at this point, so the delta cursor of a delta downlink
+         * advances to the newest of them.
+         */
+        void finishDownlinkSession();
+
+        /**
+         * @brief Handles a command to downlink the last stored SpacePosts once it has been accepted
+         *
+         * @param opCode The opcode
+         * @param cmdSeq The command sequence number
+         * @param source The trigger of the downlink
+         */
+        void downlinkCmd(const FwOpcodeType opCode, const U32 cmdSeq, const DownlinkSource source);
+
+        /**
+         * @brief Sets the delta downlink cursor of the given source and persists all cursors
+         *
+         * @param source The trigger of the downlink
+         * @param newestIndex The storage index of the newest SpacePost downlinked
+         */
+        void advanceDownlinkCursor(const DownlinkSource source, const U32 newestIndex);
+
+        /**
+         * @brief Restores the delta downlink cursors from TRANSCEIVER_CURSOR_FILE
+         *
+         * A missing file is not an error: no source has a cursor yet. On any other error, a
+         * DOWNLINK_CURSOR_FILE_ERROR event is emitted and all cursors are invalidated.
+         */
+        void restoreDownlinkCursors();
+
+        /**
+         * @brief Writes the delta downlink cursors to TRANSCEIVER_CURSOR_FILE
+         *
+         * Emits a DOWNLINK_CURSOR_FILE_ERROR event if writing fails.
+         */
+        void persistDownlinkCursors();
+
+        /**
+         * @brief Serializes a single SpacePost into the given frame buffer
+         *
+         * This is the frame format required by F-TRA-030: one SpacePost per transmission.
+         *
+         * If compress is true and compressing makes the frame smaller, the frame is a compressed frame (see
+         * TRANSCEIVER_FRAME_MARKER_COMPRESSED). Otherwise, it is the serialized SpacePost.
+         *
+         * @param message The SpacePost to serialize
+         * @param compress Whether to try to compress the SpacePost's text
+         * @param frame The buffer to serialize the frame into. Is reset before serializing.
+         */
+        void serializeSingleFrame(const SpacePost &message, const bool compress, Fw::SerializeBufferBase &frame);
+
+        /**
+         * @brief Serializes as many SpacePosts of a batch as fit into mtu bytes into the given frame buffer
+         *
+         * Starts with the post at index firstMessage. See TRANSCEIVER_FRAME_MARKER_PACKED and
+         * TRANSCEIVER_FRAME_MARKER_PACKED_COMPRESSED for the frame formats. A frame always contains at least one post.
+         *
+         * @param messages The batch of SpacePosts to downlink
+         * @param firstMessage The index of the first post in the batch to put into the frame
+         * @param mtu The maximum number of bytes of the frame
+         * @param compress Whether to put the posts into the frame as compressed records
+         * @param frame The buffer to serialize the frame into. Is reset before serializing.
+         * @return U32 the number of posts put into the frame
+         */
+        U32 serializePackedFrame(const SpacePost_Batch &messages, const U32 firstMessage, const U32 mtu,
+                                 const bool compress, Fw::SerializeBufferBase &frame);
+
+        /**
+         * @brief Appends a SpacePost as compressed record to the given frame buffer
+         *
+         * See TRANSCEIVER_COMPRESSED_RECORD_HEADER_SIZE for the record format. The text is encoded in place in the
+         * frame buffer. It is stored raw if encoding does not make it shorter.
+         *
+         * @param message The SpacePost to append
+         * @param frame The buffer to append the record to
+         * @param bytesSaved Set to the number of bytes saved compared to the serialized SpacePost
+         * @return Fw::FW_SERIALIZE_OK iff the record fit into the frame buffer. Otherwise, the content of the frame
+         * buffer behind its previous length is undefined.
+         */
+        Fw::SerializeStatus serializeCompressedRecord(const SpacePost &message, Fw::SerializeBufferBase &frame,
+                                                      U32 &bytesSaved);
 
         /**
          * @brief Encapsulates what to do when a HAM user's command to downlink the last stored SpacePosts
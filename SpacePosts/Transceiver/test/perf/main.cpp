@@ -0,0 +1,89 @@
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "SpacePosts/Transceiver/SpacePostCodec.hpp"
+#include "SpacePosts/MessageTypes/FppConstantsAc.hpp"
+
+using namespace SpacePosts;
+
+// Number of timed frame encodings per benchmark
+constexpr const U32 ITERATIONS = 100000;
+
+constexpr const U32 MAX_MSGTEXT_LENGTH = SpacePosts::FppConstant_SpacePost_MaxTextLength::SpacePost_MaxTextLength;
+
+// Large enough for the worst case of MAX_MSGTEXT_LENGTH characters with the longest code each
+constexpr const U32 ENCODE_BUFFER_SIZE = (MAX_MSGTEXT_LENGTH * SPACEPOST_CODEBOOK_MAX_CODE_LENGTH + 7) / 8;
+
+/**
+ * @brief Encodes the given text ITERATIONS times, prints the throughput, and checks that decoding restores the text.
+ */
+void benchmarkEncode(const char *const name, const std::string &text)
+{
+    const SpacePostCodec codec{};
+    const U8 *const raw_text = reinterpret_cast<const U8 *>(text.c_str());
+    const U32 length = text.length();
+    U8 encoded[ENCODE_BUFFER_SIZE];
+    U32 encoded_size{0};
+    U32 failures{0};
+
+    const auto start = std::chrono::steady_clock::now();
+    for (U32 i = 0; i < ITERATIONS; i++)
+    {
+        failures += !codec.encode(raw_text, length, encoded, sizeof(encoded), encoded_size);
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    const double total_ns = std::chrono::duration<double, std::nano>(end - start).count();
+    const double ns_per_frame = total_ns / ITERATIONS;
+    const double mb_per_s = (ns_per_frame == 0.0) ? 0.0 : length / ns_per_frame * 1000.0;
+    std::printf("[ BENCHMARK ] encode %-14s %4u -> %4u bytes (%5.1f %%) %10.1f ns/frame %8.1f MB/s\n", name, length,
+                encoded_size, length == 0 ? 100.0 : 100.0 * encoded_size / length, ns_per_frame, mb_per_s);
+    EXPECT_EQ(failures, 0U);
+
+    // Encoded frames must be decodable by the ground
+    std::vector<U8> decoded(length + 1);
+    U32 consumed{0};
+    ASSERT_TRUE(codec.decode(encoded, encoded_size, length, decoded.data(), consumed));
+    EXPECT_EQ(consumed, encoded_size);
+    EXPECT_EQ(std::memcmp(decoded.data(), raw_text, length), 0);
+}
+
+TEST(TransceiverBenchmark, EncodeTypicalChatter)
+{
+    benchmarkEncode("chatter", "Hello everyone from W1AW! Greetings to all students listening today, 73");
+}
+
+TEST(TransceiverBenchmark, EncodeTypicalContact)
+{
+    benchmarkEncode("contact", "CQ CQ DE DL5ABC DL5ABC QTH JO62qm RST 599 TNX QSO 73 K");
+}
+
+TEST(TransceiverBenchmark, EncodeMaxText)
+{
+    std::string text{};
+    while (text.length() < MAX_MSGTEXT_LENGTH)
+    {
+        text += "the satellite station sends best wishes to every ham radio operator ";
+    }
+    text.resize(MAX_MSGTEXT_LENGTH);
+    benchmarkEncode("max text", text);
+}
+
+TEST(TransceiverBenchmark, EncodeBinaryWorstCase)
+{
+    // Bytes outside of printable ASCII take the longest codes. The Transceiver then sends the raw text instead
+    std::string text(MAX_MSGTEXT_LENGTH, static_cast<char>(0xFF));
+    benchmarkEncode("binary", text);
+}
+
+// Execute benchmarks
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
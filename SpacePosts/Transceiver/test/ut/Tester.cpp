@@ -0,0 +1,804 @@
+// ======================================================================
+// \title  Transceiver/test/ut/Tester.cpp
+// \author Marius Baden
+// \brief  cpp file for Transceiver test harness implementation class
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "Tester.hpp"
+#include "config/TransceiverCfg.hpp"
+#include "SpacePosts/MessageTypes/FppConstantsAc.hpp"
+
+#define INSTANCE 0
+// Large enough for the events and telemetry of a paced downlink of several pages
+#define MAX_HISTORY_SIZE 256
+#define CMD_SEQ 42
+
+namespace SpacePosts
+{
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  Tester ::
+      Tester() :
+#if FW_OBJECT_NAMES == 1
+                 TransceiverGTestBase("Tester", MAX_HISTORY_SIZE),
+#else
+                 TransceiverGTestBase(MAX_HISTORY_SIZE),
+#endif
+                 component("Transceiver"),
+                 m_storage(),
+                 m_nextIndex(0),
+                 m_numLoads(0),
+                 m_comFrames(),
+                 m_bufferFrames(),
+                 m_allocatedBufferSize(0),
+                 m_numDeallocations(0),
+                 m_bufferMemory{}
+  {
+    // Every test starts without cursors
+    (void)std::remove(TRANSCEIVER_CURSOR_FILE.c_str());
+    this->connectPorts();
+  }
+
+  Tester ::
+      ~Tester()
+  {
+    (void)std::remove(TRANSCEIVER_CURSOR_FILE.c_str());
+  }
+
+  // ----------------------------------------------------------------------
+  // Downlink Session Tests
+  // ----------------------------------------------------------------------
+
+  void Tester::testPacedSessionSpansTicks(const U32 framesPerTick)
+  {
+    FW_ASSERT(framesPerTick > 0);
+    this->initComponents();
+    const U32 num_messages{10};
+    this->storeModelMessages(num_messages);
+    this->paramSet_DOWNLINK_MESSAGE_COUNT(num_messages, Fw::ParamValid::VALID);
+    this->paramSet_DOWNLINK_PACING_ENABLED(true, Fw::ParamValid::VALID);
+    this->paramSet_DOWNLINK_PACING_BYTES_PER_TICK(0, Fw::ParamValid::VALID);
+    this->paramSet_DOWNLINK_PACING_FRAMES_PER_TICK(framesPerTick, Fw::ParamValid::VALID);
+    this->component.loadParameters();
+    this->clearHistory();
+
+    // The trigger only starts the session
+    this->invoke_to_scheduleDownlink(0, 0);
+    ASSERT_TRUE(this->downlinkedIndices().empty());
+    ASSERT_TLM_DOWNLINK_QUEUE_DEPTH_SIZE(1);
+    ASSERT_TLM_DOWNLINK_QUEUE_DEPTH(0, num_messages);
+
+    U32 num_ticks{0};
+    U32 num_sent{0};
+    while (num_sent < num_messages)
+    {
+      this->clearHistory();
+      this->invoke_to_pacingTick(0, 0);
+      num_ticks++;
+
+      const U32 now_sent = this->downlinkedIndices().size();
+      ASSERT_EQ(now_sent - num_sent, std::min(framesPerTick, num_messages - num_sent))
+          << "Unexpected number of frames sent in tick " << num_ticks;
+      num_sent = now_sent;
+
+      // Only the last tick finishes the session and reports its packing efficiency
+      ASSERT_TLM_DOWNLINK_QUEUE_DEPTH_SIZE(1);
+      ASSERT_TLM_DOWNLINK_QUEUE_DEPTH(0, num_messages - num_sent);
+      ASSERT_TLM_DOWNLINK_POSTS_PER_FRAME_SIZE((num_sent == num_messages) ? 1 : 0);
+    }
+    ASSERT_EQ(num_ticks, (num_messages + framesPerTick - 1) / framesPerTick);
+    ASSERT_TLM_DOWNLINK_POSTS_PER_FRAME(0, 1.0f);
+    ASSERT_EQ(this->downlinkedIndices(), indicesNewestFirst(num_messages - 1, 0));
+
+    // Nothing is left for further ticks
+    this->invoke_to_pacingTick(0, 0);
+    ASSERT_EQ(this->downlinkedIndices().size(), num_messages);
+    ASSERT_EQ(this->m_numLoads, 1U);
+  }
+
+  void Tester::testTriggerRejectedWhileSessionActive()
+  {
+    this->initComponents();
+    const U32 num_messages{10};
+    const U32 frames_per_tick{4};
+    this->storeModelMessages(num_messages);
+    this->paramSet_DOWNLINK_MESSAGE_COUNT(num_messages, Fw::ParamValid::VALID);
+    this->paramSet_DOWNLINK_PACING_ENABLED(true, Fw::ParamValid::VALID);
+    this->paramSet_DOWNLINK_PACING_BYTES_PER_TICK(0, Fw::ParamValid::VALID);
+    this->paramSet_DOWNLINK_PACING_FRAMES_PER_TICK(frames_per_tick, Fw::ParamValid::VALID);
+    this->component.loadParameters();
+
+    this->invoke_to_scheduleDownlink(0, 0);
+    this->invoke_to_pacingTick(0, 0);
+    ASSERT_EQ(this->downlinkedIndices().size(), frames_per_tick);
+
+    // The second trigger is rejected and counted. It neither loads nor sends anything
+    this->downlinkViaGds(Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_TLM_DOWNLINK_SLOT_OVERRUNS_SIZE(1);
+    ASSERT_TLM_DOWNLINK_SLOT_OVERRUNS(0, 1);
+    ASSERT_EQ(this->downlinkedIndices().size(), frames_per_tick);
+    ASSERT_EQ(this->m_numLoads, 1U);
+
+    // The first session continues where it stopped
+    this->invoke_to_pacingTick(0, 0);
+    this->invoke_to_pacingTick(0, 0);
+    ASSERT_EQ(this->downlinkedIndices(), indicesNewestFirst(num_messages - 1, 0));
+  }
+
+  void Tester::testDownlinkPageBoundaries(const U32 numStored, const U32 numMessages)
+  {
+    FW_ASSERT(numMessages > 0);
+    this->initComponents();
+    this->storeModelMessages(numStored);
+    this->paramSet_DOWNLINK_MESSAGE_COUNT(numMessages, Fw::ParamValid::VALID);
+    this->component.loadParameters();
+
+    this->invoke_to_scheduleDownlink(0, 0);
+
+    const U32 num_expected = std::min(numStored, numMessages);
+    if (num_expected == 0)
+    {
+      ASSERT_TRUE(this->downlinkedIndices().empty());
+    }
+    else
+    {
+      ASSERT_EQ(this->downlinkedIndices(), indicesNewestFirst(numStored - 1, numStored - num_expected));
+    }
+
+    // Every page but the last one is full. The last one is short or empty if the storage runs out of SpacePosts
+    const U32 page_size{TRANSCEIVER_DOWNLINK_PAGE_SIZE};
+    const U32 expected_loads = (numStored >= numMessages) ? (numMessages + page_size - 1) / page_size
+                                                          : numStored / page_size + 1;
+    ASSERT_EQ(this->m_numLoads, expected_loads);
+  }
+
+  // ----------------------------------------------------------------------
+  // Delta Downlink Tests
+  // ----------------------------------------------------------------------
+
+  void Tester::testDeltaDownlinkSkipsNothing(const U32 gap)
+  {
+    this->initComponents();
+    const U32 num_messages{5};
+    this->storeModelMessages(2 * num_messages);
+    this->paramSet_DOWNLINK_MESSAGE_COUNT(num_messages, Fw::ParamValid::VALID);
+    this->paramSet_DOWNLINK_DELTA_MODE(true, Fw::ParamValid::VALID);
+    this->component.loadParameters();
+
+    // Without a cursor, the last stored SpacePosts are sent
+    this->downlinkViaGds(Fw::CmdResponse::OK);
+    ASSERT_EQ(this->downlinkedIndices(), indicesNewestFirst(2 * num_messages - 1, num_messages));
+    this->clearFrames();
+
+    // More new SpacePosts than one downlink holds
+    this->m_nextIndex += gap;
+    const U32 first_new_index = this->m_nextIndex;
+    this->storeModelMessages(2 * num_messages + 2);
+
+    // Every downlink continues with the oldest SpacePosts which have not been downlinked yet
+    U32 next_index = first_new_index;
+    while (next_index < this->m_nextIndex)
+    {
+      this->downlinkViaGds(Fw::CmdResponse::OK);
+      const std::vector<U32> indices = this->downlinkedIndices();
+      ASSERT_FALSE(indices.empty());
+      ASSERT_LE(indices.size(), num_messages);
+      ASSERT_EQ(indices, indicesNewestFirst(next_index + indices.size() - 1, next_index))
+          << "Delta downlink did not continue at index " << next_index;
+      next_index += indices.size();
+      this->clearFrames();
+    }
+
+    // Everything has been sent
+    this->downlinkViaGds(Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_TRUE(this->downlinkedIndices().empty());
+  }
+
+  void Tester::testDeltaCursorAdvancesWhenSessionFinishes()
+  {
+    this->initComponents();
+    const U32 num_messages{10};
+    const U32 frames_per_tick{3};
+    this->storeModelMessages(num_messages);
+    this->paramSet_DOWNLINK_MESSAGE_COUNT(num_messages, Fw::ParamValid::VALID);
+    this->paramSet_DOWNLINK_DELTA_MODE(true, Fw::ParamValid::VALID);
+    this->paramSet_DOWNLINK_PACING_ENABLED(true, Fw::ParamValid::VALID);
+    this->paramSet_DOWNLINK_PACING_BYTES_PER_TICK(0, Fw::ParamValid::VALID);
+    this->paramSet_DOWNLINK_PACING_FRAMES_PER_TICK(frames_per_tick, Fw::ParamValid::VALID);
+    this->component.loadParameters();
+
+    U32 cursor{0};
+    this->invoke_to_scheduleDownlink(0, 0);
+    ASSERT_FALSE(readCursor(DownlinkSource::SCHEDULE, cursor)) << "Cursor persisted before any frame was sent";
+
+    while (this->downlinkedIndices().size() < num_messages)
+    {
+      ASSERT_FALSE(readCursor(DownlinkSource::SCHEDULE, cursor))
+          << "Cursor persisted after only " << this->downlinkedIndices().size() << " frames";
+      this->invoke_to_pacingTick(0, 0);
+    }
+    ASSERT_TRUE(readCursor(DownlinkSource::SCHEDULE, cursor));
+    ASSERT_EQ(cursor, num_messages - 1);
+
+    // A delta downlink with a cursor keeps the old one until it has finished as well
+    this->clearFrames();
+    this->storeModelMessages(frames_per_tick + 1);
+    this->invoke_to_scheduleDownlink(0, 0);
+    this->invoke_to_pacingTick(0, 0);
+    ASSERT_TRUE(readCursor(DownlinkSource::SCHEDULE, cursor));
+    ASSERT_EQ(cursor, num_messages - 1);
+
+    this->invoke_to_pacingTick(0, 0);
+    ASSERT_EQ(this->downlinkedIndices(), indicesNewestFirst(this->m_nextIndex - 1, num_messages));
+    ASSERT_TRUE(readCursor(DownlinkSource::SCHEDULE, cursor));
+    ASSERT_EQ(cursor, this->m_nextIndex - 1);
+
+    // Other sources are not affected
+    ASSERT_FALSE(readCursor(DownlinkSource::GDS, cursor));
+  }
+
+  void Tester::testCorruptCursorFile(const std::vector<U8> &content, const CursorFileError::T expectedStage,
+                                     const I32 expectedErrorCode)
+  {
+    writeCursorFile(content);
+    this->initComponents();
+
+    ASSERT_EVENTS_SIZE(1);
+    ASSERT_EVENTS_DOWNLINK_CURSOR_FILE_ERROR_SIZE(1);
+    ASSERT_EVENTS_DOWNLINK_CURSOR_FILE_ERROR(0, expectedStage, expectedErrorCode);
+
+    // No cursor was restored, so the first delta downlink sends the last stored SpacePosts
+    const U32 num_messages{5};
+    this->storeModelMessages(2 * num_messages);
+    this->paramSet_DOWNLINK_MESSAGE_COUNT(num_messages, Fw::ParamValid::VALID);
+    this->paramSet_DOWNLINK_DELTA_MODE(true, Fw::ParamValid::VALID);
+    this->component.loadParameters();
+
+    this->downlinkViaGds(Fw::CmdResponse::OK);
+    ASSERT_EQ(this->downlinkedIndices(), indicesNewestFirst(2 * num_messages - 1, num_messages));
+
+    // The corrupt file is replaced
+    U32 cursor{0};
+    ASSERT_TRUE(readCursor(DownlinkSource::GDS, cursor));
+    ASSERT_EQ(cursor, 2 * num_messages - 1);
+  }
+
+  // ----------------------------------------------------------------------
+  // Pooled Buffer Tests
+  // ----------------------------------------------------------------------
+
+  void Tester::testPooledBufferAllocationFails(const U32 allocatedSize)
+  {
+    this->initComponents();
+    const U32 num_messages{3};
+    this->storeModelMessages(num_messages);
+    this->paramSet_DOWNLINK_MESSAGE_COUNT(num_messages, Fw::ParamValid::VALID);
+    this->paramSet_DOWNLINK_POOLED_BUFFERS(true, Fw::ParamValid::VALID);
+    this->component.loadParameters();
+    this->m_allocatedBufferSize = allocatedSize;
+    this->clearHistory();
+
+    this->invoke_to_scheduleDownlink(0, 0);
+
+    // Every frame falls back to downlinkMessage
+    ASSERT_TRUE(this->m_bufferFrames.empty());
+    ASSERT_EQ(this->m_comFrames.size(), num_messages);
+    ASSERT_EQ(this->downlinkedIndices(), indicesNewestFirst(num_messages - 1, 0));
+
+    const U32 requested_size = sizeof(U8) + SpacePost::SERIALIZED_SIZE;
+    ASSERT_EVENTS_DOWNLINK_BUFFER_ALLOCATION_FAILED_SIZE(num_messages);
+    for (U32 i = 0; i < num_messages; i++)
+    {
+      ASSERT_EVENTS_DOWNLINK_BUFFER_ALLOCATION_FAILED(i, requested_size, allocatedSize);
+    }
+    ASSERT_TLM_DOWNLINK_BUFFER_ALLOC_FAILURES_SIZE(num_messages);
+    ASSERT_TLM_DOWNLINK_BUFFER_ALLOC_FAILURES(num_messages - 1, num_messages);
+    ASSERT_TLM_DOWNLINK_BUFFERS_ALLOCATED_SIZE(0);
+
+    // Only a buffer with data goes back to the pool
+    ASSERT_EQ(this->m_numDeallocations, (allocatedSize > 0) ? num_messages : 0);
+  }
+
+  void Tester::testPooledBufferFramesEqualComBufferFrames(const bool packedMode, const bool compress)
+  {
+    this->initComponents();
+    const U32 num_messages{12};
+    this->storeModelMessages(num_messages);
+    this->paramSet_DOWNLINK_MESSAGE_COUNT(num_messages, Fw::ParamValid::VALID);
+    this->paramSet_DOWNLINK_PACKED_MODE(packedMode, Fw::ParamValid::VALID);
+    this->paramSet_DOWNLINK_COMPRESSION(compress, Fw::ParamValid::VALID);
+    this->component.loadParameters();
+
+    this->invoke_to_scheduleDownlink(0, 0);
+    const std::vector<std::vector<U8>> com_frames = this->m_comFrames;
+    ASSERT_FALSE(com_frames.empty());
+    ASSERT_TRUE(this->m_bufferFrames.empty());
+    this->clearFrames();
+
+    this->paramSet_DOWNLINK_POOLED_BUFFERS(true, Fw::ParamValid::VALID);
+    this->component.loadParameters();
+    this->m_allocatedBufferSize = sizeof(this->m_bufferMemory);
+    this->clearHistory();
+
+    this->invoke_to_scheduleDownlink(0, 0);
+    ASSERT_TRUE(this->m_comFrames.empty());
+    ASSERT_EQ(this->m_bufferFrames, com_frames);
+    ASSERT_TLM_DOWNLINK_BUFFERS_ALLOCATED_SIZE(com_frames.size());
+    ASSERT_EVENTS_DOWNLINK_BUFFER_ALLOCATION_FAILED_SIZE(0);
+    ASSERT_EQ(this->m_numDeallocations, 0U);
+  }
+
+  // ----------------------------------------------------------------------
+  // Frame Cache Tests
+  // ----------------------------------------------------------------------
+
+  void Tester::testFrameCacheInvalidatedByStore(const bool storeBatch)
+  {
+    this->initComponents();
+    const U32 num_messages{5};
+    this->storeModelMessages(num_messages);
+    this->paramSet_DOWNLINK_MESSAGE_COUNT(num_messages, Fw::ParamValid::VALID);
+    this->paramSet_DOWNLINK_FRAME_CACHE(true, Fw::ParamValid::VALID);
+    this->component.loadParameters();
+
+    this->downlinkViaGds(Fw::CmdResponse::OK);
+    const std::vector<std::vector<U8>> first_frames = this->m_comFrames;
+    ASSERT_EQ(this->downlinkedIndices(), indicesNewestFirst(num_messages - 1, 0));
+    ASSERT_EQ(this->m_numLoads, 1U);
+    this->clearFrames();
+
+    // Nothing was stored: the same frames are sent from the cache
+    this->downlinkViaGds(Fw::CmdResponse::OK);
+    ASSERT_EQ(this->m_comFrames, first_frames);
+    ASSERT_EQ(this->m_numLoads, 1U);
+    ASSERT_TLM_DOWNLINK_CACHE_HITS_SIZE(1);
+    ASSERT_TLM_DOWNLINK_CACHE_HITS(0, 1);
+    this->clearFrames();
+
+    // Store a new SpacePost through the component
+    const std::string text{"post " + std::to_string(this->m_nextIndex)};
+    this->clearHistory();
+    if (storeBatch)
+    {
+      SpacePost_Array messages{};
+      messages[0] = SpacePost{text.c_str()};
+      const SpacePost_Batch batch{1, messages};
+      this->sendCmd_STORE_MESSAGES(INSTANCE, CMD_SEQ, batch);
+      ASSERT_CMD_RESPONSE(0, Transceiver::OPCODE_STORE_MESSAGES, CMD_SEQ, Fw::CmdResponse::OK);
+    }
+    else
+    {
+      this->sendCmd_STORE_MESSAGE(INSTANCE, CMD_SEQ, SpacePost{text.c_str()});
+      ASSERT_CMD_RESPONSE(0, Transceiver::OPCODE_STORE_MESSAGE, CMD_SEQ, Fw::CmdResponse::OK);
+    }
+
+    // The cache is outdated: the SpacePosts are loaded again and include the new one
+    this->downlinkViaGds(Fw::CmdResponse::OK);
+    ASSERT_EQ(this->downlinkedIndices(), indicesNewestFirst(num_messages, 1));
+    ASSERT_EQ(this->m_numLoads, 2U);
+    ASSERT_TLM_DOWNLINK_CACHE_HITS_SIZE(0);
+  }
+
+  void Tester::testFrameCacheInvalidatedByOtherComponent()
+  {
+    this->initComponents();
+    const U32 num_messages{5};
+    this->storeModelMessages(num_messages);
+    this->paramSet_DOWNLINK_MESSAGE_COUNT(num_messages, Fw::ParamValid::VALID);
+    this->paramSet_DOWNLINK_FRAME_CACHE(true, Fw::ParamValid::VALID);
+    this->component.loadParameters();
+
+    this->downlinkViaGds(Fw::CmdResponse::OK);
+    this->downlinkViaGds(Fw::CmdResponse::OK);
+    ASSERT_EQ(this->m_numLoads, 1U);
+    this->clearFrames();
+
+    // Another component, e.g., the Moderator, stores a SpacePost in the same storage
+    this->storeModelMessages(1);
+
+    // The cache is outdated: the SpacePosts are loaded again and include the new one
+    this->downlinkViaGds(Fw::CmdResponse::OK);
+    ASSERT_EQ(this->downlinkedIndices(), indicesNewestFirst(num_messages, 1));
+    ASSERT_EQ(this->m_numLoads, 2U);
+    ASSERT_TLM_DOWNLINK_CACHE_HITS_SIZE(0);
+    this->clearFrames();
+
+    // The new frames are cached again
+    this->downlinkViaGds(Fw::CmdResponse::OK);
+    ASSERT_EQ(this->downlinkedIndices(), indicesNewestFirst(num_messages, 1));
+    ASSERT_EQ(this->m_numLoads, 2U);
+    ASSERT_TLM_DOWNLINK_CACHE_HITS_SIZE(1);
+    ASSERT_TLM_DOWNLINK_CACHE_HITS(0, 2);
+  }
+
+  // ----------------------------------------------------------------------
+  // Store Tests
+  // ----------------------------------------------------------------------
+
+  void Tester::testStoreMessagesValidMessageCount(const U8 numValidMessages)
+  {
+    this->initComponents();
+
+    SpacePost_Array messages{};
+    for (U32 i = 0; i < SpacePost_Batch_Size; i++)
+    {
+      messages[i] = SpacePost{("post " + std::to_string(i)).c_str()};
+    }
+    const SpacePost_Batch batch{numValidMessages, messages};
+
+    this->clearHistory();
+    this->sendCmd_STORE_MESSAGES(INSTANCE, CMD_SEQ, batch);
+
+    const bool valid = numValidMessages <= SpacePost_Batch_Size;
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, Transceiver::OPCODE_STORE_MESSAGES, CMD_SEQ,
+                        valid ? Fw::CmdResponse::OK : Fw::CmdResponse::VALIDATION_ERROR);
+    ASSERT_EQ(this->m_storage.size(), valid ? numValidMessages : 0U);
+    ASSERT_EVENTS_STORE_MESSAGES_INCOMPLETE_SIZE(0);
+  }
+
+  // ----------------------------------------------------------------------
+  // Handlers for typed from ports
+  // ----------------------------------------------------------------------
+
+  SpacePosts::MessageStorageStatus Tester ::
+      from_storeMessage_handler(
+          const NATIVE_INT_TYPE portNum,
+          const SpacePosts::SpacePost &data)
+  {
+    this->m_storage[this->m_nextIndex++] = data.getmessage_content().toChar();
+    return SpacePosts::MessageStorageStatus::OK;
+  }
+
+  U8 Tester ::
+      from_storeMessages_handler(
+          const NATIVE_INT_TYPE portNum,
+          const SpacePosts::SpacePost_Batch &data,
+          SpacePosts::MessageStorageStatus_Batch &statuses)
+  {
+    const U8 num_messages = std::min<U8>(data.getnumValidMessages(), SpacePost_Batch_Size);
+    for (U32 i = 0; i < SpacePost_Batch_Size; i++)
+    {
+      statuses[i] = (i < num_messages) ? SpacePosts::MessageStorageStatus::OK
+                                       : SpacePosts::MessageStorageStatus::ERROR;
+    }
+    for (U32 i = 0; i < num_messages; i++)
+    {
+      this->m_storage[this->m_nextIndex++] = data.getmessages()[i].getmessage_content().toChar();
+    }
+    return num_messages;
+  }
+
+  U8 Tester ::
+      from_loadMessages_handler(
+          const NATIVE_INT_TYPE portNum,
+          U8 numberOfMessages,
+          U32 afterIndex,
+          bool includeAll,
+          U32 beforeIndex,
+          bool fromNewest,
+          SpacePosts::SpacePost_Batch &lastMessages,
+          U32 &newestIndex,
+          U32 &oldestIndex)
+  {
+    this->m_numLoads++;
+
+    // Same semantics as the MessageStorage: the newest SpacePosts within the bounds, newest first
+    SpacePost_Array messages{};
+    U8 num_loaded{0};
+    for (auto it = this->m_storage.rbegin();
+         it != this->m_storage.rend() && num_loaded < numberOfMessages && num_loaded < SpacePost_Batch_Size; ++it)
+    {
+      const U32 index = it->first;
+      if (!fromNewest && index >= beforeIndex)
+      {
+        continue;
+      }
+      if (!includeAll && index <= afterIndex)
+      {
+        break;
+      }
+      messages[num_loaded] = SpacePost{it->second.c_str()};
+      if (num_loaded == 0)
+      {
+        newestIndex = index;
+      }
+      oldestIndex = index;
+      num_loaded++;
+    }
+    lastMessages.set(num_loaded, messages);
+    return num_loaded;
+  }
+
+  U8 Tester ::
+      from_loadQuarantine_handler(
+          const NATIVE_INT_TYPE portNum,
+          U8 numberOfMessages,
+          U32 afterIndex,
+          bool includeAll,
+          U32 beforeIndex,
+          bool fromNewest,
+          SpacePosts::SpacePost_Batch &lastMessages,
+          U32 &newestIndex,
+          U32 &oldestIndex)
+  {
+    // The quarantine is empty in these tests
+    lastMessages.setnumValidMessages(0);
+    return 0;
+  }
+
+  U32 Tester ::
+      from_getStoreGeneration_handler(
+          const NATIVE_INT_TYPE portNum)
+  {
+    // The storage model never deletes SpacePosts, so its next index changes with every stored one
+    return this->m_nextIndex;
+  }
+
+  void Tester ::
+      from_downlinkMessage_handler(
+          const NATIVE_INT_TYPE portNum,
+          Fw::ComBuffer &data,
+          U32 context)
+  {
+    const U8 *const frame = data.getBuffAddr();
+    this->m_comFrames.emplace_back(frame, frame + data.getBuffLength());
+  }
+
+  Fw::Buffer Tester ::
+      from_allocateBuffer_handler(
+          const NATIVE_INT_TYPE portNum,
+          U32 size)
+  {
+    if (this->m_allocatedBufferSize == 0)
+    {
+      return Fw::Buffer();
+    }
+    FW_ASSERT(this->m_allocatedBufferSize <= sizeof(this->m_bufferMemory), this->m_allocatedBufferSize);
+    return Fw::Buffer(this->m_bufferMemory, this->m_allocatedBufferSize);
+  }
+
+  void Tester ::
+      from_sendBuffer_handler(
+          const NATIVE_INT_TYPE portNum,
+          Fw::Buffer &fwBuffer)
+  {
+    const U8 *const frame = fwBuffer.getData();
+    this->m_bufferFrames.emplace_back(frame, frame + fwBuffer.getSize());
+  }
+
+  void Tester ::
+      from_deallocateBuffer_handler(
+          const NATIVE_INT_TYPE portNum,
+          Fw::Buffer &fwBuffer)
+  {
+    this->m_numDeallocations++;
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper Methods
+  // ----------------------------------------------------------------------
+
+  void Tester::storeModelMessages(const U32 numMessages)
+  {
+    for (U32 i = 0; i < numMessages; i++)
+    {
+      this->m_storage[this->m_nextIndex] = "post " + std::to_string(this->m_nextIndex);
+      this->m_nextIndex++;
+    }
+  }
+
+  std::vector<U32> Tester::downlinkedIndices() const
+  {
+    std::vector<std::vector<U8>> frames = this->m_comFrames;
+    frames.insert(frames.end(), this->m_bufferFrames.begin(), this->m_bufferFrames.end());
+
+    // A frame of the one-post-per-frame mode is a serialized SpacePost: U16 length + text
+    std::vector<U32> indices{};
+    for (const std::vector<U8> &frame : frames)
+    {
+      EXPECT_GE(frame.size(), 2U);
+      const U32 length = (static_cast<U32>(frame[0]) << 8) | frame[1];
+      EXPECT_EQ(frame.size(), 2U + length);
+      const std::string text{frame.begin() + 2, frame.end()};
+      EXPECT_EQ(text.rfind("post ", 0), 0U) << "Unexpected frame content: " << text;
+      indices.push_back(static_cast<U32>(std::stoul(text.substr(5))));
+    }
+    return indices;
+  }
+
+  std::vector<U32> Tester::indicesNewestFirst(const U32 newestIndex, const U32 oldestIndex)
+  {
+    std::vector<U32> indices{};
+    for (U32 index = newestIndex + 1; index > oldestIndex; index--)
+    {
+      indices.push_back(index - 1);
+    }
+    return indices;
+  }
+
+  bool Tester::readCursor(const DownlinkSource::T source, U32 &index)
+  {
+    std::ifstream file{TRANSCEIVER_CURSOR_FILE, std::ios::binary};
+    if (!file)
+    {
+      return false;
+    }
+    const std::vector<U8> content{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+    // Delimiter | per DownlinkSource: U8 valid + U32 index (big endian)
+    const U32 offset = 1 + static_cast<U32>(source) * (sizeof(U8) + sizeof(U32));
+    EXPECT_EQ(content.size(), 1 + DownlinkSource::NUM_CONSTANTS * (sizeof(U8) + sizeof(U32)));
+    if (content.size() < offset + sizeof(U8) + sizeof(U32))
+    {
+      return false;
+    }
+    EXPECT_EQ(content[0], TRANSCEIVER_CURSOR_FILE_DELIMITER);
+    if (content[offset] == 0)
+    {
+      return false;
+    }
+    index = (static_cast<U32>(content[offset + 1]) << 24) | (static_cast<U32>(content[offset + 2]) << 16) |
+            (static_cast<U32>(content[offset + 3]) << 8) | static_cast<U32>(content[offset + 4]);
+    return true;
+  }
+
+  void Tester::writeCursorFile(const std::vector<U8> &content)
+  {
+    std::ofstream file{TRANSCEIVER_CURSOR_FILE, std::ios::binary | std::ios::trunc};
+    file.write(reinterpret_cast<const char *>(content.data()), content.size());
+    ASSERT_TRUE(file.good()) << "Failed to write the cursor file " << TRANSCEIVER_CURSOR_FILE;
+  }
+
+  void Tester::downlinkViaGds(const Fw::CmdResponse::T expectedResponse)
+  {
+    this->clearHistory();
+    this->sendCmd_DOWNLINK_LAST_MESSAGES_GDS(INSTANCE, CMD_SEQ);
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, Transceiver::OPCODE_DOWNLINK_LAST_MESSAGES_GDS, CMD_SEQ, expectedResponse);
+  }
+
+  void Tester::clearFrames()
+  {
+    this->m_comFrames.clear();
+    this->m_bufferFrames.clear();
+  }
+
+  void Tester ::
+      initComponents()
+  {
+    this->clearHistory();
+    this->init();
+    this->component.init(
+        INSTANCE);
+
+    // Parameters which are not set by a test take their defaults
+    this->component.loadParameters();
+  }
+
+  // ----------------------------------------------------------------------
+  // F' Tester Implementations
+  // ----------------------------------------------------------------------
+
+  void Tester ::
+      connectPorts()
+  {
+
+    // scheduleDownlink
+    this->connect_to_scheduleDownlink(
+        0,
+        this->component.get_scheduleDownlink_InputPort(0));
+
+    // pacingTick
+    this->connect_to_pacingTick(
+        0,
+        this->component.get_pacingTick_InputPort(0));
+
+    // cmdIn
+    this->connect_to_cmdIn(
+        0,
+        this->component.get_cmdIn_InputPort(0));
+
+    // storeMessage
+    this->component.set_storeMessage_OutputPort(
+        0,
+        this->get_from_storeMessage(0));
+
+    // storeMessages
+    this->component.set_storeMessages_OutputPort(
+        0,
+        this->get_from_storeMessages(0));
+
+    // loadMessages
+    this->component.set_loadMessages_OutputPort(
+        0,
+        this->get_from_loadMessages(0));
+
+    // loadQuarantine
+    this->component.set_loadQuarantine_OutputPort(
+        0,
+        this->get_from_loadQuarantine(0));
+
+    // getStoreGeneration
+    this->component.set_getStoreGeneration_OutputPort(
+        0,
+        this->get_from_getStoreGeneration(0));
+
+    // downlinkMessage
+    this->component.set_downlinkMessage_OutputPort(
+        0,
+        this->get_from_downlinkMessage(0));
+
+    // allocateBuffer
+    this->component.set_allocateBuffer_OutputPort(
+        0,
+        this->get_from_allocateBuffer(0));
+
+    // sendBuffer
+    this->component.set_sendBuffer_OutputPort(
+        0,
+        this->get_from_sendBuffer(0));
+
+    // deallocateBuffer
+    this->component.set_deallocateBuffer_OutputPort(
+        0,
+        this->get_from_deallocateBuffer(0));
+
+    // cmdRegOut
+    this->component.set_cmdRegOut_OutputPort(
+        0,
+        this->get_from_cmdRegOut(0));
+
+    // cmdResponseOut
+    this->component.set_cmdResponseOut_OutputPort(
+        0,
+        this->get_from_cmdResponseOut(0));
+
+    // eventOut
+    this->component.set_eventOut_OutputPort(
+        0,
+        this->get_from_eventOut(0));
+
+    // tlmOut
+    this->component.set_tlmOut_OutputPort(
+        0,
+        this->get_from_tlmOut(0));
+
+    // prmGetOut
+    this->component.set_prmGetOut_OutputPort(
+        0,
+        this->get_from_prmGetOut(0));
+
+    // prmSetOut
+    this->component.set_prmSetOut_OutputPort(
+        0,
+        this->get_from_prmSetOut(0));
+
+    // textEventOut
+    this->component.set_textEventOut_OutputPort(
+        0,
+        this->get_from_textEventOut(0));
+
+    // timeGetOut
+    this->component.set_timeGetOut_OutputPort(
+        0,
+        this->get_from_timeGetOut(0));
+  }
+
+} // end namespace SpacePosts
@@ -0,0 +1,403 @@
+// ======================================================================
+// \title  Transceiver/test/ut/Tester.hpp
+// \author Marius Baden
+// \brief  hpp file for Transceiver test harness implementation class
+//
+// \copyright
+// Copyright 2009-2015, by the California Institute of Technology.
+// ALL RIGHTS RESERVED.  United States Government Sponsorship
+// acknowledged.
+//
+// ======================================================================
+
+#ifndef TESTER_HPP
+#define TESTER_HPP
+
+// Large enough for a frame of any format with the default DOWNLINK_PACKED_MTU
+#define POOLED_BUFFER_MEMORY_SIZE 1024
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "GTestBase.hpp"
+#include "SpacePosts/Transceiver/Transceiver.hpp"
+
+namespace SpacePosts
+{
+
+  class Tester : public TransceiverGTestBase
+  {
+
+  private:
+    /**
+     * The component under test.
+     */
+    Transceiver component;
+
+    /**
+     * Model of the MessageStorage connected to loadMessages and the store ports: storage index -> text.
+     *
+     * The texts are "post <index>", so the downlinked frames tell which SpacePosts were sent.
+     */
+    std::map<U32, std::string> m_storage;
+
+    /**
+     * The index at which the storage model stores the next SpacePost.
+     */
+    U32 m_nextIndex;
+
+    /**
+     * The number of calls of the loadMessages port.
+     */
+    U32 m_numLoads;
+
+    /**
+     * The frames received from the downlinkMessage port, in the order they were sent.
+     */
+    std::vector<std::vector<U8>> m_comFrames;
+
+    /**
+     * The frames received from the sendBuffer port, in the order they were sent.
+     */
+    std::vector<std::vector<U8>> m_bufferFrames;
+
+    /**
+     * The number of bytes of the buffer which allocateBuffer returns. 0 returns a buffer without data.
+     */
+    U32 m_allocatedBufferSize;
+
+    /**
+     * The number of buffers returned to the pool through the deallocateBuffer port.
+     */
+    U32 m_numDeallocations;
+
+    /**
+     * The memory of the buffer which allocateBuffer returns. sendBuffer consumes it right away, so it can be reused.
+     */
+    U8 m_bufferMemory[POOLED_BUFFER_MEMORY_SIZE];
+
+  public:
+    // ----------------------------------------------------------------------
+    // Construction and destruction
+    // ----------------------------------------------------------------------
+
+    /**
+     * @brief Construct a new Tester object with an empty storage model and without a cursor file.
+     */
+    Tester();
+
+    /**
+     * @brief Destroy the Tester object and remove the cursor file it may have caused.
+     */
+    ~Tester();
+
+  public:
+    // ----------------------------------------------------------------------
+    // Tests
+    // ----------------------------------------------------------------------
+
+    /*
+        UT-TRA-010
+        Test sending the frames of a paced downlink session across pacingTick calls
+    */
+
+    /**
+     * @brief Triggers a paced downlink of more SpacePosts than may be sent per tick and checks that the frames are
+     * sent across successive pacingTick calls.
+     *
+     * Nothing is sent by the trigger itself. Every tick sends at most framesPerTick frames and reports the remaining
+     * SpacePosts via the DOWNLINK_QUEUE_DEPTH telemetry. The packing efficiency is only reported once the session
+     * has finished. All SpacePosts are sent exactly once, newest first.
+     *
+     * @param framesPerTick The DOWNLINK_PACING_FRAMES_PER_TICK parameter
+     */
+    void testPacedSessionSpansTicks(const U32 framesPerTick);
+
+    /*
+        UT-TRA-020
+        Test that a downlink trigger is rejected while a paced downlink session is active
+    */
+
+    /**
+     * @brief Triggers a paced downlink, sends part of its frames, triggers another downlink via the
+     * DOWNLINK_LAST_MESSAGES_GDS command, and checks that it is rejected without interrupting the session.
+     *
+     * The command fails and the rejected trigger is counted via the DOWNLINK_SLOT_OVERRUNS telemetry. The remaining
+     * frames of the first session are still sent by later ticks, each SpacePost exactly once.
+     */
+    void testTriggerRejectedWhileSessionActive();
+
+    /*
+        UT-TRA-030
+        Test paging through the storage based on the number of SpacePosts to downlink and the number stored
+    */
+
+    /**
+     * @brief Stores numStored SpacePosts in the storage model, downlinks with DOWNLINK_MESSAGE_COUNT set to
+     * numMessages, and checks that exactly the newest min(numStored, numMessages) SpacePosts are sent once each,
+     * newest first, across page boundaries.
+     *
+     * @param numStored The number of SpacePosts in the storage model
+     * @param numMessages The DOWNLINK_MESSAGE_COUNT parameter
+     */
+    void testDownlinkPageBoundaries(const U32 numStored, const U32 numMessages);
+
+    /*
+        UT-TRA-040
+        Test which SpacePosts delta downlinks send and when they advance their cursor
+    */
+
+    /**
+     * @brief Downlinks in delta mode while more SpacePosts are stored than a downlink holds, and checks that no
+     * SpacePost is skipped.
+     *
+     * The first delta downlink has no cursor and sends the last stored SpacePosts. Every following one sends the
+     * oldest SpacePosts after the previous one until no new SpacePost is left, which fails the command.
+     *
+     * @param gap The number of storage indices without a SpacePost (e.g., failed stores) between the SpacePosts of
+     * the first downlink and the following ones
+     */
+    void testDeltaDownlinkSkipsNothing(const U32 gap);
+
+    /**
+     * @brief Triggers a paced delta downlink and checks that the cursor file is only updated once all frames of the
+     * session have been sent.
+     */
+    void testDeltaCursorAdvancesWhenSessionFinishes();
+
+    /*
+        UT-TRA-050
+        Test restoring the delta downlink cursors from a corrupt cursor file
+    */
+
+    /**
+     * @brief Writes the given content to the cursor file, initializes the component, and checks that it reports the
+     * expected stage via the DOWNLINK_CURSOR_FILE_ERROR event and falls back to a full delta downlink.
+     *
+     * @param content The content of the cursor file
+     * @param expectedStage The stage reported by the DOWNLINK_CURSOR_FILE_ERROR event
+     * @param expectedErrorCode The error code reported by the DOWNLINK_CURSOR_FILE_ERROR event
+     */
+    void testCorruptCursorFile(const std::vector<U8> &content, const CursorFileError::T expectedStage,
+                               const I32 expectedErrorCode);
+
+    /*
+        UT-TRA-060
+        Test downlinking frames in pooled buffers and the fallback to Fw::ComBuffer frames if no suitable pooled
+        buffer can be allocated
+    */
+
+    /**
+     * @brief Enables DOWNLINK_POOLED_BUFFERS, makes allocateBuffer return a buffer of allocatedSize bytes, and checks
+     * that every frame is sent through downlinkMessage instead of sendBuffer.
+     *
+     * Every failed allocation is reported via the DOWNLINK_BUFFER_ALLOCATION_FAILED event and the
+     * DOWNLINK_BUFFER_ALLOC_FAILURES telemetry. A buffer which is too small is returned through deallocateBuffer.
+     *
+     * @param allocatedSize The size of the allocated buffer. 0 for an allocation without data
+     */
+    void testPooledBufferAllocationFails(const U32 allocatedSize);
+
+    /**
+     * @brief Downlinks the same SpacePosts once through downlinkMessage and once in pooled buffers through sendBuffer,
+     * and checks that both paths produce identical frame bytes.
+     *
+     * The pooled buffers are large enough, so no frame falls back to downlinkMessage.
+     *
+     * @param packedMode The DOWNLINK_PACKED_MODE parameter
+     * @param compress The DOWNLINK_COMPRESSION parameter
+     */
+    void testPooledBufferFramesEqualComBufferFrames(const bool packedMode, const bool compress);
+
+    /*
+        UT-TRA-070
+        Test that storing a SpacePost invalidates the frame cache, no matter which component stores it
+    */
+
+    /**
+     * @brief Enables DOWNLINK_FRAME_CACHE, downlinks twice, stores a SpacePost, and downlinks again.
+     *
+     * The second downlink is sent from the cache without loading from the storage. The third one loads again and
+     * contains the new SpacePost.
+     *
+     * @param storeBatch Whether to store the new SpacePost with STORE_MESSAGES instead of STORE_MESSAGE
+     */
+    void testFrameCacheInvalidatedByStore(const bool storeBatch);
+
+    /**
+     * @brief Enables DOWNLINK_FRAME_CACHE, downlinks twice, stores a SpacePost in the storage model without the
+     * component, and downlinks twice again.
+     *
+     * The store changes the store generation of the storage, so the third downlink loads again and contains the new
+     * SpacePost. The fourth one is sent from the cache again.
+     */
+    void testFrameCacheInvalidatedByOtherComponent();
+
+    /*
+        UT-TRA-080
+        Test validating the number of SpacePosts of a STORE_MESSAGES command
+    */
+
+    /**
+     * @brief Sends a STORE_MESSAGES command whose batch claims numValidMessages SpacePosts and checks that it is
+     * only passed to the storage if numValidMessages fits into a SpacePost_Batch.
+     *
+     * @param numValidMessages The numValidMessages of the uplinked batch
+     */
+    void testStoreMessagesValidMessageCount(const U8 numValidMessages);
+
+  private:
+    // ----------------------------------------------------------------------
+    // Handlers for typed from ports
+    // ----------------------------------------------------------------------
+
+    //! Handler for from_storeMessage
+    //!
+    SpacePosts::MessageStorageStatus from_storeMessage_handler(
+        const NATIVE_INT_TYPE portNum, /*!< The port number*/
+        const SpacePosts::SpacePost &data /*!< the SpacePost to store*/
+        ) override;
+
+    //! Handler for from_storeMessages
+    //!
+    U8 from_storeMessages_handler(
+        const NATIVE_INT_TYPE portNum, /*!< The port number*/
+        const SpacePosts::SpacePost_Batch &data, /*!< the SpacePosts to store*/
+        SpacePosts::MessageStorageStatus_Batch &statuses /*!< whether each SpacePost was stored*/
+        ) override;
+
+    //! Handler for from_loadMessages
+    //!
+    U8 from_loadMessages_handler(
+        const NATIVE_INT_TYPE portNum, /*!< The port number*/
+        U8 numberOfMessages, /*!< The maximum number of messages to load*/
+        U32 afterIndex, /*!< The lower index bound*/
+        bool includeAll, /*!< Whether there is no lower index bound*/
+        U32 beforeIndex, /*!< The upper index bound*/
+        bool fromNewest, /*!< Whether there is no upper index bound*/
+        SpacePosts::SpacePost_Batch &lastMessages, /*!< The loaded messages, newest first*/
+        U32 &newestIndex, /*!< The storage index of the newest loaded message*/
+        U32 &oldestIndex /*!< The storage index of the oldest loaded message*/
+        ) override;
+
+    //! Handler for from_loadQuarantine
+    //!
+    U8 from_loadQuarantine_handler(
+        const NATIVE_INT_TYPE portNum, /*!< The port number*/
+        U8 numberOfMessages, /*!< The maximum number of messages to load*/
+        U32 afterIndex, /*!< The lower index bound*/
+        bool includeAll, /*!< Whether there is no lower index bound*/
+        U32 beforeIndex, /*!< The upper index bound*/
+        bool fromNewest, /*!< Whether there is no upper index bound*/
+        SpacePosts::SpacePost_Batch &lastMessages, /*!< The loaded messages, newest first*/
+        U32 &newestIndex, /*!< The storage index of the newest loaded message*/
+        U32 &oldestIndex /*!< The storage index of the oldest loaded message*/
+        ) override;
+
+    //! Handler for from_getStoreGeneration
+    //!
+    U32 from_getStoreGeneration_handler(
+        const NATIVE_INT_TYPE portNum /*!< The port number*/
+        ) override;
+
+    //! Handler for from_downlinkMessage
+    //!
+    void from_downlinkMessage_handler(
+        const NATIVE_INT_TYPE portNum, /*!< The port number*/
+        Fw::ComBuffer &data, /*!< Buffer containing packet data*/
+        U32 context /*!< Call context value; meaning chosen by user*/
+        ) override;
+
+    //! Handler for from_allocateBuffer
+    //!
+    Fw::Buffer from_allocateBuffer_handler(
+        const NATIVE_INT_TYPE portNum, /*!< The port number*/
+        U32 size /*!< The requested size*/
+        ) override;
+
+    //! Handler for from_sendBuffer
+    //!
+    void from_sendBuffer_handler(
+        const NATIVE_INT_TYPE portNum, /*!< The port number*/
+        Fw::Buffer &fwBuffer /*!< The buffer*/
+        ) override;
+
+    //! Handler for from_deallocateBuffer
+    //!
+    void from_deallocateBuffer_handler(
+        const NATIVE_INT_TYPE portNum, /*!< The port number*/
+        Fw::Buffer &fwBuffer /*!< The buffer*/
+        ) override;
+
+  private:
+    // ----------------------------------------------------------------------
+    // Helper Methods
+    // ----------------------------------------------------------------------
+
+    /**
+     * @brief Stores numMessages SpacePosts in the storage model at consecutive indices
+     *
+     * @param numMessages The number of SpacePosts to store
+     */
+    void storeModelMessages(const U32 numMessages);
+
+    /**
+     * @brief The storage indices of the SpacePosts in the frames received from downlinkMessage and sendBuffer
+     *
+     * Expects frames in the default one-post-per-frame mode without compression.
+     *
+     * @return std::vector<U32> The indices in the order the frames were sent
+     */
+    std::vector<U32> downlinkedIndices() const;
+
+    /**
+     * @brief The expected storage indices of a downlink of the SpacePosts stored at [oldestIndex, newestIndex]
+     *
+     * @return std::vector<U32> The indices, newest first
+     */
+    static std::vector<U32> indicesNewestFirst(const U32 newestIndex, const U32 oldestIndex);
+
+    /**
+     * @brief Reads the cursor of the given source from the cursor file
+     *
+     * @param source The trigger of the downlinks
+     * @param index Set to the cursor's index if it is valid
+     * @return true iff the cursor file exists and holds a valid cursor for the source
+     */
+    static bool readCursor(const DownlinkSource::T source, U32 &index);
+
+    /**
+     * @brief Writes the given bytes to the cursor file
+     */
+    static void writeCursorFile(const std::vector<U8> &content);
+
+    /**
+     * @brief Sends the DOWNLINK_LAST_MESSAGES_GDS command and checks its response
+     *
+     * @param expectedResponse The expected command response
+     */
+    void downlinkViaGds(const Fw::CmdResponse::T expectedResponse);
+
+    /**
+     * @brief Forgets all frames received so far
+     */
+    void clearFrames();
+
+    /**
+     * @brief F' generated method for connecting the Tester to the component's ports.
+     */
+    void connectPorts();
+
+    /**
+     * @brief Initialize the Transceiver component under test
+     *
+     * Restores the delta downlink cursors from the cursor file as at boot. The history only holds the events of the
+     * initialization afterwards.
+     */
+    void initComponents();
+  };
+
+} // end namespace SpacePosts
+
+#endif
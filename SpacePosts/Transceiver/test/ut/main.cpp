@@ -0,0 +1,232 @@
+#include <vector>
+
+#include "Tester.hpp"
+#include "gtest/gtest.h"
+
+#include "SpacePosts/MessageTypes/FppConstantsAc.hpp"
+#include "config/TransceiverCfg.hpp"
+
+using namespace SpacePosts;
+
+constexpr const U32 MAX_MSGBATCH_SIZE = SpacePosts::FppConstant_SpacePost_Batch_Size::SpacePost_Batch_Size;
+
+constexpr const U32 PAGE_SIZE = TRANSCEIVER_DOWNLINK_PAGE_SIZE;
+
+/*
+    UT-TRA-010
+    Test sending the frames of a paced downlink session across pacingTick calls
+*/
+
+TEST(TransceiverTest, TestPacedSessionNominalOneFramePerTick)
+{
+    Tester tester{};
+    tester.testPacedSessionSpansTicks(1);
+}
+TEST(TransceiverTest, TestPacedSessionNominalPartialLastTick)
+{
+    Tester tester{};
+    tester.testPacedSessionSpansTicks(3);
+}
+TEST(TransceiverTest, TestPacedSessionNominalSingleTick)
+{
+    Tester tester{};
+    tester.testPacedSessionSpansTicks(10);
+}
+
+/*
+    UT-TRA-020
+    Test that a downlink trigger is rejected while a paced downlink session is active
+*/
+
+TEST(TransceiverTest, TestTriggerErrorSessionActive)
+{
+    Tester tester{};
+    tester.testTriggerRejectedWhileSessionActive();
+}
+
+/*
+    UT-TRA-030
+    Test paging through the storage based on the number of SpacePosts to downlink and the number stored
+*/
+
+TEST(TransceiverTest, TestPageBoundariesNominalSingleMessage)
+{
+    Tester tester{};
+    tester.testDownlinkPageBoundaries(1, 1);
+}
+TEST(TransceiverTest, TestPageBoundariesNominalStorageEmpty)
+{
+    Tester tester{};
+    tester.testDownlinkPageBoundaries(0, PAGE_SIZE);
+}
+TEST(TransceiverTest, TestPageBoundariesNominalStorageOneShortOfPage)
+{
+    Tester tester{};
+    tester.testDownlinkPageBoundaries(PAGE_SIZE - 1, PAGE_SIZE);
+}
+TEST(TransceiverTest, TestPageBoundariesNominalExactlyOnePage)
+{
+    Tester tester{};
+    tester.testDownlinkPageBoundaries(PAGE_SIZE, PAGE_SIZE);
+}
+TEST(TransceiverTest, TestPageBoundariesNominalStorageOneBeyondPage)
+{
+    Tester tester{};
+    tester.testDownlinkPageBoundaries(PAGE_SIZE + 1, PAGE_SIZE);
+}
+TEST(TransceiverTest, TestPageBoundariesNominalCountOneBeyondPage)
+{
+    Tester tester{};
+    tester.testDownlinkPageBoundaries(PAGE_SIZE, PAGE_SIZE + 1);
+}
+TEST(TransceiverTest, TestPageBoundariesNominalTwoFullPages)
+{
+    Tester tester{};
+    tester.testDownlinkPageBoundaries(2 * PAGE_SIZE, 2 * PAGE_SIZE);
+}
+TEST(TransceiverTest, TestPageBoundariesNominalCountOneShortOfTwoPages)
+{
+    Tester tester{};
+    tester.testDownlinkPageBoundaries(2 * PAGE_SIZE + 1, 2 * PAGE_SIZE - 1);
+}
+TEST(TransceiverTest, TestPageBoundariesNominalStorageRunsOutInSecondPage)
+{
+    Tester tester{};
+    tester.testDownlinkPageBoundaries(PAGE_SIZE + PAGE_SIZE / 2, 3 * PAGE_SIZE);
+}
+
+/*
+    UT-TRA-040
+    Test which SpacePosts delta downlinks send and when they advance their cursor
+*/
+
+TEST(TransceiverTest, TestDeltaDownlinkNominalConsecutiveIndices)
+{
+    Tester tester{};
+    tester.testDeltaDownlinkSkipsNothing(0);
+}
+TEST(TransceiverTest, TestDeltaDownlinkNominalGapShorterThanDownlink)
+{
+    Tester tester{};
+    tester.testDeltaDownlinkSkipsNothing(3);
+}
+TEST(TransceiverTest, TestDeltaDownlinkNominalGapLongerThanDownlink)
+{
+    Tester tester{};
+    tester.testDeltaDownlinkSkipsNothing(100);
+}
+TEST(TransceiverTest, TestDeltaCursorNominalAdvancesWhenSessionFinishes)
+{
+    Tester tester{};
+    tester.testDeltaCursorAdvancesWhenSessionFinishes();
+}
+
+/*
+    UT-TRA-050
+    Test restoring the delta downlink cursors from a corrupt cursor file
+*/
+
+TEST(TransceiverTest, TestCursorFileErrorEmpty)
+{
+    Tester tester{};
+    tester.testCorruptCursorFile({}, CursorFileError::READ, 0);
+}
+TEST(TransceiverTest, TestCursorFileErrorTruncated)
+{
+    Tester tester{};
+    tester.testCorruptCursorFile({TRANSCEIVER_CURSOR_FILE_DELIMITER, 1, 0, 0, 0}, CursorFileError::READ, 5);
+}
+TEST(TransceiverTest, TestCursorFileErrorWrongDelimiter)
+{
+    // Valid cursors at index 2, which must not be taken over
+    Tester tester{};
+    tester.testCorruptCursorFile({0x00, 1, 0, 0, 0, 2, 1, 0, 0, 0, 2, 1, 0, 0, 0, 2}, CursorFileError::CONTENT, 0x00);
+}
+
+/*
+    UT-TRA-060
+    Test downlinking frames in pooled buffers and the fallback to Fw::ComBuffer frames if no suitable pooled buffer
+    can be allocated
+*/
+
+TEST(TransceiverTest, TestPooledBufferErrorNoBuffer)
+{
+    Tester tester{};
+    tester.testPooledBufferAllocationFails(0);
+}
+TEST(TransceiverTest, TestPooledBufferErrorBufferOneByteTooSmall)
+{
+    // A single-post frame needs one byte more than a serialized SpacePost
+    Tester tester{};
+    tester.testPooledBufferAllocationFails(SpacePost::SERIALIZED_SIZE);
+}
+
+TEST(TransceiverTest, TestPooledBufferNominalSameBytesSingle)
+{
+    Tester tester{};
+    tester.testPooledBufferFramesEqualComBufferFrames(false, false);
+}
+TEST(TransceiverTest, TestPooledBufferNominalSameBytesPacked)
+{
+    Tester tester{};
+    tester.testPooledBufferFramesEqualComBufferFrames(true, false);
+}
+TEST(TransceiverTest, TestPooledBufferNominalSameBytesSingleCompressed)
+{
+    Tester tester{};
+    tester.testPooledBufferFramesEqualComBufferFrames(false, true);
+}
+TEST(TransceiverTest, TestPooledBufferNominalSameBytesPackedCompressed)
+{
+    Tester tester{};
+    tester.testPooledBufferFramesEqualComBufferFrames(true, true);
+}
+
+/*
+    UT-TRA-070
+    Test that storing a SpacePost invalidates the frame cache, no matter which component stores it
+*/
+
+TEST(TransceiverTest, TestFrameCacheNominalInvalidatedByStoreMessage)
+{
+    Tester tester{};
+    tester.testFrameCacheInvalidatedByStore(false);
+}
+TEST(TransceiverTest, TestFrameCacheNominalInvalidatedByStoreMessages)
+{
+    Tester tester{};
+    tester.testFrameCacheInvalidatedByStore(true);
+}
+TEST(TransceiverTest, TestFrameCacheNominalInvalidatedByOtherComponent)
+{
+    Tester tester{};
+    tester.testFrameCacheInvalidatedByOtherComponent();
+}
+
+/*
+    UT-TRA-080
+    Test validating the number of SpacePosts of a STORE_MESSAGES command
+*/
+
+TEST(TransceiverTest, TestStoreMessagesNominalEmpty)
+{
+    Tester tester{};
+    tester.testStoreMessagesValidMessageCount(0);
+}
+TEST(TransceiverTest, TestStoreMessagesNominalFullBatch)
+{
+    Tester tester{};
+    tester.testStoreMessagesValidMessageCount(MAX_MSGBATCH_SIZE);
+}
+TEST(TransceiverTest, TestStoreMessagesErrorOneBeyondBatch)
+{
+    Tester tester{};
+    tester.testStoreMessagesValidMessageCount(MAX_MSGBATCH_SIZE + 1);
+}
+
+// Execute tests
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -28,13 +28,24 @@ namespace
     // Byte value that is placed + expected at the beginning of every
     // valid SpacePost file.
     // Basic sanity check against file integrity + parsing wrong files
-    MESSAGESTORAGE_MSGFILE_DELIMITER = 0xD9,
+    //
+    // Also tells the format of the file: a file starting with this value holds the SpacePost's metadata
+    // (SpacePostMetadata) between the message size and the message.
+    MESSAGESTORAGE_MSGFILE_DELIMITER = 0xDA,
+
+    // Byte value at the beginning of SpacePost files which were stored without metadata.
+    //
+    // Such files are still loaded. Their metadata is derived when loading them.
+    MESSAGESTORAGE_MSGFILE_DELIMITER_NO_METADATA = 0xD9,
 
     // The maximum number of indices of validly stored SpacePosts to keep in the lastSuccessfullyStoredIndices data
     // strucutre.
     //
     // See the documentation of MessageStorage::lastSuccessfullyStoredIndices for more information.
-    MESSAGESTORAGE_STORED_INDEX_HISTORY_SIZE = SpacePosts::FppConstant_SpacePost_Batch_Size::SpacePost_Batch_Size,
+    //
+    // Bounds how far back the loadMessageRange port can page. Must be at least
+    // SpacePosts::FppConstant_SpacePost_Batch_Size::SpacePost_Batch_Size. Costs 4 bytes of memory per index.
+    MESSAGESTORAGE_STORED_INDEX_HISTORY_SIZE = 256,
 
     // Maximum number of characters for the name of a SpacePost file (incl. the extension)
     // (in char* representation of Os::Directory::read()).
@@ -42,7 +53,29 @@ namespace
     // Count does not include a terminating null character.
     //
     // Currently: Maximum length of index (U32) as decimal string + length of extension
-    MESSAGESTORAGE_MSGFILE_NAME_MAXLENGTH = strlen("4294967295") + strlen(".spaceposts")
+    MESSAGESTORAGE_MSGFILE_NAME_MAXLENGTH = strlen("4294967295") + strlen(".spaceposts"),
+
+    // Maximum number of characters of the storage directory path (MESSAGESTORAGE_MSGFILE_DIRECTORY).
+    //
+    // Count does not include a terminating null character.
+    //
+    // Same as the size of the directory string in the STORAGE_DIRECTORY_WARNING event.
+    MESSAGESTORAGE_MSGFILE_DIRECTORY_MAXLENGTH = 128,
+
+    // Maximum number of characters of the absolute path of a SpacePost file.
+    //
+    // Defines the size of the stack buffer the component formats file paths into.
+    // Count does not include a terminating null character.
+    MESSAGESTORAGE_MSGFILE_PATH_MAXLENGTH = MESSAGESTORAGE_MSGFILE_DIRECTORY_MAXLENGTH +
+                                            MESSAGESTORAGE_MSGFILE_NAME_MAXLENGTH,
+
+    // The maximum number of SpacePosts kept by the MessageStorage instance which serves as quarantine store for the
+    // SpacePosts rejected by the Moderator.
+    //
+    // Passed to MessageStorage::configure() together with MESSAGESTORAGE_QUARANTINE_DIRECTORY. Older quarantined
+    // SpacePosts are deleted when new ones are stored. Bounds the storage space a flood of rejected SpacePosts takes.
+    // At most MESSAGESTORAGE_STORED_INDEX_HISTORY_SIZE, so that all of them can be loaded for a downlink.
+    MESSAGESTORAGE_QUARANTINE_MAX_STORED_MESSAGES = 200
   };
 
   // File extension for SpacePost files.
@@ -63,6 +96,12 @@ namespace
   //
   // TODO Change for wherever you are using the component
   static const std::string MESSAGESTORAGE_MSGFILE_DIRECTORY{"/home/spaceposts/"};
+
+  // Absolute path to the directory of the MessageStorage instance which serves as quarantine store for the
+  // SpacePosts rejected by the Moderator. Should end with a slash. Must not be MESSAGESTORAGE_MSGFILE_DIRECTORY.
+  //
+  // TODO Change for wherever you are using the component
+  static const std::string MESSAGESTORAGE_QUARANTINE_DIRECTORY{"/home/spaceposts/quarantine/"};
 }
 
 #endif /* MessageStorage_MessageStorageCfg_HPP_ */
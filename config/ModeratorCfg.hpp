@@ -0,0 +1,77 @@
+/*
+ * ModeratorCfg.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Marius Baden
+ */
+
+#ifndef Moderator_ModeratorCfg_HPP_
+#define Moderator_ModeratorCfg_HPP_
+
+// Anonymous namespace for configuration parameters
+namespace
+{
+
+  enum
+  {
+    // The number of checks after which a CompositeModerationStrategy reorders its strategies.
+    //
+    // At every reordering, the statistics the order is based on are halved. Thus, older checks have less influence
+    // on the order and the chain adapts to a change in the kind of uplinked messages. Smaller values adapt faster
+    // but base the order on fewer checks.
+    MODERATOR_COMPOSITE_REORDER_INTERVAL = 1024,
+
+    // Every how many checks a CompositeModerationStrategy measures the time each of its strategies takes.
+    //
+    // Reading the clock can take longer than a cheap strategy itself. Thus, only every n-th check is timed.
+    // 1 times every check.
+    MODERATOR_COMPOSITE_COST_SAMPLE_INTERVAL = 16,
+
+    // The number of generations of counting Bloom filters a RepetitionModerationStrategy rotates through.
+    //
+    // Each generation counts the SpacePosts of one part of the time window. When a generation is older than the
+    // window, it is cleared and counts the newest part. More generations let old SpacePosts expire more evenly but
+    // cost MODERATOR_REPETITION_FILTER_SIZE bytes each and have to be read at every check.
+    MODERATOR_REPETITION_GENERATIONS = 4,
+
+    // The number of counters of each counting Bloom filter of a RepetitionModerationStrategy.
+    //
+    // Each counter takes 1 byte. The more counters, the less likely different SpacePosts are counted as copies of
+    // each other. Must be a power of two.
+    MODERATOR_REPETITION_FILTER_SIZE = 4096,
+
+    // The number of counters a RepetitionModerationStrategy increments per SpacePost in each Bloom filter.
+    MODERATOR_REPETITION_NUM_HASHES = 4,
+
+    // The number of buckets the Moderator's uplink rate limiter divides its sliding window into.
+    //
+    // The window (UPLINK_RATE_WINDOW parameter) slides by one bucket at a time. More buckets let it slide more
+    // smoothly and cost 8 bytes each.
+    MODERATOR_RATE_LIMIT_BUCKETS = 12,
+
+    // First 4 bytes (as a U32 in the byte order of the flight computer) of a compiled blocklist file.
+    //
+    // Basic sanity check against parsing wrong files. A file compiled on a computer with the other byte order does
+    // not match either. See CompiledBlocklist.hpp for the file format.
+    MODERATOR_BLOCKLIST_FILE_MAGIC = 0x5350424C,
+
+    // Version of the compiled blocklist file format. Files of other versions are not loaded
+    MODERATOR_BLOCKLIST_FILE_VERSION = 1,
+
+    // The minimum time in milliseconds between two writes of the Moderator's telemetry and of the ActiveModerator's
+    // STRATEGY_STATS.
+    //
+    // Serializing the telemetry after every SpacePost would take longer than a cheap moderation check. The counts
+    // and histograms are written once per interval instead, at the next SpacePost after it has passed. 0 writes
+    // after every SpacePost.
+    MODERATOR_TELEMETRY_INTERVAL_MS = 1000,
+
+    // Base-2 logarithm of the upper bound in nanoseconds of the first bucket of the Moderator's latency histograms.
+    //
+    // Every further bucket doubles the bound. With the default of 8 and Moderator_LatencyBuckets = 12 (see
+    // Moderator.fpp), the buckets range from below 256 ns to 524 us and above.
+    MODERATOR_LATENCY_FIRST_BUCKET_LOG2_NS = 8,
+  };
+}
+
+#endif /* Moderator_ModeratorCfg_HPP_ */
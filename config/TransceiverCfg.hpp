@@ -8,6 +8,8 @@
 #ifndef Transceiver_TransceiverCfg_HPP_
 #define Transceiver_TransceiverCfg_HPP_
 
+#include <string>
+
 #include "SpacePosts/MessageTypes/FppConstantsAc.hpp"
 
 
@@ -17,21 +19,73 @@ namespace
 
   enum
   { 
-    // The number of SpacePosts to downlink whenever a downlink is requested via command or a downlink
-    // is triggered by the downlink schedule input port.
+    // The maximum number of SpacePosts to load from the storage at once during a downlink.
+    //
+    // The number of SpacePosts to downlink (NF-TRA-010) is the DOWNLINK_MESSAGE_COUNT parameter. Downlinks of more
+    // SpacePosts than this are loaded page by page into the same SpacePost_Batch.
+    //
+    // In [1, SpacePosts::FppConstant_SpacePost_Batch_Size::SpacePost_Batch_Size]. Smaller pages reduce the time a
+    // single load blocks the storage but need more port calls per downlink.
+    TRANSCEIVER_DOWNLINK_PAGE_SIZE = SpacePosts::FppConstant_SpacePost_Batch_Size::SpacePost_Batch_Size,
+
+    // The number of bytes of the cache of serialized downlink frames.
+    //
+    // The cache holds the frames of the last downlink in the default (non-delta) mode. As long as no SpacePost is
+    // stored, the next such downlink with the same frame format copies them instead of loading and serializing the
+    // SpacePosts again. A downlink whose frames do not fit is not cached.
+    //
+    // Enough for the frames of SpacePost_Batch_Size SpacePosts of maximum length in the one-post-per-frame mode.
+    TRANSCEIVER_FRAME_CACHE_SIZE = 8192,
+
+    // The maximum number of frames in the cache of serialized downlink frames. See TRANSCEIVER_FRAME_CACHE_SIZE
+    TRANSCEIVER_FRAME_CACHE_MAX_FRAMES = 64,
+
+    // First byte of a downlink frame which contains multiple SpacePosts (packed mode).
     //
-    // This is the configurable number of messages to downlink as required in NF-TRA-010 of the Transceiver's 
-    // software design document.
+    // A frame in the default one-post-per-frame mode is a serialized SpacePost. It always starts with the high byte
+    // of the U16 length of the message_content string, which is 0x00 because a SpacePost holds at most
+    // SpacePost_MaxTextLength (< 256) characters. Thus, any non-zero marker lets the ground distinguish frame types.
     //
-    // In [1, SpacePosts::FppConstant_SpacePost_Batch_Size::SpacePost_Batch_Size].
+    // A packed frame is laid out as:
+    //   U8 TRANSCEIVER_FRAME_MARKER_PACKED | U8 number of posts n | n x serialized SpacePost (U16 length + text)
+    TRANSCEIVER_FRAME_MARKER_PACKED = 0x50,
+
+    // Number of bytes in front of the posts in a packed frame: marker + number of posts
+    TRANSCEIVER_PACKED_FRAME_HEADER_SIZE = 2,
+
+    // First byte of a downlink frame which contains a single compressed SpacePost (compression enabled).
+    //
+    // A compressed single frame is laid out as:
+    //   U8 TRANSCEIVER_FRAME_MARKER_COMPRESSED | compressed record
+    TRANSCEIVER_FRAME_MARKER_COMPRESSED = 0x43,
+
+    // First byte of a downlink frame which contains multiple compressed SpacePosts (packed mode + compression).
     //
-    // Currently, defined via the maximum number of messages a SpacePost_Batch can hold 
-    // (= SpacePosts::FppConstant_SpacePost_Batch_Size::SpacePost_Batch_Size). Thus, it is the maximum
-    // number of messages which can be loaded at once. A number higher than this does not work without further 
-    // refactoring!
-    TRANSCEIVER_NUM_MESSAGES_TO_DOWNLINK = SpacePosts::FppConstant_SpacePost_Batch_Size::SpacePost_Batch_Size,
+    // A compressed packed frame is laid out as:
+    //   U8 TRANSCEIVER_FRAME_MARKER_PACKED_COMPRESSED | U8 number of records n | n x compressed record
+    TRANSCEIVER_FRAME_MARKER_PACKED_COMPRESSED = 0x5A,
+
+    // Number of bytes in front of the payload of a compressed record.
+    //
+    // A compressed record is laid out as:
+    //   U8 text length l | U8 payload length p | p bytes payload
+    // If p < l, the payload is the text encoded with the codebook of SpacePostCodebook.hpp. If p == l, the payload
+    // is the raw text because encoding would not have made it shorter.
+    TRANSCEIVER_COMPRESSED_RECORD_HEADER_SIZE = 2,
+
+    // Byte value that is placed + expected at the beginning of the downlink cursor file.
+    // Basic sanity check against file integrity + parsing wrong files
+    TRANSCEIVER_CURSOR_FILE_DELIMITER = 0xC7,
   };
 
+  // Absolute path of the file in which the delta downlink cursors (highest index already downlinked per trigger
+  // source) are persisted across reboots.
+  //
+  // Should not be inside the MessageStorage's storage directory.
+  //
+  // TODO Change for wherever you are using the component
+  static const std::string TRANSCEIVER_CURSOR_FILE{"/home/spaceposts-downlink.cursor"};
+
 }
 
 #endif /* MessageStorage_MessageStorageCfg_HPP_ */